@@ -7,8 +7,14 @@
 
 #include "bench/Benchmark.h"
 #include "bench/BigPath.h"
+#include "include/core/SkCPUContext.h"
+#include "include/core/SkCPURecorder.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkPathBuilder.h"
+#include "include/core/SkSurface.h"
+#include "src/core/SkRandom.h"
 #include "tools/ToolUtils.h"
 
 enum Align {
@@ -83,3 +89,56 @@ DEF_BENCH( return new BigPathBench(kRight_Align,    false); )
 DEF_BENCH( return new BigPathBench(kLeft_Align,     true); )
 DEF_BENCH( return new BigPathBench(kMiddle_Align,   true); )
 DEF_BENCH( return new BigPathBench(kRight_Align,    true); )
+
+// Fills a polygon with a very large number of edges, as found in GIS data, into a raster surface
+// whose skcpu::Context scan converts it in bands across 'threads' threads (0 is single-threaded).
+class BigPolygonBandedBench : public Benchmark {
+    SkPath                                fPath;
+    SkString                              fName;
+    int                                   fThreads;
+    std::unique_ptr<SkExecutor>           fExecutor;
+    std::unique_ptr<const skcpu::Context> fContext;
+    std::unique_ptr<skcpu::Recorder>      fRecorder;
+    sk_sp<SkSurface>                      fSurface;
+
+public:
+    explicit BigPolygonBandedBench(int threads) : fThreads(threads) {
+        fName.printf("bigpolygon_banded_%d", threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        SkPathBuilder builder(SkPathFillType::kEvenOdd);
+        builder.moveTo(512, 512);
+        for (int i = 0; i < 200000; ++i) {
+            builder.lineTo(rand.nextRangeF(0, 1024), rand.nextRangeF(0, 1024));
+        }
+        fPath = builder.detach();
+
+        skcpu::Context::Options options;
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+            options.fExecutor = fExecutor.get();
+        }
+        fContext = skcpu::Context::Make(options);
+        fRecorder = fContext->makeRecorder();
+        fSurface = fRecorder->makeBitmapSurface(SkImageInfo::MakeN32Premul(1024, 1024));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        for (int i = 0; i < loops; i++) {
+            fSurface->getCanvas()->drawPath(fPath, paint);
+        }
+    }
+};
+
+DEF_BENCH( return new BigPolygonBandedBench(0); )
+DEF_BENCH( return new BigPolygonBandedBench(4); )
+DEF_BENCH( return new BigPolygonBandedBench(8); )
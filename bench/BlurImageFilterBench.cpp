@@ -8,11 +8,16 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/core/SkTileMode.h"
 #include "include/effects/SkImageFilters.h"
+#include "src/core/SkBlurEngine.h"
 #include "src/core/SkRandom.h"
+#include "src/core/SkSpecialImage.h"
 
 #define FILTER_WIDTH_SMALL  32
 #define FILTER_HEIGHT_SMALL 32
@@ -161,3 +166,61 @@ DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, tr
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_LARGE, BLUR_SIGMA_LARGE, false, true, true);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, true, true, true);)
 DEF_BENCH(return new BlurImageFilterBench(BLUR_SIGMA_HUGE, BLUR_SIGMA_HUGE, false, true, true);)
+
+// Calls the raster blur engine directly on a large image so that the cost of splitting the passes
+// across 'threads' worker threads can be compared against the serial blur (threads == 0).
+class BlurEngineThreadedBench : public Benchmark {
+public:
+    BlurEngineThreadedBench(SkScalar sigma, SkColorType colorType, int threads)
+            : fSigma(sigma)
+            , fColorType(colorType)
+            , fThreads(threads) {
+        fName.printf("blur_engine_%s_%.2f_%d",
+                     colorType == kAlpha_8_SkColorType ? "a8" : "8888", sigma, threads);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        static constexpr int kSize = 1024;
+        SkBitmap bitmap;
+        bitmap.allocPixels(SkImageInfo::Make(kSize, kSize, fColorType, kPremul_SkAlphaType));
+        SkCanvas canvas(bitmap);
+        canvas.drawImage(make_checkerboard(kSize, kSize), 0, 0);
+        fSrc = SkSpecialImages::MakeFromRaster(SkIRect::MakeSize(bitmap.dimensions()), bitmap,
+                                               SkSurfaceProps{});
+
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+        fEngine = SkBlurEngine::MakeRasterBlurEngine(fExecutor.get());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const SkSize sigma = {fSigma, fSigma};
+        const SkBlurEngine::Algorithm* algorithm = fEngine->findAlgorithm(sigma, fColorType);
+        const SkIRect bounds = SkIRect::MakeSize(fSrc->dimensions());
+        for (int i = 0; i < loops; i++) {
+            algorithm->blur(sigma, fSrc, bounds, SkTileMode::kDecal, bounds);
+        }
+    }
+
+private:
+    SkString fName;
+    SkScalar fSigma;
+    SkColorType fColorType;
+    int fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
+    std::unique_ptr<SkBlurEngine> fEngine;
+    sk_sp<SkSpecialImage> fSrc;
+};
+
+DEF_BENCH(return new BlurEngineThreadedBench(BLUR_SIGMA_LARGE, kN32_SkColorType, 0);)
+DEF_BENCH(return new BlurEngineThreadedBench(BLUR_SIGMA_LARGE, kN32_SkColorType, 4);)
+DEF_BENCH(return new BlurEngineThreadedBench(BLUR_SIGMA_LARGE, kN32_SkColorType, 8);)
+DEF_BENCH(return new BlurEngineThreadedBench(BLUR_SIGMA_LARGE, kAlpha_8_SkColorType, 0);)
+DEF_BENCH(return new BlurEngineThreadedBench(BLUR_SIGMA_LARGE, kAlpha_8_SkColorType, 4);)
+DEF_BENCH(return new BlurEngineThreadedBench(BLUR_SIGMA_LARGE, kAlpha_8_SkColorType, 8);)
@@ -6,13 +6,19 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/codec/SkCodec.h"
+#include "include/codec/SkCodecDownscale.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/core/SkSamplingOptions.h"
 #include "modules/skottie/include/Skottie.h"
 #include "tools/DecodeUtils.h"
 #include "tools/Resources.h"
+#include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
 class DecodeBench : public Benchmark {
@@ -59,6 +65,131 @@ private:
 };
 
 
+// Decodes through SkCodec::getPixels() with Options::fExecutor set to a pool of 'threads' threads,
+// or with no executor when 'threads' is 0.
+class ExecutorDecodeBench final : public DecodeBench {
+public:
+    ExecutorDecodeBench(const char* name, const char* source, int threads)
+        : INHERITED(SkStringPrintf("%s_threads_%d", name, threads).c_str(), source)
+        , fThreads(threads)
+    {}
+
+    void onDelayedSetup() override {
+        INHERITED::onDelayedSetup();
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkCodec::Options options;
+        options.fExecutor = fExecutor.get();
+        while (loops-- > 0) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+            SkBitmap bm;
+            bm.allocPixels(codec->getInfo());
+            SkAssertResult(codec->getPixels(bm.pixmap(), &options) == SkCodec::kSuccess);
+        }
+    }
+
+private:
+    const int                   fThreads;
+    std::unique_ptr<SkExecutor> fExecutor;
+
+    using INHERITED = DecodeBench;
+};
+
+// Decodes through SkCodec::getPixels() with Options::fUseDecoderThreads set to 'useThreads'.
+class DecoderThreadsDecodeBench final : public DecodeBench {
+public:
+    DecoderThreadsDecodeBench(const char* name, const char* source, bool useThreads)
+        : INHERITED(SkStringPrintf("%s_decoder_threads_%d", name, useThreads).c_str(), source)
+        , fUseThreads(useThreads)
+    {}
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkCodec::Options options;
+        options.fUseDecoderThreads = fUseThreads;
+        while (loops-- > 0) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+            SkBitmap bm;
+            bm.allocPixels(codec->getInfo());
+            SkAssertResult(codec->getPixels(bm.pixmap(), &options) == SkCodec::kSuccess);
+        }
+    }
+
+private:
+    const bool fUseThreads;
+
+    using INHERITED = DecodeBench;
+};
+
+// Decodes a 16-bit per component image through SkCodec::getPixels() to 'colorType'. 8888
+// destinations with no color transform take the narrowing swizzle, while F16 destinations are
+// converted by skcms.
+class HighBitDepthDecodeBench final : public DecodeBench {
+public:
+    HighBitDepthDecodeBench(const char* name, const char* source, SkColorType colorType)
+        : INHERITED(SkStringPrintf("%s_%s", name, ToolUtils::colortype_name(colorType)).c_str(),
+                    source)
+        , fColorType(colorType)
+    {}
+
+    void onDraw(int loops, SkCanvas*) override {
+        while (loops-- > 0) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+            const SkImageInfo info = codec->getInfo().makeColorType(fColorType);
+            SkBitmap bm;
+            bm.allocPixels(info);
+            SkAssertResult(codec->getPixels(bm.pixmap()) == SkCodec::kSuccess);
+        }
+    }
+
+private:
+    const SkColorType fColorType;
+
+    using INHERITED = DecodeBench;
+};
+
+// Makes a 'size' x 'size' thumbnail. With 'streamed' it uses SkCodecs::DecodeAndDownscale(),
+// otherwise it decodes at the nearest native scale and then calls SkPixmap::scalePixels().
+class ThumbnailDecodeBench final : public DecodeBench {
+public:
+    ThumbnailDecodeBench(const char* name, const char* source, int size, bool streamed)
+        : INHERITED(SkStringPrintf("thumbnail_%s_%d_%s", name, size,
+                                   streamed ? "streamed" : "scalePixels").c_str(),
+                    source)
+        , fSize(size)
+        , fStreamed(streamed)
+    {}
+
+    void onDraw(int loops, SkCanvas*) override {
+        const SkImageInfo dstInfo = SkImageInfo::MakeN32Premul(fSize, fSize);
+        SkBitmap dst;
+        dst.allocPixels(dstInfo);
+        while (loops-- > 0) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(fData);
+            if (fStreamed) {
+                SkAssertResult(SkCodecs::DecodeAndDownscale(codec.get(), dst.pixmap()) ==
+                               SkCodec::kSuccess);
+                continue;
+            }
+            const float scale = (float)fSize / codec->dimensions().width();
+            SkBitmap decoded;
+            decoded.allocPixels(dstInfo.makeDimensions(codec->getScaledDimensions(scale)));
+            SkAssertResult(codec->getPixels(decoded.pixmap()) == SkCodec::kSuccess);
+            SkAssertResult(decoded.pixmap().scalePixels(
+                    dst.pixmap(), SkSamplingOptions(SkFilterMode::kLinear, SkMipmapMode::kLinear)));
+        }
+    }
+
+private:
+    const int  fSize;
+    const bool fStreamed;
+
+    using INHERITED = DecodeBench;
+};
+
 class SkottieDecodeBench final : public DecodeBench {
 public:
     SkottieDecodeBench(const char* name, const char* source)
@@ -241,3 +372,27 @@ DEF_BENCH(return new BitmapDecodeBench("png_small"    /*  32x  32*/, "images/man
 DEF_BENCH(return new BitmapDecodeBench("png_phonehub_connecting"   , "images/Connecting.png"))
 DEF_BENCH(return new BitmapDecodeBench("png_phonehub_generic_error", "images/Generic_Error.png"))
 DEF_BENCH(return new BitmapDecodeBench("png_phonehub_onboard"      , "images/Onboard.png"))
+
+// 4032x3024 with a restart marker after every MCU row.
+DEF_BENCH(return new ExecutorDecodeBench("jpeg_restart_intervals", "images/iphone_15.jpeg", 0))
+DEF_BENCH(return new ExecutorDecodeBench("jpeg_restart_intervals", "images/iphone_15.jpeg", 4))
+DEF_BENCH(return new ExecutorDecodeBench("jpeg_restart_intervals", "images/iphone_15.jpeg", 8))
+
+// 800x800 lossy, and 400x301 lossy with alpha.
+DEF_BENCH(return new DecoderThreadsDecodeBench("webp", "images/webp-color-profile-lossy.webp",
+                                               false))
+DEF_BENCH(return new DecoderThreadsDecodeBench("webp", "images/webp-color-profile-lossy.webp",
+                                               true))
+DEF_BENCH(return new DecoderThreadsDecodeBench("webp_alpha", "images/yellow_rose.webp", false))
+DEF_BENCH(return new DecoderThreadsDecodeBench("webp_alpha", "images/yellow_rose.webp", true))
+
+// 474x572, 16 bits per component RGBA.
+DEF_BENCH(return new HighBitDepthDecodeBench("png16", "images/f16-trc-tables.png",
+                                             kN32_SkColorType))
+DEF_BENCH(return new HighBitDepthDecodeBench("png16", "images/f16-trc-tables.png",
+                                             kRGBA_F16_SkColorType))
+
+DEF_BENCH(return new ThumbnailDecodeBench("jpeg", "images/mandrill_512_q075.jpg", 96, false))
+DEF_BENCH(return new ThumbnailDecodeBench("jpeg", "images/mandrill_512_q075.jpg", 96, true))
+DEF_BENCH(return new ThumbnailDecodeBench("png", "images/mandrill_512.png", 96, false))
+DEF_BENCH(return new ThumbnailDecodeBench("png", "images/mandrill_512.png", 96, true))
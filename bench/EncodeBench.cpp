@@ -63,18 +63,31 @@ static bool encode_jpeg(SkWStream* dst, const SkPixmap& src) {
     return SkJpegEncoder::Encode(dst, src, opts);
 }
 
-static bool encode_webp_lossy(SkWStream* dst, const SkPixmap& src) {
+static bool encode_webp(SkWStream* dst,
+                        const SkPixmap& src,
+                        SkWebpEncoder::Compression compression,
+                        bool useThreads) {
     SkWebpEncoder::Options opts;
-    opts.fCompression = SkWebpEncoder::Compression::kLossy;
+    opts.fCompression = compression;
     opts.fQuality = 90;
+    opts.fUseThreads = useThreads;
     return SkWebpEncoder::Encode(dst, src, opts);
 }
 
+static bool encode_webp_lossy(SkWStream* dst, const SkPixmap& src) {
+    return encode_webp(dst, src, SkWebpEncoder::Compression::kLossy, false);
+}
+
 static bool encode_webp_lossless(SkWStream* dst, const SkPixmap& src) {
-    SkWebpEncoder::Options opts;
-    opts.fCompression = SkWebpEncoder::Compression::kLossless;
-    opts.fQuality = 90;
-    return SkWebpEncoder::Encode(dst, src, opts);
+    return encode_webp(dst, src, SkWebpEncoder::Compression::kLossless, false);
+}
+
+static bool encode_webp_lossy_threaded(SkWStream* dst, const SkPixmap& src) {
+    return encode_webp(dst, src, SkWebpEncoder::Compression::kLossy, true);
+}
+
+static bool encode_webp_lossless_threaded(SkWStream* dst, const SkPixmap& src) {
+    return encode_webp(dst, src, SkWebpEncoder::Compression::kLossless, true);
 }
 
 static bool encode_png(SkWStream* dst,
@@ -103,6 +116,12 @@ DEF_BENCH(return new EncodeBench(srcs[1], encode_webp_lossy, "WEBP", kRGBA_8888_
 DEF_BENCH(return new EncodeBench(srcs[0], encode_webp_lossless, "WEBP_LL", kRGBA_8888_SkColorType))
 DEF_BENCH(return new EncodeBench(srcs[1], encode_webp_lossless, "WEBP_LL", kRGBA_8888_SkColorType))
 
+// The same encodes, with libwebp allowed to use a worker thread.
+DEF_BENCH(return new EncodeBench(srcs[0], encode_webp_lossy_threaded, "WEBP_threads",
+                                 kRGBA_8888_SkColorType))
+DEF_BENCH(return new EncodeBench(srcs[0], encode_webp_lossless_threaded, "WEBP_LL_threads",
+                                 kRGBA_8888_SkColorType))
+
 DEF_BENCH(return new EncodeBench(srcs[0], PNG(kAll, 6), "PNG", kRGBA_8888_SkColorType))
 DEF_BENCH(return new EncodeBench(srcs[0], PNG(kAll, 3), "PNG_3", kRGBA_8888_SkColorType))
 DEF_BENCH(return new EncodeBench(srcs[0], PNG(kAll, 1), "PNG_1", kRGBA_8888_SkColorType))
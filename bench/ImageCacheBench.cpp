@@ -6,7 +6,12 @@
  */
 
 #include "bench/Benchmark.h"
+#include "include/core/SkExecutor.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkSynchronizedResourceCache.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <memory>
 
 namespace {
 static void* gGlobalAddress;
@@ -72,6 +77,58 @@ private:
     using INHERITED = Benchmark;
 };
 
+// Many threads finding (and sometimes adding) records in one shared cache, as raster workers do
+// when drawing images.
+class ImageCacheThreadedBench : public Benchmark {
+    enum {
+        CACHE_COUNT = 500,
+        LOOKUPS_PER_THREAD = 1000,
+    };
+
+    const int fThreadCount;
+    SkSynchronizedResourceCache fCache;
+    std::unique_ptr<SkExecutor> fExecutor;
+    SkString fName;
+
+public:
+    explicit ImageCacheThreadedBench(int threadCount)
+        : fThreadCount(threadCount)
+        , fCache(CACHE_COUNT * 100) {
+        fName.printf("imagecache_threaded_%d", fThreadCount);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreadCount);
+        for (int i = 0; i < CACHE_COUNT; ++i) {
+            fCache.add(new TestRec(TestKey(i), i));
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTaskGroup tg(*fExecutor);
+        for (int i = 0; i < loops; ++i) {
+            tg.batch(fThreadCount, [&](int thread) {
+                for (int j = 0; j < LOOKUPS_PER_THREAD; ++j) {
+                    // Keys past CACHE_COUNT miss on the first pass and are added.
+                    intptr_t value = (thread * LOOKUPS_PER_THREAD + j) % (CACHE_COUNT + 32);
+                    TestKey key(value);
+                    if (!fCache.find(key, TestRec::Visitor, nullptr)) {
+                        fCache.add(new TestRec(key, value));
+                    }
+                }
+            });
+            tg.wait();
+        }
+    }
+};
+
 ///////////////////////////////////////////////////////////////////////////////
 
 DEF_BENCH( return new ImageCacheBench(); )
+DEF_BENCH( return new ImageCacheThreadedBench(8); )
+DEF_BENCH( return new ImageCacheThreadedBench(64); )
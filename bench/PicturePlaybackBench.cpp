@@ -29,7 +29,8 @@ enum BBH  { kNone, kRTree };
 enum Mode { kTiled, kRandom };
 class TiledPlaybackBench : public Benchmark {
 public:
-    TiledPlaybackBench(BBH bbh, Mode mode) : fBBH(bbh), fMode(mode), fName("tiled_playback") {
+    TiledPlaybackBench(BBH bbh, Mode mode, bool optimize = false)
+            : fBBH(bbh), fMode(mode), fOptimize(optimize), fName("tiled_playback") {
         switch (fBBH) {
             case kNone:     fName.append("_none"    ); break;
             case kRTree:    fName.append("_rtree"   ); break;
@@ -38,6 +39,9 @@ public:
             case kTiled:  fName.append("_tiled" ); break;
             case kRandom: fName.append("_random"); break;
         }
+        if (fOptimize) {
+            fName.append("_optimized");
+        }
     }
 
     const char* onGetName() override { return fName.c_str(); }
@@ -51,6 +55,7 @@ public:
         }
 
         SkPictureRecorder recorder;
+        recorder.setOptimizeForPlayback(fOptimize);
         SkCanvas* canvas = recorder.beginRecording(1024, 1024, factory.get());
             SkRandom rand;
             for (int i = 0; i < 10000; i++) {
@@ -90,6 +95,7 @@ public:
 private:
     BBH                 fBBH;
     Mode                fMode;
+    bool                fOptimize;
     SkString            fName;
     sk_sp<SkPicture>    fPic;
 };
@@ -98,3 +104,5 @@ DEF_BENCH( return new TiledPlaybackBench(kNone,     kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kNone,     kTiled ); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kRandom); )
 DEF_BENCH( return new TiledPlaybackBench(kRTree,    kTiled ); )
+DEF_BENCH( return new TiledPlaybackBench(kNone,     kRandom, true); )
+DEF_BENCH( return new TiledPlaybackBench(kRTree,    kRandom, true); )
@@ -9,9 +9,12 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkString.h"
 #include "include/private/SkTemplates.h"
+#include "src/core/SkPackedRTree.h"
 #include "src/core/SkRTree.h"
 #include "src/core/SkRandom.h"
 
+#include <vector>
+
 using namespace skia_private;
 
 // confine rectangles to a smallish area, so queries generally hit something, and overlap occurs:
@@ -23,10 +26,11 @@ static const int GRID_WIDTH = 100;
 typedef SkRect (*MakeRectProc)(SkRandom&, int, int);
 
 // Time how long it takes to build an R-Tree.
+template <typename Tree>
 class RTreeBuildBench : public Benchmark {
 public:
-    RTreeBuildBench(const char* name, MakeRectProc proc) : fProc(proc) {
-        fName.printf("rtree_%s_build", name);
+    RTreeBuildBench(const char* prefix, const char* name, MakeRectProc proc) : fProc(proc) {
+        fName.printf("%s_%s_build", prefix, name);
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -45,7 +49,7 @@ protected:
         }
 
         for (int i = 0; i < loops; ++i) {
-            SkRTree tree;
+            Tree tree;
             tree.insert(rects.data(), NUM_BUILD_RECTS);
         }
     }
@@ -55,11 +59,21 @@ private:
     using INHERITED = Benchmark;
 };
 
+static SkRect make_query(SkRandom& rand) {
+    SkRect query;
+    query.fLeft   = rand.nextRangeF(0, GENERATE_EXTENTS);
+    query.fTop    = rand.nextRangeF(0, GENERATE_EXTENTS);
+    query.fRight  = query.fLeft + 1 + rand.nextRangeF(0, GENERATE_EXTENTS/2);
+    query.fBottom = query.fTop  + 1 + rand.nextRangeF(0, GENERATE_EXTENTS/2);
+    return query;
+}
+
 // Time how long it takes to perform queries on an R-Tree.
+template <typename Tree>
 class RTreeQueryBench : public Benchmark {
 public:
-    RTreeQueryBench(const char* name, MakeRectProc proc) : fProc(proc) {
-        fName.printf("rtree_%s_query", name);
+    RTreeQueryBench(const char* prefix, const char* name, MakeRectProc proc) : fProc(proc) {
+        fName.printf("%s_%s_query", prefix, name);
     }
 
     bool isSuitableFor(Backend backend) override {
@@ -82,16 +96,58 @@ protected:
         SkRandom rand;
         for (int i = 0; i < loops; ++i) {
             std::vector<int> hits;
-            SkRect query;
-            query.fLeft   = rand.nextRangeF(0, GENERATE_EXTENTS);
-            query.fTop    = rand.nextRangeF(0, GENERATE_EXTENTS);
-            query.fRight  = query.fLeft + 1 + rand.nextRangeF(0, GENERATE_EXTENTS/2);
-            query.fBottom = query.fTop  + 1 + rand.nextRangeF(0, GENERATE_EXTENTS/2);
-            fTree.search(query, &hits);
+            fTree.search(make_query(rand), &hits);
+        }
+    }
+private:
+    Tree fTree;
+    MakeRectProc fProc;
+    SkString fName;
+    using INHERITED = Benchmark;
+};
+
+// Time how long it takes to search for a grid of tiles at once, as tiled playback does.
+template <typename Tree>
+class RTreeBatchQueryBench : public Benchmark {
+public:
+    RTreeBatchQueryBench(const char* prefix, const char* name, MakeRectProc proc) : fProc(proc) {
+        fName.printf("%s_%s_query_batch", prefix, name);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+    void onDelayedSetup() override {
+        SkRandom rand;
+        AutoTArray<SkRect> rects(NUM_QUERY_RECTS);
+        for (int i = 0; i < NUM_QUERY_RECTS; ++i) {
+            rects[i] = fProc(rand, i, NUM_QUERY_RECTS);
+        }
+        fTree.insert(rects.data(), NUM_QUERY_RECTS);
+
+        const SkScalar tileSize = GENERATE_EXTENTS / TILES_PER_SIDE;
+        for (int y = 0; y < TILES_PER_SIDE; ++y) {
+            for (int x = 0; x < TILES_PER_SIDE; ++x) {
+                fTiles.push_back(SkRect::MakeXYWH(x * tileSize, y * tileSize, tileSize, tileSize));
+            }
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; ++i) {
+            std::vector<std::vector<int>> hits(fTiles.size());
+            fTree.searchBatch(fTiles, hits.data());
         }
     }
 private:
-    SkRTree fTree;
+    static constexpr int TILES_PER_SIDE = 8;
+
+    Tree fTree;
+    std::vector<SkRect> fTiles;
     MakeRectProc fProc;
     SkString fName;
     using INHERITED = Benchmark;
@@ -129,12 +185,32 @@ static inline SkRect make_concentric_rects(SkRandom&, int index, int numRects) {
 
 ///////////////////////////////////////////////////////////////////////////////
 
-DEF_BENCH(return new RTreeBuildBench("XY", &make_XYordered_rects))
-DEF_BENCH(return new RTreeBuildBench("YX", &make_YXordered_rects))
-DEF_BENCH(return new RTreeBuildBench("random", &make_random_rects))
-DEF_BENCH(return new RTreeBuildBench("concentric", &make_concentric_rects))
-
-DEF_BENCH(return new RTreeQueryBench("XY", &make_XYordered_rects))
-DEF_BENCH(return new RTreeQueryBench("YX", &make_YXordered_rects))
-DEF_BENCH(return new RTreeQueryBench("random", &make_random_rects))
-DEF_BENCH(return new RTreeQueryBench("concentric", &make_concentric_rects))
+DEF_BENCH(return new RTreeBuildBench<SkRTree>("rtree", "XY", &make_XYordered_rects))
+DEF_BENCH(return new RTreeBuildBench<SkRTree>("rtree", "YX", &make_YXordered_rects))
+DEF_BENCH(return new RTreeBuildBench<SkRTree>("rtree", "random", &make_random_rects))
+DEF_BENCH(return new RTreeBuildBench<SkRTree>("rtree", "concentric", &make_concentric_rects))
+
+DEF_BENCH(return new RTreeQueryBench<SkRTree>("rtree", "XY", &make_XYordered_rects))
+DEF_BENCH(return new RTreeQueryBench<SkRTree>("rtree", "YX", &make_YXordered_rects))
+DEF_BENCH(return new RTreeQueryBench<SkRTree>("rtree", "random", &make_random_rects))
+DEF_BENCH(return new RTreeQueryBench<SkRTree>("rtree", "concentric", &make_concentric_rects))
+
+DEF_BENCH(return new RTreeBatchQueryBench<SkRTree>("rtree", "XY", &make_XYordered_rects))
+DEF_BENCH(return new RTreeBatchQueryBench<SkRTree>("rtree", "random", &make_random_rects))
+
+DEF_BENCH(return new RTreeBuildBench<SkPackedRTree>("packed_rtree", "XY", &make_XYordered_rects))
+DEF_BENCH(return new RTreeBuildBench<SkPackedRTree>("packed_rtree", "YX", &make_YXordered_rects))
+DEF_BENCH(return new RTreeBuildBench<SkPackedRTree>("packed_rtree", "random", &make_random_rects))
+DEF_BENCH(return new RTreeBuildBench<SkPackedRTree>("packed_rtree", "concentric",
+                                                    &make_concentric_rects))
+
+DEF_BENCH(return new RTreeQueryBench<SkPackedRTree>("packed_rtree", "XY", &make_XYordered_rects))
+DEF_BENCH(return new RTreeQueryBench<SkPackedRTree>("packed_rtree", "YX", &make_YXordered_rects))
+DEF_BENCH(return new RTreeQueryBench<SkPackedRTree>("packed_rtree", "random", &make_random_rects))
+DEF_BENCH(return new RTreeQueryBench<SkPackedRTree>("packed_rtree", "concentric",
+                                                    &make_concentric_rects))
+
+DEF_BENCH(return new RTreeBatchQueryBench<SkPackedRTree>("packed_rtree", "XY",
+                                                         &make_XYordered_rects))
+DEF_BENCH(return new RTreeBatchQueryBench<SkPackedRTree>("packed_rtree", "random",
+                                                         &make_random_rects))
@@ -8,8 +8,12 @@
 #include "bench/RecordingBench.h"
 
 #include "include/core/SkBBHFactory.h"
+#include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
 #include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRect.h"
 
 PictureCentricBench::PictureCentricBench(const char* name, const SkPicture* pic) : fName(name) {
     // Flatten the source picture in case it's trivially nested (useless for timing).
@@ -34,20 +38,58 @@ SkISize PictureCentricBench::onGetSize() {
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
-RecordingBench::RecordingBench(const char* name, const SkPicture* pic, bool useBBH)
+RecordingBench::RecordingBench(const char* name, const SkPicture* pic, bool useBBH,
+                               bool optimizeForPlayback)
     : INHERITED(name, pic)
     , fUseBBH(useBBH)
-{}
+    , fOptimizeForPlayback(optimizeForPlayback)
+{
+    if (fOptimizeForPlayback) {
+        fName.append("_optimized");
+    }
+}
 
 void RecordingBench::onDraw(int loops, SkCanvas*) {
     SkRTreeFactory factory;
     SkPictureRecorder recorder;
+    recorder.setOptimizeForPlayback(fOptimizeForPlayback);
     while (loops --> 0) {
         fSrc->playback(recorder.beginRecording(fSrc->cullRect(), fUseBBH ? &factory : nullptr));
         (void)recorder.finishRecordingAsPicture();
     }
 }
 
+// A table-like picture: a few paints and one marker path, each recorded thousands of times.
+// SkRecord interns identical paints and paths, so this records into far less memory than one
+// copy of each per op.
+static sk_sp<SkPicture> make_repetitive_picture() {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeWH(1000, 4000));
+    SkPaint fills[2], border, marker;
+    fills[0].setColor(0xFFF0F0F0);
+    fills[1].setColor(0xFFFFFFFF);
+    border.setStyle(SkPaint::kStroke_Style);
+    border.setColor(0xFFC0C0C0);
+    marker.setAntiAlias(true);
+    marker.setColor(0xFF2060C0);
+    for (int row = 0; row < 200; row++) {
+        for (int col = 0; col < 10; col++) {
+            const SkRect cell = SkRect::MakeXYWH(col * 100.0f, row * 20.0f, 100, 20);
+            canvas->drawRect(cell, fills[row & 1]);
+            canvas->drawRect(cell, border);
+            canvas->save();
+            canvas->translate(cell.fLeft + 10, cell.fTop + 10);
+            // A new path each time, as a chart or table would build it.
+            canvas->drawPath(SkPath::Circle(0, 0, 4), marker);
+            canvas->restore();
+        }
+    }
+    return recorder.finishRecordingAsPicture();
+}
+
+DEF_BENCH( return new RecordingBench("recording_repetitive",
+                                     make_repetitive_picture().get(), false); )
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 #include "include/core/SkSerialProcs.h"
 
@@ -29,13 +29,15 @@ protected:
 
 class RecordingBench : public PictureCentricBench {
 public:
-    RecordingBench(const char* name, const SkPicture*, bool useBBH);
+    RecordingBench(const char* name, const SkPicture*, bool useBBH,
+                   bool optimizeForPlayback = false);
 
 protected:
     void onDraw(int loops, SkCanvas*) override;
 
 private:
     bool fUseBBH;
+    bool fOptimizeForPlayback;
 
     using INHERITED = PictureCentricBench;
 };
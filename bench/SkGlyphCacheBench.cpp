@@ -10,6 +10,7 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkGraphics.h"
 #include "include/core/SkTypeface.h"
@@ -118,10 +119,65 @@ private:
     SkString fName;
 };
 
+// Many threads drawing the same text with a warm cache. Every lookup hits, so this measures
+// contention on the strike cache and strike locks rather than glyph generation.
+class SkGlyphCacheContention : public Benchmark {
+public:
+    explicit SkGlyphCacheContention(int threadCount) : fThreadCount(threadCount) { }
+
+protected:
+    const char* onGetName() override {
+        fName.printf("SkGlyphCacheContention%d", fThreadCount);
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == Backend::kNonRendering;
+    }
+
+    void onDelayedSetup() override {
+        fExecutor = SkExecutor::MakeFIFOThreadPool(fThreadCount);
+        fTypefaces[0] = ToolUtils::CreatePortableTypeface("serif", SkFontStyle::Italic());
+        fTypefaces[1] = ToolUtils::CreatePortableTypeface("sans-serif", SkFontStyle::Italic());
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        size_t oldCacheLimitSize = SkGraphics::GetFontCacheLimit();
+        SkGraphics::SetFontCacheLimit(32 * 1024 * 1024);
+
+        auto drawText = [&](int threadIndex) {
+            SkFont font = ToolUtils::DefaultFont();
+            font.setEdging(SkFont::Edging::kAntiAlias);
+            font.setSubpixel(true);
+            font.setTypeface(fTypefaces[threadIndex % 2]);
+            do_font_stuff(&font);
+        };
+
+        // Warm the cache so that the timed work only finds existing strikes and glyphs.
+        drawText(0);
+        drawText(1);
+
+        SkTaskGroup tg(*fExecutor);
+        for (int work = 0; work < loops; work++) {
+            tg.batch(fThreadCount, drawText);
+            tg.wait();
+        }
+        SkGraphics::SetFontCacheLimit(oldCacheLimitSize);
+    }
+
+private:
+    const int fThreadCount;
+    std::unique_ptr<SkExecutor> fExecutor;
+    sk_sp<SkTypeface> fTypefaces[2];
+    SkString fName;
+};
+
 DEF_BENCH( return new SkGlyphCacheBasic(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheBasic(32 * 1024 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(256 * 1024); )
 DEF_BENCH( return new SkGlyphCacheStressTest(32 * 1024 * 1024); )
+DEF_BENCH( return new SkGlyphCacheContention(8); )
+DEF_BENCH( return new SkGlyphCacheContention(64); )
 
 namespace {
 class DiscardableManager : public SkStrikeServer::DiscardableHandleManager,
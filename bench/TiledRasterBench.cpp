@@ -0,0 +1,168 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkRRect.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkString.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkTiledRaster.h"
+#include "src/core/SkRandom.h"
+
+#include <memory>
+#include <vector>
+
+static constexpr int kSize = 4096;
+
+// Records many antialiased shapes scattered over a kSize x kSize area.
+static sk_sp<SkPicture> make_shapes_picture(SkBBHFactory* bbhFactory) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeIWH(kSize, kSize), bbhFactory);
+    SkRandom rand;
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 20000; i++) {
+        SkRect r = SkRect::MakeXYWH(rand.nextRangeScalar(0, kSize),
+                                    rand.nextRangeScalar(0, kSize),
+                                    rand.nextRangeScalar(4, 256),
+                                    rand.nextRangeScalar(4, 256));
+        paint.setColor(rand.nextU());
+        if (i & 1) {
+            canvas->drawOval(r, paint);
+        } else {
+            canvas->drawRRect(SkRRect::MakeRectXY(r, 8, 8), paint);
+        }
+    }
+    return recorder.finishRecordingAsPicture();
+}
+
+// Draws a picture of many antialiased shapes into a large raster surface, either through the
+// surface's canvas (threads == 0) or with SkTiledRaster on a pool of the given size.
+class TiledRasterBench : public Benchmark {
+public:
+    TiledRasterBench(int threads, int tileSize) : fThreads(threads), fTileSize(tileSize) {
+        if (fThreads == 0) {
+            fName.printf("tiled_raster_serial");
+        } else {
+            fName.printf("tiled_raster_%dthreads_%dtile", fThreads, fTileSize);
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        fSurface = SkSurfaces::Raster(SkImageInfo::MakeN32Premul(kSize, kSize));
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+        fPicture = make_shapes_picture(nullptr);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkTiledRaster::Options options;
+        options.fTileSize = {fTileSize, fTileSize};
+        options.fExecutor = fExecutor.get();
+        for (int i = 0; i < loops; i++) {
+            if (fThreads == 0) {
+                fSurface->getCanvas()->drawPicture(fPicture);
+            } else {
+                SkTiledRaster::DrawPicture(fSurface.get(), fPicture.get(), options);
+            }
+        }
+    }
+
+private:
+    const int                   fThreads;
+    const int                   fTileSize;
+    SkString                    fName;
+    sk_sp<SkSurface>            fSurface;
+    sk_sp<SkPicture>            fPicture;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH( return new TiledRasterBench(0,  256); )
+DEF_BENCH( return new TiledRasterBench(1,  256); )
+DEF_BENCH( return new TiledRasterBench(4,  256); )
+DEF_BENCH( return new TiledRasterBench(8,  256); )
+DEF_BENCH( return new TiledRasterBench(16, 256); )
+DEF_BENCH( return new TiledRasterBench(8,  128); )
+DEF_BENCH( return new TiledRasterBench(8,  512); )
+
+// Draws an R-Tree backed picture into a grid of separate tile images, the map tile workload.
+// With threads == 0 each tile gets its own surface and canvas->drawPicture(), one after another;
+// otherwise SkTiledRaster::DrawPictureTiles() draws them on a pool of the given size.
+class PictureTilesBench : public Benchmark {
+public:
+    PictureTilesBench(int threads, int tileSize) : fThreads(threads), fTileSize(tileSize) {
+        if (fThreads == 0) {
+            fName.printf("picture_tiles_serial_%dtile", fTileSize);
+        } else {
+            fName.printf("picture_tiles_%dthreads_%dtile", fThreads, fTileSize);
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override { return backend == Backend::kNonRendering; }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        if (fThreads > 0) {
+            fExecutor = SkExecutor::MakeFIFOThreadPool(fThreads);
+        }
+        SkRTreeFactory factory;
+        fPicture = make_shapes_picture(&factory);
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const SkImageInfo info = SkImageInfo::MakeN32Premul(kSize, kSize);
+        SkTiledRaster::Options options;
+        options.fTileSize = {fTileSize, fTileSize};
+        options.fExecutor = fExecutor.get();
+        for (int i = 0; i < loops; i++) {
+            std::vector<sk_sp<SkImage>> tiles;
+            if (fThreads == 0) {
+                for (int y = 0; y < kSize; y += fTileSize) {
+                    for (int x = 0; x < kSize; x += fTileSize) {
+                        sk_sp<SkSurface> tile = SkSurfaces::Raster(
+                                info.makeWH(fTileSize, fTileSize));
+                        tile->getCanvas()->translate(-x, -y);
+                        tile->getCanvas()->drawPicture(fPicture);
+                        tiles.push_back(tile->makeImageSnapshot());
+                    }
+                }
+            } else {
+                tiles = SkTiledRaster::DrawPictureTiles(fPicture.get(), info, options);
+            }
+        }
+    }
+
+private:
+    const int                   fThreads;
+    const int                   fTileSize;
+    SkString                    fName;
+    sk_sp<SkPicture>            fPicture;
+    std::unique_ptr<SkExecutor> fExecutor;
+};
+
+DEF_BENCH( return new PictureTilesBench(0,  256); )
+DEF_BENCH( return new PictureTilesBench(1,  256); )
+DEF_BENCH( return new PictureTilesBench(4,  256); )
+DEF_BENCH( return new PictureTilesBench(8,  256); )
+DEF_BENCH( return new PictureTilesBench(0,  512); )
+DEF_BENCH( return new PictureTilesBench(8,  512); )
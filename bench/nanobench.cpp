@@ -167,6 +167,8 @@ static DEFINE_string(zoom, "1.0,0",
                      "Comma-separated zoomMax,zoomPeriodMs factors for a periodic SKP zoom "
                      "function that ping-pongs between 1.0 and zoomMax.");
 static DEFINE_bool(bbh, true, "Build a BBH for SKPs?");
+static DEFINE_bool(optimizeSKPs, false,
+                   "Run the playback optimizations when recording SKPs, and report their op counts?");
 static DEFINE_bool(loopSKP, true, "Loop SKPs like we do for micro benches?");
 static DEFINE_int(flushEvery, 10, "Flush --outResultsFile every Nth run.");
 static DEFINE_bool(gpuStats, false, "Print GPU stats after each gpu benchmark?");
@@ -986,9 +988,15 @@ public:
             SkString name = SkOSPath::Basename(path.c_str());
             fSourceType = "skp";
             fBenchType  = "recording";
+            if (FLAGS_optimizeSKPs) {
+                SkPictureRecorder recorder;
+                recorder.setOptimizeForPlayback(true);
+                pic->playback(recorder.beginRecording(pic->cullRect()));
+                pic = recorder.finishRecordingAsPicture();
+            }
             fSKPBytes = static_cast<double>(pic->approximateBytesUsed());
             fSKPOps   = pic->approximateOpCount();
-            return new RecordingBench(name.c_str(), pic.get(), FLAGS_bbh);
+            return new RecordingBench(name.c_str(), pic.get(), FLAGS_bbh, FLAGS_optimizeSKPs);
         }
 
         // Add all .skps as DeserializePictureBenchs.
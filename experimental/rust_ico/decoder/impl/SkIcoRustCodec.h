@@ -76,7 +76,7 @@ private:
     // Without this override the base class defaults to `false` and
     // `SkCodec::startIncrementalDecode` returns `kUnimplemented`, which breaks
     // clients such as Blink's `SkiaImageDecoderBase`.
-    bool onSupportsIncrementalDecode(const SkImageInfo&) override { return true; }
+    bool onSupportsIncrementalDecode(const SkImageInfo&, const Options&) override { return true; }
 
     Result onStartIncrementalDecode(const SkImageInfo& dstInfo, void* pixels, size_t rowBytes,
             const SkCodec::Options&) override;
@@ -44,7 +44,7 @@ protected:
 
     bool onRewind() override;
 
-    bool onSupportsIncrementalDecode(const SkImageInfo&) override { return true; }
+    bool onSupportsIncrementalDecode(const SkImageInfo&, const Options&) override { return true; }
 
     bool onGetFrameInfo(int, FrameInfo*) const override;
 
@@ -31,6 +31,7 @@
 #include <vector>
 
 class SkData;
+class SkExecutor;
 class SkFrameHolder;
 class SkImage;
 class SkPngChunkReader;
@@ -339,7 +340,10 @@ public:
                 , fSubset(nullptr)
                 , fFrameIndex(0)
                 , fPriorFrame(kNoFrame)
-                , fMaxDecodeMemory(0) {}
+                , fMaxDecodeMemory(0)
+                , fExecutor(nullptr)
+                , fProgressivePreviews(false)
+                , fUseDecoderThreads(false) {}
 
         ZeroInitialized fZeroInitialized;
         /**
@@ -387,6 +391,38 @@ public:
          * If non-zero, image decoding will fail if cumulative allocations exceed this many bytes.
          */
         size_t fMaxDecodeMemory;
+
+        /**
+         *  If not NULL, codecs that can split a full-image getPixels() decode into independent
+         *  pieces may decode those pieces concurrently on this executor. The call still blocks
+         *  until the whole image is decoded. Codecs that cannot split the image ignore it.
+         *
+         *  Currently used by JPEG for baseline images with restart intervals.
+         */
+        SkExecutor* fExecutor;
+
+        /**
+         *  If true, an incremental decode of an image encoded in several passes over the whole
+         *  frame (progressive JPEG, interlaced PNG) writes all of dst each time another pass
+         *  completes, with the coarser passes upsampled to fill it. incrementalDecode() then
+         *  reports every row as decoded, so the client can draw the preview while it waits for
+         *  more data. dst is left alone between passes.
+         *
+         *  Progressive JPEGs only support incremental decoding with this set, and without
+         *  fSubset; otherwise startIncrementalDecode() returns kUnimplemented. Other images
+         *  ignore this.
+         */
+        bool fProgressivePreviews;
+
+        /**
+         *  If true, codecs whose decoding library can run part of its work on a thread of its own
+         *  may start one for this decode. That thread is not part of fExecutor. The output is
+         *  unchanged.
+         *
+         *  Currently used by WebP, where libwebp filters rows on its worker thread while it
+         *  decodes the next ones.
+         */
+        bool fUseDecoderThreads;
     };
 
     /**
@@ -1072,11 +1108,13 @@ private:
     }
 
     /**
-     *  Checks whether the implementation supports incremental decoding for the given info.
+     *  Checks whether the implementation supports incremental decoding for the given info and
+     *  options. If not, startIncrementalDecode() returns kUnimplemented before touching the
+     *  stream, so callers can fall back to another kind of decode without a rewind.
      *
      *  Note that onStartIncrementalDecode can stil fail regardless of this result.
      */
-    virtual bool onSupportsIncrementalDecode(const SkImageInfo&) { return false; }
+    virtual bool onSupportsIncrementalDecode(const SkImageInfo&, const Options&) { return false; }
 
     virtual Result onStartIncrementalDecode(const SkImageInfo& /*dstInfo*/, void*, size_t,
             const Options&) {
@@ -0,0 +1,65 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCodecDownscale_DEFINED
+#define SkCodecDownscale_DEFINED
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
+#include "include/private/SkAPI.h"
+
+class SkExecutor;
+
+namespace SkCodecs {
+
+enum class DownscaleFilter {
+    kBox,       // Area average. Each destination pixel is the mean of the pixels it covers.
+    kMitchell,  // Mitchell-Netravali cubic (B = C = 1/3), widened to the scale factor.
+};
+
+/**
+ *  Decodes the codec's image and downscales it to fit dst.
+ *
+ *  The image is decoded at the smallest scale the codec supports natively (e.g. JPEG DCT scaling)
+ *  that is no smaller than dst. If the codec supports scanline decoding, rows are then streamed
+ *  through the filter one at a time, so only a few rows of the decoded image are held in memory
+ *  and the full resolution pixels are walked once. Otherwise the image is decoded at that scale
+ *  in full and then filtered.
+ *
+ *  Filtering happens on premultiplied pixels in dst's color space. The encoded origin is not
+ *  applied.
+ *
+ *  Returns kInvalidScale if dst is larger than the image in either dimension. If the encoded
+ *  data is truncated, dst is still written and kIncompleteInput is returned.
+ */
+SK_API SkCodec::Result DecodeAndDownscale(SkCodec* codec,
+                                          const SkPixmap& dst,
+                                          DownscaleFilter filter = DownscaleFilter::kBox);
+
+struct DownscaleTask {
+    sk_sp<SkData>   fData;
+    SkPixmap        fDst;
+    SkCodec::Result fResult = SkCodec::kInternalError;
+};
+
+/**
+ *  Runs DecodeAndDownscale() for each task, writing each result to its fResult. Tasks whose
+ *  data is not a recognized image get kInvalidInput.
+ *
+ *  If executor is non-null, the tasks run concurrently on it, and this returns once all of them
+ *  are done. Otherwise they run in order on the calling thread.
+ */
+SK_API void DecodeAndDownscale(SkSpan<DownscaleTask> tasks,
+                               DownscaleFilter filter,
+                               SkExecutor* executor);
+
+}  // namespace SkCodecs
+
+#endif  // SkCodecDownscale_DEFINED
@@ -9,6 +9,7 @@
 #define SkBBHFactory_DEFINED
 
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/core/SkTypes.h"
 
 // TODO(kjlubick) fix client users and then make this a forward declare
@@ -34,6 +35,13 @@ public:
      */
     virtual void search(const SkRect& query, std::vector<int>* results) const = 0;
 
+    /**
+     * Populate results[i] with the indices of bounding boxes intersecting queries[i], for each
+     * query. Hierarchies may share work between the queries, e.g. when searching for every tile
+     * of a picture at once.
+     */
+    virtual void searchBatch(SkSpan<const SkRect> queries, std::vector<int> results[]) const;
+
     /**
      * Return approximate size in memory of *this.
      */
@@ -64,4 +72,14 @@ public:
     sk_sp<SkBBoxHierarchy> operator()() const override;
 };
 
+/**
+ *  Makes R-Trees that store the bounds of each node's children in separate arrays per edge, and
+ *  test a query against all of them with a few SIMD compares. Searches are usually faster than
+ *  with SkRTreeFactory, at the cost of building a tree with more, smaller nodes.
+ */
+class SK_API SkPackedRTreeFactory : public SkBBHFactory {
+public:
+    sk_sp<SkBBoxHierarchy> operator()() const override;
+};
+
 #endif
@@ -11,12 +11,25 @@
 
 #include <memory>
 
+class SkExecutor;
+
 namespace skcpu {
 class Recorder;
 
 class SK_API Context {
 public:
-    struct Options {};
+    struct Options {
+        /**
+         *  If set, anti-aliased fills of very complex polygons (e.g. with many thousands of edges)
+         *  within rectangular clips are blitted in horizontal bands of the clip, and the passes of
+         *  large image filter blurs are split into spans, concurrently on this executor. The
+         *  pixels are the same as without an executor. The executor must outlive the Context and
+         *  any Recorders made from it.
+         */
+        SkExecutor* fExecutor = nullptr;
+    };
+
+    virtual ~Context();
 
     std::unique_ptr<Recorder> makeRecorder() const;
 
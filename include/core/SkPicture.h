@@ -70,6 +70,9 @@ public:
         may be used to provide user context to procs->fPictureProc; procs->fPictureProc
         is called with a pointer to data, data byte length, and user context.
 
+        Large payloads, such as encoded images, may be referenced from data rather than
+        copied, so data may be memory mapped (see SkData::MakeFromFileName()).
+
         @param data   container for serial data
         @param procs  custom serial data decoders; may be nullptr
         @return       SkPicture constructed from data
@@ -258,7 +261,8 @@ private:
         bool textBlobsOnly=false) const;
     static sk_sp<SkPicture> MakeFromStreamPriv(SkStream*, const SkDeserialProcs*,
                                                class SkTypefacePlayback*,
-                                               int recursionLimit);
+                                               int recursionLimit,
+                                               bool shareStreamData = false);
     friend class SkPictureData;
 
     /** Return true if the SkStream/Buffer represents a serialized picture, and
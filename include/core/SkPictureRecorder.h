@@ -90,6 +90,16 @@ public:
      */
     sk_sp<SkDrawable> finishRecordingAsDrawable();
 
+    /**
+     *  If enabled, finishing a recording also runs optimizations that take longer but make
+     *  playback cheaper: draws hidden under later opaque rects or paints are dropped, clips that
+     *  cannot change anything are removed, and runs of pixel-aligned rects that share a paint are
+     *  merged into one region. Whether a draw is hidden is decided on the recording's pixel grid,
+     *  so only enable this for content that will be drawn at integer translations.
+     *  Disabled by default.
+     */
+    void setOptimizeForPlayback(bool optimize) { fOptimizeForPlayback = optimize; }
+
 private:
     void reset();
 
@@ -107,6 +117,7 @@ private:
     sk_sp<SkRecord> fRecord;
     SkRect fCullRect;
     bool fActivelyRecording;
+    bool fOptimizeForPlayback = false;
 
     SkPictureRecorder(SkPictureRecorder&&) = delete;
     SkPictureRecorder& operator=(SkPictureRecorder&&) = delete;
@@ -0,0 +1,86 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkTiledRaster_DEFINED
+#define SkTiledRaster_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
+#include "include/private/SkAPI.h"
+
+#include <vector>
+
+class SkExecutor;
+class SkImage;
+class SkPicture;
+class SkSurface;
+class SkSurfaceProps;
+struct SkImageInfo;
+
+/** \namespace SkTiledRaster
+    SkTiledRaster rasterizes recorded draws into raster-backed SkSurfaces using many threads.
+    The recorded ops are binned into screen tiles by their conservative bounds and the tiles are
+    drawn concurrently on a caller-supplied SkExecutor. Each tile replays its ops in recorded
+    order through its own SkCanvas clipped to the tile. Ops that would rasterize differently
+    under the tile's clip, like paths crossing tile edges, image filters and backdrops, are
+    drawn once across all the tiles they touch, after those tiles have drawn the ops before them,
+    while other tiles carry on. The resulting pixels match drawing the SkPicture into the
+    surface's canvas on a single thread.
+
+    To use it, record draws with SkPictureRecorder (no SkBBHFactory is needed) and pass the
+    finished SkPicture to DrawPicture(), or to DrawPictureTiles() to get each tile as its own
+    SkImage.
+*/
+namespace SkTiledRaster {
+
+struct Options {
+    /** Size of the tiles rasterized by each task. Smaller tiles balance load better across
+        threads; larger tiles replay fewer ops that straddle tile boundaries.
+    */
+    SkISize fTileSize = {256, 256};
+
+    /** Runs one task per tile. If nullptr, tiles are drawn serially on the calling thread. */
+    SkExecutor* fExecutor = nullptr;
+};
+
+/** Draws picture into the pixels of surface, as if by surface->getCanvas()->drawPicture(picture)
+    on a canvas with an identity matrix and no clip. The surface canvas' current matrix and clip
+    are ignored. Blocks until every tile has been drawn.
+
+    Pictures that cannot be split into ops are drawn serially on the calling thread.
+
+    @param surface  raster-backed SkSurface
+    @param picture  recorded draws, in the surface's pixel coordinates
+    @return         false if surface is not raster-backed or its pixels could not be accessed
+*/
+SK_API bool DrawPicture(SkSurface* surface, const SkPicture* picture, const Options& = {});
+
+/** Draws picture into a grid of separate raster images, as map tile renderers do. The grid
+    covers the area (0, 0, info.width(), info.height()) of the picture with tiles of
+    Options::fTileSize; tiles on the right and bottom edges are cropped to that area. Each tile
+    has its top left corner at its origin and pixels of info's color type, alpha type and color
+    space, matching that part of drawPicture() on a cleared canvas of info's size.
+
+    The ops each tile needs are found once for all tiles, with one pass over the picture's
+    SkBBoxHierarchy if it was recorded with one. The tiles are then drawn concurrently on
+    Options::fExecutor, sharing the picture's ops and paints, into scratch pixels covering the
+    whole area, and copied out. Blocks until every tile is done.
+
+    @param picture  recorded draws
+    @param info     size of the area to draw, and the pixel format of the tiles
+    @param props    surface properties of each tile's canvas; may be nullptr
+    @return         tiles in row-major order, or an empty vector if picture is nullptr, info is
+                    empty or not a valid raster format, or pixels could not be allocated
+*/
+SK_API std::vector<sk_sp<SkImage>> DrawPictureTiles(const SkPicture* picture,
+                                                    const SkImageInfo& info,
+                                                    const Options& = {},
+                                                    const SkSurfaceProps* props = nullptr);
+
+}  // namespace SkTiledRaster
+
+#endif
@@ -164,6 +164,15 @@ struct Metadata {
     */
     bool fRasterizeAlphaGradientsForPrinting = false;
 
+    /** If true, each page object is written as soon as the page ends instead of
+        being held until the document is closed, and shading patterns are only
+        shared within a page.  Memory then stays flat for arbitrarily long
+        documents, at the cost of a flat page tree and of writing a pattern once
+        for every page that uses it.  Fonts are still written at close, subset
+        from their glyph usage bitsets.
+    */
+    bool fStreamPages = false;
+
     /** An optional tree of structured document tags that provide
         a semantic representation of the content. The caller
         should retain ownership.
@@ -179,10 +188,12 @@ struct Metadata {
     /** Executor to handle threaded work within PDF Backend. If this is nullptr,
         then all work will be done serially on the main thread. To have worker
         threads assist with various tasks, set this to a valid SkExecutor
-        instance. Currently used for executing Deflate algorithm in parallel.
+        instance. Currently used for encoding images, deflating streams, and
+        subsetting fonts and building their ToUnicode maps in parallel.
 
-        If set, the PDF output will be non-reproducible in the order and
-        internal numbering of objects, but should render the same.
+        Objects are written in the same order as a serial run, so the output
+        is reproducible, except that objects created while encoding an image
+        (its soft mask or ICC profile) are numbered when the encode runs.
 
         Experimental.
     */
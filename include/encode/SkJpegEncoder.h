@@ -18,6 +18,7 @@
 class SkColorSpace;
 class SkData;
 class SkEncoder;
+class SkExecutor;
 class SkPixmap;
 class SkWStream;
 class SkImage;
@@ -80,6 +81,19 @@ struct Options {
     const SkData* xmpMetadata = nullptr;
 
     std::optional<SkEncodedOrigin> fOrigin;
+
+    /**
+     *  If non-null, the image is split into bands of whole restart intervals once its last row
+     *  is written, and the bands are encoded concurrently on this executor with the same
+     *  quantization and Huffman tables.  The bands are stitched into a single baseline JPEG
+     *  with a restart marker after every MCU row.  It decodes to the same pixels as the serial
+     *  encoder, but uses the standard Huffman tables rather than ones optimized for the image,
+     *  so the file is usually a little larger.
+     *
+     *  Images too small to split into at least two bands are encoded serially.  The executor
+     *  must outlive the encode call.
+     */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /**
@@ -20,6 +20,7 @@
 
 class GrDirectContext;
 class SkData;
+class SkExecutor;
 class SkImage;
 class SkPixmap;
 class SkWStream;
@@ -90,6 +91,18 @@ struct Options {
      */
     const SkPixmap* fGainmap = nullptr;
     const SkGainmapInfo* fGainmapInfo = nullptr;
+
+    /**
+     *  If non-null, rows are buffered until the last one is written, then split into bands
+     *  that are filtered and deflated concurrently on this executor.  Each band is primed
+     *  with the tail of the previous band as its dictionary and the results are stitched
+     *  into a single zlib stream, so the output is a standard PNG that decodes to the same
+     *  pixels as the serial encoder.  The compressed size may differ slightly.
+     *
+     *  This trades memory (the whole image is held until encoding finishes) for throughput
+     *  on large images.  The executor must outlive the encode call.
+     */
+    SkExecutor* fExecutor = nullptr;
 };
 
 /**
@@ -42,6 +42,13 @@ struct SK_API Options {
      */
     Compression fCompression = Compression::kLossy;
     float fQuality = 100.0f;
+
+    /**
+     *  If true, libwebp may use a worker thread of its own while encoding. Lossy images with
+     *  alpha then compress the alpha plane alongside the color planes, and lossless images
+     *  try several of their compression strategies at once. The output is the same either way.
+     */
+    bool fUseThreads = false;
 };
 
 /**
@@ -21,6 +21,7 @@
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkTypes.h"
+#include "src/codec/SkCodecFrameCache.h"
 #include "src/codec/SkCodecImageGenerator.h"
 
 #include <algorithm>
@@ -32,22 +33,28 @@
 SkAnimCodecPlayer::SkAnimCodecPlayer(std::unique_ptr<SkCodec> codec) : fCodec(std::move(codec)) {
     fImageInfo = fCodec->getInfo();
     fFrameInfos = fCodec->getFrameInfo();
-    fImages.resize(fFrameInfos.size());
 
     // change the interpretation of fDuration to a end-time for that frame
     size_t dur = 0;
     for (auto& f : fFrameInfos) {
         dur += f.fDuration;
         f.fDuration = dur;
+        if (f.fAlphaType != kOpaque_SkAlphaType && fImageInfo.isOpaque()) {
+            // Decode every frame with the same info, so that any cached frame can be used as
+            // the starting point for decoding a later one.
+            fImageInfo = fImageInfo.makeAlphaType(kPremul_SkAlphaType);
+        }
     }
     fTotalDuration = dur;
 
     if (!fTotalDuration) {
         // Static image -- may or may not have returned a single frame info.
         fFrameInfos.clear();
-        fImages.clear();
-        fImages.push_back(SkImages::DeferredFromGenerator(
-                SkCodecImageGenerator::MakeFromCodec(std::move(fCodec))));
+        fImage = SkImages::DeferredFromGenerator(
+                SkCodecImageGenerator::MakeFromCodec(std::move(fCodec)));
+        fImageIndex = 0;
+    } else {
+        fFrameCache = std::make_unique<SkCodecFrameCache>(fCodec.get());
     }
 }
 
@@ -55,8 +62,7 @@ SkAnimCodecPlayer::~SkAnimCodecPlayer() {}
 
 SkISize SkAnimCodecPlayer::dimensions() const {
     if (!fCodec) {
-        auto image = fImages.front();
-        return image ? image->dimensions() : SkISize::MakeEmpty();
+        return fImage ? fImage->dimensions() : SkISize::MakeEmpty();
     }
     if (SkEncodedOriginSwapsWidthHeight(fCodec->getOrigin())) {
         return { fImageInfo.height(), fImageInfo.width() };
@@ -67,54 +73,31 @@ SkISize SkAnimCodecPlayer::dimensions() const {
 sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
     SkASSERT((unsigned)index < fFrameInfos.size());
 
-    if (fImages[index]) {
-        return fImages[index];
+    if (fImageIndex == index) {
+        return fImage;
     }
 
     size_t rb = fImageInfo.minRowBytes();
     size_t size = fImageInfo.computeByteSize(rb);
     auto data = SkData::MakeUninitialized(size);
 
-    SkCodec::Options opts;
-    opts.fFrameIndex = index;
-
-    const auto origin = fCodec->getOrigin();
-    const auto orientedDims = this->dimensions();
-    const auto originMatrix = SkEncodedOriginToMatrix(origin, orientedDims.width(),
-                                                              orientedDims.height());
-
-    SkPaint paint;
-    paint.setBlendMode(SkBlendMode::kSrc);
-
-    auto imageInfo = fImageInfo;
-    if (fFrameInfos[index].fAlphaType != kOpaque_SkAlphaType && imageInfo.isOpaque()) {
-        imageInfo = imageInfo.makeAlphaType(kPremul_SkAlphaType);
-    }
-    const int requiredFrame = fFrameInfos[index].fRequiredFrame;
-    if (requiredFrame != SkCodec::kNoFrame && fImages[requiredFrame]) {
-        auto requiredImage = fImages[requiredFrame];
-        auto canvas = SkCanvas::MakeRasterDirect(imageInfo, data->writable_data(), rb);
-        if (origin != kDefault_SkEncodedOrigin) {
-            // The required frame is stored after applying the origin. Undo that,
-            // because the codec decodes prior to applying the origin.
-            // FIXME: Another approach would be to decode the frame's delta on top
-            // of transparent black, and then draw that through the origin matrix
-            // onto the required frame. To do that, SkCodec needs to expose the
-            // rectangle of the delta and the blend mode, so we can handle
-            // kRestoreBGColor frames and Blend::kSrc.
-            canvas->concat(*originMatrix.invert());
-        }
-        canvas->drawImage(requiredImage, 0, 0, SkSamplingOptions(), &paint);
-        opts.fPriorFrame = requiredFrame;
-    }
-
-    if (SkCodec::kSuccess != fCodec->getPixels(imageInfo, data->writable_data(), rb, &opts)) {
+    // The frame cache restarts from the nearest snapshot of an earlier frame, so scrubbing and
+    // looping do not redecode the whole dependency chain. A frame that fails to decode leaves the
+    // current frame as it was.
+    if (SkCodec::kSuccess != fFrameCache->getFrame(fImageInfo, data->writable_data(), rb, index)) {
         return nullptr;
     }
 
-    auto image = SkImages::RasterFromData(imageInfo, std::move(data), rb);
+    auto image = SkImages::RasterFromData(fImageInfo, std::move(data), rb);
+    const auto origin = fCodec->getOrigin();
     if (origin != kDefault_SkEncodedOrigin) {
-        imageInfo = imageInfo.makeDimensions(orientedDims);
+        const auto orientedDims = this->dimensions();
+        const auto originMatrix = SkEncodedOriginToMatrix(origin, orientedDims.width(),
+                                                                  orientedDims.height());
+        SkPaint paint;
+        paint.setBlendMode(SkBlendMode::kSrc);
+
+        auto imageInfo = fImageInfo.makeDimensions(orientedDims);
         rb = imageInfo.minRowBytes();
         size = imageInfo.computeByteSize(rb);
         data = SkData::MakeUninitialized(size);
@@ -123,15 +106,16 @@ sk_sp<SkImage> SkAnimCodecPlayer::getFrameAt(int index) {
         canvas->drawImage(image, 0, 0, SkSamplingOptions(), &paint);
         image = SkImages::RasterFromData(imageInfo, std::move(data), rb);
     }
-    return fImages[index] = image;
+    fImageIndex = index;
+    return fImage = image;
 }
 
 sk_sp<SkImage> SkAnimCodecPlayer::getFrame() {
-    SkASSERT(fTotalDuration > 0 || fImages.size() == 1);
+    SkASSERT(fTotalDuration > 0 || fImageIndex == 0);
 
     return fTotalDuration > 0
         ? this->getFrameAt(fCurrIndex)
-        : fImages.front();
+        : fImage;
 }
 
 bool SkAnimCodecPlayer::seek(uint32_t msec) {
@@ -17,6 +17,7 @@
 #include <memory>
 #include <vector>
 
+class SkCodecFrameCache;
 class SkImage;
 
 class SkAnimCodecPlayer {
@@ -53,12 +54,16 @@ public:
 
 
 private:
-    std::unique_ptr<SkCodec>        fCodec;
-    SkImageInfo                     fImageInfo;
-    std::vector<SkCodec::FrameInfo> fFrameInfos;
-    std::vector<sk_sp<SkImage> >    fImages;
-    int                             fCurrIndex = 0;
-    uint32_t                        fTotalDuration;
+    std::unique_ptr<SkCodec>           fCodec;
+    // Decoded frames live in the (budgeted) SkResourceCache rather than in this object, so
+    // long animations do not pin every frame in memory.
+    std::unique_ptr<SkCodecFrameCache> fFrameCache;
+    SkImageInfo                        fImageInfo;
+    std::vector<SkCodec::FrameInfo>    fFrameInfos;
+    sk_sp<SkImage>                     fImage;
+    int                                fImageIndex = -1;
+    int                                fCurrIndex = 0;
+    uint32_t                           fTotalDuration;
 
     sk_sp<SkImage> getFrameAt(int index);
 };
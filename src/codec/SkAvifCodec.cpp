@@ -15,11 +15,13 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypes.h"
+#include "include/core/SkYUVAInfo.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkCodecPriv.h"
 #include "src/core/SkRectMemcpy.h"
 #include "src/core/SkStreamPriv.h"
 
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -278,6 +280,114 @@ SkCodec::Result SkAvifCodec::onGetPixels(const SkImageInfo& dstInfo,
     return kSuccess;
 }
 
+// Describes the planes libavif decodes |image| into, if they can be handed out as SkYUVAPixmaps.
+static bool is_yuv_supported(const avifImage& image,
+                             bool alphaPresent,
+                             SkEncodedOrigin origin,
+                             const SkYUVAPixmapInfo::SupportedDataTypes* supportedDataTypes,
+                             SkYUVAPixmapInfo* yuvaPixmapInfo) {
+    // Deeper images would need kUnorm16 planes rescaled from their 10 or 12 bit values.
+    if (image.depth != 8) {
+        return false;
+    }
+
+    SkYUVAInfo::Subsampling subsampling;
+    switch (image.yuvFormat) {
+        case AVIF_PIXEL_FORMAT_YUV444:
+            subsampling = SkYUVAInfo::Subsampling::k444;
+            break;
+        case AVIF_PIXEL_FORMAT_YUV422:
+            subsampling = SkYUVAInfo::Subsampling::k422;
+            break;
+        case AVIF_PIXEL_FORMAT_YUV420:
+            subsampling = SkYUVAInfo::Subsampling::k420;
+            break;
+        default:
+            return false;
+    }
+
+    SkYUVColorSpace yuvColorSpace;
+    if (!SkCodecPriv::SelectYUVColorSpace(image.matrixCoefficients,
+                                          image.yuvRange == AVIF_RANGE_FULL,
+                                          &yuvColorSpace)) {
+        return false;
+    }
+
+    // SkYUVAInfo has no way to say that Y, U and V were premultiplied by alpha.
+    if (alphaPresent && image.alphaPremultiplied) {
+        return false;
+    }
+    const auto planeConfig = alphaPresent ? SkYUVAInfo::PlaneConfig::kY_U_V_A
+                                          : SkYUVAInfo::PlaneConfig::kY_U_V;
+    if (supportedDataTypes &&
+        !supportedDataTypes->supported(planeConfig, SkYUVAPixmapInfo::DataType::kUnorm8)) {
+        return false;
+    }
+    if (yuvaPixmapInfo) {
+        SkISize dimensions = {static_cast<int>(image.width), static_cast<int>(image.height)};
+        if (SkEncodedOriginSwapsWidthHeight(origin)) {
+            dimensions = {dimensions.height(), dimensions.width()};
+        }
+        SkYUVAInfo yuvaInfo(dimensions,
+                            planeConfig,
+                            subsampling,
+                            yuvColorSpace,
+                            origin,
+                            SkYUVAInfo::Siting::kCentered,
+                            SkYUVAInfo::Siting::kCentered);
+        *yuvaPixmapInfo = SkYUVAPixmapInfo(yuvaInfo, SkYUVAPixmapInfo::DataType::kUnorm8, nullptr);
+    }
+    return true;
+}
+
+bool SkAvifCodec::onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
+                                  SkYUVAPixmapInfo* yuvaPixmapInfo) const {
+    // avifDecoderParse() has already filled in the format of the (still) image.
+    if (fUseAnimation) {
+        return false;
+    }
+    return is_yuv_supported(*fAvifDecoder->image,
+                            fAvifDecoder->alphaPresent == AVIF_TRUE,
+                            this->getOrigin(),
+                            &supportedDataTypes,
+                            yuvaPixmapInfo);
+}
+
+SkCodec::Result SkAvifCodec::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
+    if (fUseAnimation) {
+        return kInvalidInput;
+    }
+
+    avifResult result = avifDecoderNthImage(fAvifDecoder.get(), 0);
+    if (result != AVIF_RESULT_OK) {
+        return kInvalidInput;
+    }
+
+    // Check the decoded image against what onQueryYUVAInfo() promised before the decode.
+    const avifImage& image = *fAvifDecoder->image;
+    const bool alphaPresent = fAvifDecoder->alphaPresent == AVIF_TRUE;
+    SkYUVAPixmapInfo info;
+    if (!is_yuv_supported(image, alphaPresent, this->getOrigin(), nullptr, &info) ||
+        info.yuvaInfo() != yuvaPixmaps.yuvaInfo() ||
+        info.dataType() != yuvaPixmaps.dataType() ||
+        (alphaPresent && !image.alphaPlane)) {
+        return kInvalidInput;
+    }
+
+    // libavif owns the decoded planes, so copy them out without converting to RGB.
+    const std::array<SkPixmap, SkYUVAPixmaps::kMaxPlanes>& planes = yuvaPixmaps.planes();
+    for (int i = 0; i < yuvaPixmaps.numPlanes(); ++i) {
+        const uint8_t* src = i < 3 ? image.yuvPlanes[i] : image.alphaPlane;
+        const size_t srcRowBytes = i < 3 ? image.yuvRowBytes[i] : image.alphaRowBytes;
+        if (!src) {
+            return kInvalidInput;
+        }
+        SkRectMemcpy(planes[i].writable_addr(), planes[i].rowBytes(), src, srcRowBytes,
+                     planes[i].width(), planes[i].height());
+    }
+    return kSuccess;
+}
+
 namespace SkAvifDecoder {
 namespace LibAvif {
 
@@ -77,7 +77,7 @@ private:
                        int* rowsDecoded) override;
 
     // Incremental decoding support
-    bool onSupportsIncrementalDecode(const SkImageInfo&) override { return true; }
+    bool onSupportsIncrementalDecode(const SkImageInfo&, const Options&) override { return true; }
     Result onStartIncrementalDecode(const SkImageInfo& dstInfo,
                                    void* dst,
                                    size_t dstRowBytes,
@@ -619,7 +619,13 @@ SkCodec::Result SkCodec::startIncrementalDecode(const SkImageInfo& info, void* p
         size_t rowBytes, const SkCodec::Options* options) {
     fStartedIncrementalDecode = false;
 
-    if (!this->onSupportsIncrementalDecode(info)) {
+    // Set options.
+    Options optsStorage;
+    if (nullptr == options) {
+        options = &optsStorage;
+    }
+
+    if (!this->onSupportsIncrementalDecode(info, *options)) {
         return kUnimplemented;
     }
     if (kUnknown_SkColorType == info.colorType()) {
@@ -629,25 +635,21 @@ SkCodec::Result SkCodec::startIncrementalDecode(const SkImageInfo& info, void* p
         return kInvalidParameters;
     }
 
-    // Set options.
-    Options optsStorage;
-    if (nullptr == options) {
-        options = &optsStorage;
-    } else {
-        if (options->fSubset) {
-            SkIRect size = SkIRect::MakeSize(info.dimensions());
-            if (!size.contains(*options->fSubset)) {
-                return kInvalidParameters;
-            }
+    if (options->fSubset) {
+        SkIRect size = SkIRect::MakeSize(info.dimensions());
+        if (!size.contains(*options->fSubset)) {
+            return kInvalidParameters;
+        }
 
-            const int top = options->fSubset->top();
-            const int bottom = options->fSubset->bottom();
-            if (top < 0 || top >= info.height() || top >= bottom || bottom > info.height()) {
-                return kInvalidParameters;
-            }
+        const int top = options->fSubset->top();
+        const int bottom = options->fSubset->bottom();
+        if (top < 0 || top >= info.height() || top >= bottom || bottom > info.height()) {
+            return kInvalidParameters;
         }
     }
 
+    fDecodeBudget = options->fMaxDecodeMemory ? options->fMaxDecodeMemory : SIZE_MAX;
+
     const Result frameIndexResult = this->handleFrameIndex(info, pixels, rowBytes,
                                                            *options);
     if (frameIndexResult != kSuccess) {
@@ -837,6 +839,50 @@ bool SkCodecPriv::SelectXformFormat(SkColorType colorType,
     return true;
 }
 
+bool SkCodecPriv::SelectYUVColorSpace(uint8_t matrixCoefficients,
+                                      bool fullRange,
+                                      SkYUVColorSpace* outColorSpace) {
+    SkASSERT(outColorSpace);
+
+    switch (matrixCoefficients) {
+        case 0:  // Identity
+            if (!fullRange) {
+                return false;
+            }
+            *outColorSpace = kIdentity_SkYUVColorSpace;
+            break;
+        case 1:  // BT.709
+            *outColorSpace = fullRange ? kRec709_Full_SkYUVColorSpace
+                                       : kRec709_Limited_SkYUVColorSpace;
+            break;
+        case 2:  // Unspecified. Like libavif and dav1d, treat this as BT.601.
+        case 5:  // BT.470BG
+        case 6:  // BT.601
+            *outColorSpace = fullRange ? kJPEG_Full_SkYUVColorSpace
+                                       : kRec601_Limited_SkYUVColorSpace;
+            break;
+        case 4:  // FCC
+            *outColorSpace = fullRange ? kFCC_Full_SkYUVColorSpace
+                                       : kFCC_Limited_SkYUVColorSpace;
+            break;
+        case 7:  // SMPTE 240M
+            *outColorSpace = fullRange ? kSMPTE240_Full_SkYUVColorSpace
+                                       : kSMPTE240_Limited_SkYUVColorSpace;
+            break;
+        case 8:  // YCgCo
+            *outColorSpace = fullRange ? kYCgCo_8bit_Full_SkYUVColorSpace
+                                       : kYCgCo_8bit_Limited_SkYUVColorSpace;
+            break;
+        case 9:  // BT.2020 non-constant luminance
+            *outColorSpace = fullRange ? kBT2020_8bit_Full_SkYUVColorSpace
+                                       : kBT2020_8bit_Limited_SkYUVColorSpace;
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+
 bool SkCodec::initializeColorXform(const SkImageInfo& dstInfo, SkEncodedInfo::Alpha encodedAlpha,
                                    bool srcIsOpaque) {
     fXformTime = kNo_XformTime;
@@ -0,0 +1,286 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/codec/SkCodecDownscale.h"
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkSize.h"
+#include "include/private/SkTemplates.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <vector>
+
+using namespace skia_private;
+
+namespace SkCodecs {
+namespace {
+
+// Mitchell-Netravali with B = C = 1/3, which is nonzero on (-2, 2).
+float mitchell(float x) {
+    constexpr float B = 1.0f / 3, C = 1.0f / 3;
+    x = std::fabs(x);
+    if (x < 1) {
+        return ((12 - 9*B - 6*C) * x*x*x + (-18 + 12*B + 6*C) * x*x + (6 - 2*B)) / 6;
+    }
+    if (x < 2) {
+        return ((-B - 6*C) * x*x*x + (6*B + 30*C) * x*x + (-12*B - 48*C) * x + (8*B + 24*C)) / 6;
+    }
+    return 0;
+}
+
+// The source pixels that make up each destination pixel along one axis, and their weights.
+class Contributions {
+public:
+    Contributions(int srcSize, int dstSize, DownscaleFilter filter) {
+        SkASSERT(0 < dstSize && dstSize <= srcSize);
+        const double scale = (double)srcSize / dstSize;
+        const double radius = filter == DownscaleFilter::kBox ? scale / 2 : scale * 2;
+        fStride = (int)std::ceil(2 * radius) + 2;
+        fFirst.resize(dstSize);
+        fCount.resize(dstSize);
+        fWeights.resize((size_t)dstSize * fStride);
+
+        for (int i = 0; i < dstSize; i++) {
+            const double center = (i + 0.5) * scale;
+            const int first = std::max(0, (int)std::floor(center - radius));
+            const int end = std::min(srcSize, (int)std::ceil(center + radius));
+            float* weights = &fWeights[(size_t)i * fStride];
+            float sum = 0;
+            for (int k = first; k < end; k++) {
+                float w;
+                if (filter == DownscaleFilter::kBox) {
+                    // How much of source pixel k lies inside destination pixel i.
+                    w = (float)(std::min<double>(k + 1, center + radius) -
+                                std::max<double>(k, center - radius));
+                } else {
+                    w = mitchell((float)((k + 0.5 - center) / scale));
+                }
+                weights[k - first] = w;
+                sum += w;
+            }
+            for (int k = first; k < end; k++) {
+                weights[k - first] /= sum;
+            }
+            fFirst[i] = first;
+            fCount[i] = end - first;
+            SkASSERT(fCount[i] <= fStride);
+        }
+    }
+
+    int first(int i) const { return fFirst[i]; }
+    int end(int i) const { return fFirst[i] + fCount[i]; }
+    const float* weights(int i) const { return &fWeights[(size_t)i * fStride]; }
+
+private:
+    int                fStride;
+    std::vector<int>   fFirst;
+    std::vector<int>   fCount;
+    std::vector<float> fWeights;
+};
+
+// Downscales rows that arrive one at a time, top to bottom. Each row is converted to premul
+// F32 and filtered horizontally, then added into the few destination rows whose vertical
+// support covers it. A destination row is written as soon as its last source row arrives.
+class RowDownscaler {
+public:
+    RowDownscaler(const SkImageInfo& srcInfo, const SkPixmap& dst, DownscaleFilter filter)
+            : fSrcInfo(srcInfo.makeWH(srcInfo.width(), 1))
+            , fDst(dst)
+            , fFloatInfo(SkImageInfo::Make(srcInfo.width(), 1, kRGBA_F32_SkColorType,
+                                           srcInfo.alphaType(), srcInfo.refColorSpace()))
+            , fX(srcInfo.width(), dst.width(), filter)
+            , fY(srcInfo.height(), dst.height(), filter) {
+        // The destination rows being accumulated at any time are contiguous, since the first
+        // and last source rows of each destination row only move down.
+        int maxActive = 1;
+        for (int first = 0, last = 0; last < dst.height(); last++) {
+            while (fY.end(first) <= fY.first(last)) {
+                first++;
+            }
+            maxActive = std::max(maxActive, last - first + 1);
+        }
+        fActiveRows = maxActive;
+
+        const size_t dstFloats = (size_t)dst.width() * 4;
+        fSrcRow.reset((size_t)srcInfo.width() * 4);
+        fFilteredRow.reset(dstFloats);
+        fAccumulators.reset(dstFloats * fActiveRows);
+    }
+
+    void addRow(const void* row) {
+        SkASSERT(fSrcY < fY.end(fDst.height() - 1));
+        SkAssertResult(SkPixmap(fSrcInfo, row, fSrcInfo.minRowBytes())
+                               .readPixels(fFloatInfo, fSrcRow.get(), fFloatInfo.minRowBytes()));
+        this->filterRow();
+
+        const int y = fSrcY++;
+        const size_t dstFloats = (size_t)fDst.width() * 4;
+        for (int j = fNextDstY; j < fDst.height() && fY.first(j) <= y; j++) {
+            float* acc = fAccumulators.get() + (j % fActiveRows) * dstFloats;
+            const float w = fY.weights(j)[y - fY.first(j)];
+            if (y == fY.first(j)) {
+                for (size_t i = 0; i < dstFloats; i++) {
+                    acc[i] = w * fFilteredRow[i];
+                }
+            } else {
+                for (size_t i = 0; i < dstFloats; i++) {
+                    acc[i] += w * fFilteredRow[i];
+                }
+            }
+        }
+        while (fNextDstY < fDst.height() && fY.end(fNextDstY) == y + 1) {
+            this->writeRow(fNextDstY++);
+        }
+    }
+
+    int rowsNeeded() const { return fY.end(fDst.height() - 1); }
+
+private:
+    void filterRow() {
+        const float* src = fSrcRow.get();
+        float* dst = fFilteredRow.get();
+        for (int x = 0; x < fDst.width(); x++) {
+            const float* weights = fX.weights(x);
+            float r = 0, g = 0, b = 0, a = 0;
+            for (int k = fX.first(x); k < fX.end(x); k++) {
+                const float w = *weights++;
+                r += w * src[4*k + 0];
+                g += w * src[4*k + 1];
+                b += w * src[4*k + 2];
+                a += w * src[4*k + 3];
+            }
+            dst[4*x + 0] = r;
+            dst[4*x + 1] = g;
+            dst[4*x + 2] = b;
+            dst[4*x + 3] = a;
+        }
+    }
+
+    void writeRow(int j) {
+        float* acc = fAccumulators.get() + (j % fActiveRows) * (size_t)fDst.width() * 4;
+        // Cubic filters overshoot, so keep the result a valid premul color.
+        for (int x = 0; x < fDst.width(); x++) {
+            float* px = acc + 4*x;
+            px[3] = std::clamp(px[3], 0.0f, 1.0f);
+            for (int c = 0; c < 3; c++) {
+                px[c] = std::clamp(px[c], 0.0f, px[3]);
+            }
+        }
+        const SkImageInfo rowInfo = fFloatInfo.makeWH(fDst.width(), 1);
+        SkAssertResult(SkPixmap(rowInfo, acc, rowInfo.minRowBytes())
+                               .readPixels(fDst.info().makeWH(fDst.width(), 1),
+                                           fDst.writable_addr(0, j), fDst.rowBytes()));
+    }
+
+    const SkImageInfo   fSrcInfo;
+    const SkPixmap      fDst;
+    const SkImageInfo   fFloatInfo;
+    const Contributions fX;
+    const Contributions fY;
+    int                 fActiveRows;
+    AutoTMalloc<float>  fSrcRow;
+    AutoTMalloc<float>  fFilteredRow;
+    AutoTMalloc<float>  fAccumulators;
+    int                 fSrcY = 0;
+    int                 fNextDstY = 0;
+};
+
+// The smallest size the codec can decode to natively that is at least as large as dst.
+SkISize native_dimensions(const SkCodec* codec, SkISize dst) {
+    const SkISize full = codec->dimensions();
+    float scale = std::max((float)dst.width() / full.width(), (float)dst.height() / full.height());
+    while (scale < 1) {
+        const SkISize size = codec->getScaledDimensions(scale);
+        if (size.width() >= dst.width() && size.height() >= dst.height()) {
+            return size;
+        }
+        // Codecs round to the scales they support, which may fall short of the request.
+        scale += 1.0f / 16;
+    }
+    return full;
+}
+
+}  // namespace
+
+SkCodec::Result DecodeAndDownscale(SkCodec* codec, const SkPixmap& dst, DownscaleFilter filter) {
+    if (!codec || !dst.addr() || dst.width() <= 0 || dst.height() <= 0) {
+        return SkCodec::kInvalidParameters;
+    }
+    if (dst.colorType() == kUnknown_SkColorType) {
+        return SkCodec::kInvalidConversion;
+    }
+    if (dst.width() > codec->dimensions().width() ||
+        dst.height() > codec->dimensions().height()) {
+        return SkCodec::kInvalidScale;
+    }
+
+    // Decode to 8888 unless dst keeps more precision, and filter premultiplied pixels.
+    const SkColorType colorType = SkColorTypeBytesPerPixel(dst.colorType()) > 4
+                                          ? kRGBA_F16_SkColorType
+                                          : kN32_SkColorType;
+    const SkAlphaType alphaType = codec->getInfo().isOpaque() ? kOpaque_SkAlphaType
+                                                              : kPremul_SkAlphaType;
+    const SkImageInfo decodeInfo =
+            SkImageInfo::Make(native_dimensions(codec, dst.dimensions()), colorType, alphaType,
+                              dst.refColorSpace());
+
+    RowDownscaler downscaler(decodeInfo, dst, filter);
+    const size_t rowBytes = decodeInfo.minRowBytes();
+
+    SkCodec::Result result = codec->startScanlineDecode(decodeInfo);
+    if (result == SkCodec::kSuccess &&
+        codec->getScanlineOrder() == SkCodec::kTopDown_SkScanlineOrder) {
+        AutoTMalloc<uint8_t> row(rowBytes);
+        for (int y = 0; y < downscaler.rowsNeeded(); y++) {
+            // Missing rows are filled by the codec, so keep going to write all of dst.
+            if (codec->getScanlines(row.get(), 1, rowBytes) != 1) {
+                result = SkCodec::kIncompleteInput;
+            }
+            downscaler.addRow(row.get());
+        }
+        return result;
+    }
+
+    AutoTMalloc<uint8_t> pixels(decodeInfo.computeByteSize(rowBytes));
+    result = codec->getPixels(decodeInfo, pixels.get(), rowBytes);
+    if (result != SkCodec::kSuccess && result != SkCodec::kIncompleteInput &&
+        result != SkCodec::kErrorInInput) {
+        return result;
+    }
+    for (int y = 0; y < downscaler.rowsNeeded(); y++) {
+        downscaler.addRow(pixels.get() + y * rowBytes);
+    }
+    return result;
+}
+
+void DecodeAndDownscale(SkSpan<DownscaleTask> tasks,
+                        DownscaleFilter filter,
+                        SkExecutor* executor) {
+    auto run = [tasks, filter](int i) {
+        DownscaleTask& task = tasks[i];
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(task.fData);
+        task.fResult = codec ? DecodeAndDownscale(codec.get(), task.fDst, filter)
+                             : SkCodec::kInvalidInput;
+    };
+
+    if (!executor) {
+        for (size_t i = 0; i < tasks.size(); i++) {
+            run(i);
+        }
+        return;
+    }
+    SkTaskGroup taskGroup(*executor);
+    taskGroup.batch(tasks.size(), run);
+    taskGroup.wait();
+}
+
+}  // namespace SkCodecs
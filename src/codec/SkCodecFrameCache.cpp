@@ -0,0 +1,209 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkCodecFrameCache.h"
+
+#include "include/codec/SkCodecAnimation.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkFourByteTag.h"
+#include "include/core/SkImageInfo.h"
+#include "src/core/SkCachedData.h"
+#include "src/core/SkNextID.h"
+#include "src/core/SkRectMemcpy.h"
+#include "src/core/SkResourceCache.h"
+
+#include <algorithm>
+
+class SkDiscardableMemory;
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+namespace {
+static unsigned gCodecFrameKeyNamespaceLabel;
+
+struct CodecFrameKey : public SkResourceCache::Key {
+    CodecFrameKey(uint64_t sharedID, const SkImageInfo& info, int frameIndex)
+        : fFrameIndex(frameIndex)
+        , fWidth(info.width())
+        , fHeight(info.height())
+        , fColorAndAlphaType((info.colorType() << 8) | info.alphaType()) {
+        const uint64_t csHash = info.colorSpace() ? info.colorSpace()->hash() : 0;
+        fColorSpaceHash[0] = static_cast<uint32_t>(csHash);
+        fColorSpaceHash[1] = static_cast<uint32_t>(csHash >> 32);
+        this->init(&gCodecFrameKeyNamespaceLabel, sharedID,
+                   sizeof(fFrameIndex) + sizeof(fWidth) + sizeof(fHeight) +
+                   sizeof(fColorAndAlphaType) + sizeof(fColorSpaceHash));
+    }
+
+    int32_t  fFrameIndex;
+    int32_t  fWidth;
+    int32_t  fHeight;
+    uint32_t fColorAndAlphaType;
+    uint32_t fColorSpaceHash[2];
+};
+
+struct CodecFrameRec : public SkResourceCache::Rec {
+    CodecFrameRec(const CodecFrameKey& key, SkCachedData* data, size_t rowBytes)
+        : fKey(key)
+        , fData(data)
+        , fRowBytes(rowBytes) {
+        fData->attachToCacheAndRef();
+    }
+    ~CodecFrameRec() override {
+        fData->detachFromCacheAndUnref();
+    }
+
+    CodecFrameKey fKey;
+    SkCachedData* fData;
+    size_t        fRowBytes;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fData->size(); }
+    const char* getCategory() const override { return "codec-frame"; }
+    SkDiscardableMemory* diagnostic_only_getDiscardable() const override {
+        return fData->diagnostic_only_getDiscardable();
+    }
+
+    struct Dst {
+        const SkImageInfo& fInfo;
+        void*              fPixels;
+        size_t             fRowBytes;
+    };
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const CodecFrameRec& rec = static_cast<const CodecFrameRec&>(baseRec);
+        const Dst* dst = static_cast<const Dst*>(contextData);
+
+        SkCachedData* data = rec.fData;
+        data->ref();
+        if (nullptr == data->data()) {
+            data->unref();
+            return false;
+        }
+        SkRectMemcpy(dst->fPixels, dst->fRowBytes, data->data(), rec.fRowBytes,
+                     dst->fInfo.minRowBytes(), dst->fInfo.height());
+        data->unref();
+        return true;
+    }
+};
+}  // namespace
+
+SkCodecFrameCache::SkCodecFrameCache(SkCodec* codec,
+                                     int keyframeInterval,
+                                     SkResourceCache* localCache)
+        : fCodec(codec)
+        , fFrameInfos(codec->getFrameInfo())
+        , fSharedID(((uint64_t)SkSetFourByteTag('f', 'r', 'a', 'm') << 32) | SkNextID::ImageID())
+        , fKeyframeInterval(std::max(keyframeInterval, 1))
+        , fLocalCache(localCache) {
+    SkASSERT(fCodec);
+}
+
+SkCodecFrameCache::~SkCodecFrameCache() {
+    if (fLocalCache) {
+        fLocalCache->purgeSharedID(fSharedID);
+    } else {
+        SkResourceCache::PostPurgeSharedID(fSharedID);
+    }
+}
+
+int SkCodecFrameCache::requiredFrame(int index) const {
+    // Still images report no frame info.
+    return index < (int)fFrameInfos.size() ? fFrameInfos[index].fRequiredFrame
+                                           : SkCodec::kNoFrame;
+}
+
+bool SkCodecFrameCache::find(const SkImageInfo& info, int index,
+                             void* pixels, size_t rowBytes) const {
+    CodecFrameKey key(fSharedID, info, index);
+    CodecFrameRec::Dst dst = {info, pixels, rowBytes};
+    return CHECK_LOCAL(fLocalCache, find, Find, key, CodecFrameRec::Visitor, &dst);
+}
+
+void SkCodecFrameCache::add(const SkImageInfo& info, int index,
+                            const void* pixels, size_t rowBytes) {
+    const size_t minRowBytes = info.minRowBytes();
+    SkCachedData* data = CHECK_LOCAL(fLocalCache, newCachedData, NewCachedData,
+                                     info.computeByteSize(minRowBytes));
+    if (!data) {
+        return;
+    }
+    SkRectMemcpy(data->writable_data(), minRowBytes, pixels, rowBytes,
+                 minRowBytes, info.height());
+
+    CodecFrameKey key(fSharedID, info, index);
+    CHECK_LOCAL(fLocalCache, add, Add, new CodecFrameRec(key, data, minRowBytes));
+    // The rec holds its own ref.
+    data->unref();
+}
+
+int SkCodecFrameCache::findPriorFrame(const SkImageInfo& info, int index,
+                                      void* pixels, size_t rowBytes) const {
+    const int required = this->requiredFrame(index);
+    if (required == SkCodec::kNoFrame) {
+        return SkCodec::kNoFrame;
+    }
+    // SkCodec accepts any frame in [required, index) as fPriorFrame, unless it was meant to be
+    // restored to the frame before it.
+    for (int prior = index - 1; prior >= required; --prior) {
+        if (fFrameInfos[prior].fDisposalMethod ==
+                SkCodecAnimation::DisposalMethod::kRestorePrevious) {
+            continue;
+        }
+        if (this->find(info, prior, pixels, rowBytes)) {
+            return prior;
+        }
+    }
+    return SkCodec::kNoFrame;
+}
+
+SkCodec::Result SkCodecFrameCache::getFrame(const SkImageInfo& info, void* pixels,
+                                            size_t rowBytes, int index) {
+    if (index < 0) {
+        return SkCodec::kInvalidParameters;
+    }
+    if (index >= (int)fFrameInfos.size()) {
+        // More frames may have become available since the last call.
+        fFrameInfos = fCodec->getFrameInfo();
+    }
+
+    if (this->find(info, index, pixels, rowBytes)) {
+        return SkCodec::kSuccess;
+    }
+
+    // Walk back along the dependency chain until it reaches a cached frame or an independent one.
+    // chain holds the frames left to decode, newest first.
+    std::vector<int> chain = {index};
+    int priorFrame = SkCodec::kNoFrame;
+    while (this->requiredFrame(chain.back()) != SkCodec::kNoFrame) {
+        priorFrame = this->findPriorFrame(info, chain.back(), pixels, rowBytes);
+        if (priorFrame != SkCodec::kNoFrame) {
+            break;
+        }
+        chain.push_back(this->requiredFrame(chain.back()));
+    }
+
+    // Decode forward, snapshotting every fKeyframeInterval-th frame so that the next seek into
+    // this chain does not have to start over.
+    int decodedSinceSnapshot = 0;
+    for (auto it = chain.rbegin(); it != chain.rend(); ++it) {
+        SkCodec::Options options;
+        options.fFrameIndex = *it;
+        options.fPriorFrame = priorFrame;
+        const SkCodec::Result result = fCodec->getPixels(info, pixels, rowBytes, &options);
+        if (result != SkCodec::kSuccess) {
+            return result;
+        }
+        if (*it == index || ++decodedSinceSnapshot == fKeyframeInterval) {
+            this->add(info, *it, pixels, rowBytes);
+            decodedSinceSnapshot = 0;
+        }
+        priorFrame = *it;
+    }
+    return SkCodec::kSuccess;
+}
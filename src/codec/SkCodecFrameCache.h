@@ -0,0 +1,74 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkCodecFrameCache_DEFINED
+#define SkCodecFrameCache_DEFINED
+
+#include "include/codec/SkCodec.h"
+#include "include/core/SkTypes.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class SkResourceCache;
+struct SkImageInfo;
+
+/**
+ *  Random access to the frames of an animated SkCodec.
+ *
+ *  Decoding frame N of a GIF or animated WebP normally means decoding every frame in its
+ *  fRequiredFrame chain first. SkCodecFrameCache keeps snapshots of decoded frames in the
+ *  SkResourceCache, keyed by this object and the frame index, and starts each decode from the
+ *  nearest cached frame that SkCodec accepts as an fPriorFrame. Every requested frame is
+ *  snapshotted, as is every keyframeInterval-th frame decoded along a chain, so seeking costs at
+ *  most keyframeInterval decodes once the chain has been walked.
+ *
+ *  The snapshots are budgeted (and purged) like any other SkResourceCache entry, and are dropped
+ *  when the SkCodecFrameCache is destroyed.
+ */
+class SkCodecFrameCache {
+public:
+    static constexpr int kDefaultKeyframeInterval = 8;
+
+    /**
+     *  The codec is not owned, and must outlive this object. Frames are stored in localCache if
+     *  it is non-null, otherwise in the global SkResourceCache.
+     */
+    explicit SkCodecFrameCache(SkCodec* codec,
+                               int keyframeInterval = kDefaultKeyframeInterval,
+                               SkResourceCache* localCache = nullptr);
+    ~SkCodecFrameCache();
+
+    SkCodecFrameCache(const SkCodecFrameCache&) = delete;
+    SkCodecFrameCache& operator=(const SkCodecFrameCache&) = delete;
+
+    /**
+     *  Decodes frame 'index' into pixels, which need not hold any earlier frame. Produces the
+     *  same result as SkCodec::getPixels() with fPriorFrame == kNoFrame.
+     */
+    SkCodec::Result getFrame(const SkImageInfo& info, void* pixels, size_t rowBytes, int index);
+
+private:
+    int requiredFrame(int index) const;
+
+    // Copies the cached frame 'index' into pixels, if there is one.
+    bool find(const SkImageInfo&, int index, void* pixels, size_t rowBytes) const;
+    void add(const SkImageInfo&, int index, const void* pixels, size_t rowBytes);
+
+    // Looks for a cached frame that SkCodec accepts as the fPriorFrame of 'index', preferring the
+    // most recent one. On success copies it into pixels and returns its index, else kNoFrame.
+    int findPriorFrame(const SkImageInfo&, int index, void* pixels, size_t rowBytes) const;
+
+    SkCodec*                        fCodec;
+    std::vector<SkCodec::FrameInfo> fFrameInfos;
+    const uint64_t                  fSharedID;
+    const int                       fKeyframeInterval;
+    SkResourceCache*                fLocalCache;
+};
+
+#endif  // SkCodecFrameCache_DEFINED
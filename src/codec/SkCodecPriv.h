@@ -113,6 +113,14 @@ public:
                                   bool forColorTable,
                                   skcms_PixelFormat* outFormat);
 
+    /*
+     * Maps the CICP matrix_coefficients (ITU-T H.273) and range of an 8-bit YUV image to the
+     * SkYUVColorSpace that converts it to RGB. Returns false if Skia has no equivalent.
+     */
+    static bool SelectYUVColorSpace(uint8_t matrixCoefficients,
+                                    bool fullRange,
+                                    SkYUVColorSpace* outColorSpace);
+
     // FIXME: Consider sharing with dm, nanbench, and tools.
     static float GetScaleFromSampleSize(int sampleSize) { return 1.0f / ((float)sampleSize); }
 
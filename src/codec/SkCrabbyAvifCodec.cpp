@@ -16,12 +16,15 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkTypes.h"
+#include "include/core/SkYUVAInfo.h"
 #include "include/private/SkGainmapInfo.h"
 #include "include/private/SkMutex.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkCodecPriv.h"
+#include "src/core/SkRectMemcpy.h"
 #include "src/core/SkStreamPriv.h"
 
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <utility>
@@ -97,6 +100,14 @@ bool PopulateGainmapInfo(const crabbyavif::avifGainMap& gain_map,
     return true;
 }
 
+// Creating multiple MediaCodec instances can lead to binder starvation issues
+// (e.g. b/447869238) on Android. Guard every decode with a static lock so that
+// a single app process can only create one MediaCodec instance at a time.
+SkMutex& MediaCodecMutex() {
+    static SkMutex mutex;
+    return mutex;
+}
+
 SkEncodedOrigin ComputeSkEncodedOrigin(const crabbyavif::avifImage& image) {
     // |angle| * 90 specifies the angle of anti-clockwise rotation in degrees.
     // Legal values: [0-3].
@@ -134,6 +145,67 @@ SkEncodedOrigin ComputeSkEncodedOrigin(const crabbyavif::avifImage& image) {
     return kAxisAngleToSkEncodedOrigin[axis + 1][angle];
 }
 
+// Describes the planes of |image| (already cropped to its clean aperture and
+// reported as |dimensions|), if they can be handed out as SkYUVAPixmaps.
+bool IsYUVSupported(const crabbyavif::avifImage& image,
+                    SkISize dimensions,
+                    bool alphaPresent,
+                    SkEncodedOrigin origin,
+                    const SkYUVAPixmapInfo::SupportedDataTypes* supportedDataTypes,
+                    SkYUVAPixmapInfo* yuvaPixmapInfo) {
+    // Deeper images would need kUnorm16 planes rescaled from their 10 or 12 bit values.
+    if (image.depth != 8) {
+        return false;
+    }
+
+    SkYUVAInfo::Subsampling subsampling;
+    switch (image.yuvFormat) {
+        case crabbyavif::AVIF_PIXEL_FORMAT_YUV444:
+            subsampling = SkYUVAInfo::Subsampling::k444;
+            break;
+        case crabbyavif::AVIF_PIXEL_FORMAT_YUV422:
+            subsampling = SkYUVAInfo::Subsampling::k422;
+            break;
+        case crabbyavif::AVIF_PIXEL_FORMAT_YUV420:
+            subsampling = SkYUVAInfo::Subsampling::k420;
+            break;
+        default:
+            return false;
+    }
+
+    SkYUVColorSpace yuvColorSpace;
+    if (!SkCodecPriv::SelectYUVColorSpace(image.matrixCoefficients,
+                                          image.yuvRange == crabbyavif::AVIF_RANGE_FULL,
+                                          &yuvColorSpace)) {
+        return false;
+    }
+
+    // SkYUVAInfo has no way to say that Y, U and V were premultiplied by alpha.
+    if (alphaPresent && image.alphaPremultiplied) {
+        return false;
+    }
+    const auto planeConfig = alphaPresent ? SkYUVAInfo::PlaneConfig::kY_U_V_A
+                                          : SkYUVAInfo::PlaneConfig::kY_U_V;
+    if (supportedDataTypes &&
+        !supportedDataTypes->supported(planeConfig, SkYUVAPixmapInfo::DataType::kUnorm8)) {
+        return false;
+    }
+    if (yuvaPixmapInfo) {
+        if (SkEncodedOriginSwapsWidthHeight(origin)) {
+            dimensions = {dimensions.height(), dimensions.width()};
+        }
+        SkYUVAInfo yuvaInfo(dimensions,
+                            planeConfig,
+                            subsampling,
+                            yuvColorSpace,
+                            origin,
+                            SkYUVAInfo::Siting::kCentered,
+                            SkYUVAInfo::Siting::kCentered);
+        *yuvaPixmapInfo = SkYUVAPixmapInfo(yuvaInfo, SkYUVAPixmapInfo::DataType::kUnorm8, nullptr);
+    }
+    return true;
+}
+
 }  // namespace
 
 void AvifDecoderDeleter::operator()(crabbyavif::avifDecoder* decoder) const {
@@ -392,12 +464,7 @@ SkCodec::Result SkCrabbyAvifCodec::onGetPixels(const SkImageInfo& dstInfo,
                                                size_t dstRowBytes,
                                                const Options& options,
                                                int* rowsDecoded) {
-    // Creating multiple MediaCodec instances can lead to binder starvation
-    // issues (e.g. b/447869238) on Android. Guard access to this function with
-    // a static lock so that a single app process can only create one MediaCodec
-    // instance at a time.
-    static SkMutex mutex;
-    SkAutoMutexExclusive lock(mutex);
+    SkAutoMutexExclusive lock(MediaCodecMutex());
     switch (dstInfo.colorType()) {
         case kRGBA_8888_SkColorType:
         case kBGRA_8888_SkColorType:
@@ -538,6 +605,88 @@ SkCodec::Result SkCrabbyAvifCodec::onGetPixels(const SkImageInfo& dstInfo,
     return kSuccess;
 }
 
+bool SkCrabbyAvifCodec::onQueryYUVAInfo(
+        const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
+        SkYUVAPixmapInfo* yuvaPixmapInfo) const {
+    // avifDecoderParse() has already filled in the format of the (still) image.
+    if (fUseAnimation) {
+        return false;
+    }
+    const crabbyavif::avifImage* image =
+            fGainmapOnly ? fAvifDecoder->image->gainMap->image : fAvifDecoder->image;
+    return IsYUVSupported(*image,
+                          this->dimensions(),
+                          fAvifDecoder->alphaPresent && !fGainmapOnly,
+                          this->getOrigin(),
+                          &supportedDataTypes,
+                          yuvaPixmapInfo);
+}
+
+SkCodec::Result SkCrabbyAvifCodec::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
+    if (fUseAnimation) {
+        return kInvalidInput;
+    }
+
+    SkAutoMutexExclusive lock(MediaCodecMutex());
+    fAvifDecoder->androidMediaCodecOutputColorFormat =
+            crabbyavif::ANDROID_MEDIA_CODEC_OUTPUT_COLOR_FORMAT_YUV420_FLEXIBLE;
+    crabbyavif::avifResult result = crabbyavif::avifDecoderNthImage(fAvifDecoder.get(), 0);
+    if (result != crabbyavif::AVIF_RESULT_OK) {
+        return kInvalidInput;
+    }
+    if (fGainmapOnly && !fAvifDecoder->image->gainMap) {
+        return kInvalidInput;
+    }
+
+    crabbyavif::avifImage* image =
+            fGainmapOnly ? fAvifDecoder->image->gainMap->image : fAvifDecoder->image;
+    using AvifImagePtr =
+            std::unique_ptr<crabbyavif::avifImage, decltype(&crabbyavif::crabby_avifImageDestroy)>;
+
+    // As in onGetPixels(), never expose the pixels outside of the clean aperture.
+    AvifImagePtr cropped_image{nullptr, crabbyavif::crabby_avifImageDestroy};
+    if (image->transformFlags & crabbyavif::AVIF_TRANSFORM_CLAP) {
+        crabbyavif::avifCropRect rect;
+        if (crabbyavif::crabby_avifCropRectConvertCleanApertureBox(
+                    &rect, &image->clap, image->width, image->height, image->yuvFormat, nullptr)) {
+            cropped_image.reset(crabbyavif::crabby_avifImageCreateEmpty());
+            result = crabbyavif::crabby_avifImageSetViewRect(cropped_image.get(), image, &rect);
+            if (result != crabbyavif::AVIF_RESULT_OK) {
+                return kInvalidInput;
+            }
+            image = cropped_image.get();
+        }
+    }
+
+    // Check the decoded image against what onQueryYUVAInfo() promised before the decode. The
+    // decoder may have produced a different layout (e.g. semi-planar MediaCodec output), in which
+    // case the caller falls back to getPixels().
+    const bool alphaPresent = fAvifDecoder->alphaPresent && !fGainmapOnly;
+    SkYUVAPixmapInfo info;
+    if (!IsYUVSupported(*image, this->dimensions(), alphaPresent, this->getOrigin(), nullptr,
+                        &info) ||
+        info.yuvaInfo() != yuvaPixmaps.yuvaInfo() ||
+        info.dataType() != yuvaPixmaps.dataType() ||
+        image->width != static_cast<uint32_t>(this->dimensions().width()) ||
+        image->height != static_cast<uint32_t>(this->dimensions().height())) {
+        return kInvalidInput;
+    }
+
+    // The decoder owns its planes (which may be read-only MediaCodec buffers), so copy them out
+    // without converting to RGB.
+    const std::array<SkPixmap, SkYUVAPixmaps::kMaxPlanes>& planes = yuvaPixmaps.planes();
+    for (int i = 0; i < yuvaPixmaps.numPlanes(); ++i) {
+        const uint8_t* src = i < 3 ? image->yuvPlanes[i] : image->alphaPlane;
+        const size_t srcRowBytes = i < 3 ? image->yuvRowBytes[i] : image->alphaRowBytes;
+        if (!src) {
+            return kInvalidInput;
+        }
+        SkRectMemcpy(planes[i].writable_addr(), planes[i].rowBytes(), src, srcRowBytes,
+                     planes[i].width(), planes[i].height());
+    }
+    return kSuccess;
+}
+
 bool SkCrabbyAvifCodec::onGetGainmapCodec(SkGainmapInfo* info,
                                           std::unique_ptr<SkCodec>* gainmapCodec) {
     if (!gainmapCodec || !info || !fAvifDecoder->image || !fAvifDecoder->image->gainMap ||
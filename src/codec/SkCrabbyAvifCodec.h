@@ -12,6 +12,7 @@
 #include "include/codec/SkEncodedOrigin.h"
 #include "include/core/SkData.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkYUVAPixmaps.h"
 #include "include/private/SkEncodedInfo.h"
 #include "src/codec/SkFrameHolder.h"
 #include "src/codec/SkScalingCodec.h"
@@ -65,6 +66,9 @@ protected:
     bool conversionSupported(const SkImageInfo&, bool, bool) override;
     bool onGetGainmapCodec(SkGainmapInfo* info, std::unique_ptr<SkCodec>* gainmapCodec) override;
     bool onGetValidSubset(SkIRect*) const override { return true; }
+    bool onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes&,
+                         SkYUVAPixmapInfo*) const override;
+    Result onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) override;
 
 private:
     SkCrabbyAvifCodec(SkEncodedInfo&&,
@@ -348,14 +348,15 @@ bool SkIcoCodec::onSkipScanlines(int count) {
     return fCurrCodec->skipScanlines(count);
 }
 
-bool SkIcoCodec::onSupportsIncrementalDecode(const SkImageInfo& dstInfo) {
+bool SkIcoCodec::onSupportsIncrementalDecode(const SkImageInfo& dstInfo,
+                                              const Options& options) {
     for (int i = 0; ;++i) {
         i = this->chooseCodec(dstInfo.dimensions(), i);
         if (i < 0) {
             break;
         }
         SkASSERT(i < fEmbeddedCodecs->size());
-        if ((*fEmbeddedCodecs)[i]->onSupportsIncrementalDecode(dstInfo)) {
+        if ((*fEmbeddedCodecs)[i]->onSupportsIncrementalDecode(dstInfo, options)) {
             return true;
         }
     }
@@ -72,7 +72,7 @@ private:
 
     bool onSkipScanlines(int count) override;
 
-    bool onSupportsIncrementalDecode(const SkImageInfo&) override;
+    bool onSupportsIncrementalDecode(const SkImageInfo&, const Options&) override;
     Result onStartIncrementalDecode(const SkImageInfo& dstInfo, void* pixels, size_t rowBytes,
             const SkCodec::Options&) override;
 
@@ -12,6 +12,7 @@
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -26,17 +27,22 @@
 #include "src/codec/SkJpegDecoderMgr.h"
 #include "src/codec/SkJpegMetadataDecoderImpl.h"
 #include "src/codec/SkJpegPriv.h"
+#include "src/codec/SkJpegSegmentScan.h"
 #include "src/codec/SkParseEncodedOrigin.h"
 #include "src/codec/SkSwizzler.h"
+#include "src/core/SkTaskGroup.h"
 
 #ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
 #include "include/private/SkGainmapInfo.h"
 #endif  // SK_CODEC_DECODES_JPEG_GAINMAPS
 
 #include <array>
+#include <atomic>
 #include <setjmp.h>
 #include <cstring>
+#include <functional>
 #include <utility>
+#include <vector>
 
 using namespace skia_private;
 
@@ -488,6 +494,232 @@ static inline bool needs_swizzler_to_convert_from_cmyk(J_COLOR_SPACE jpegColorTy
     return !hasCMYKColorSpace || !hasColorSpaceXform;
 }
 
+// Where the pieces of a single-scan JPEG live in the encoded data.
+struct RestartIntervalLayout {
+    // Offset of the 16-bit image height in the start of frame segment.
+    size_t fFrameHeightOffset = 0;
+    // The entropy-coded data of the scan is [fScanDataOffset, fScanDataEnd).
+    size_t fScanDataOffset = 0;
+    size_t fScanDataEnd = 0;
+    // Offsets of the RSTn markers that end each restart interval but the last.
+    std::vector<size_t> fRestartMarkers;
+};
+
+static bool find_restart_intervals(const uint8_t* data, size_t size,
+                                   RestartIntervalLayout* layout) {
+    SkJpegSegmentScanner scanner(kJpegMarkerEndOfImage);
+    scanner.onBytes(data, size);
+    if (scanner.hadError() || !scanner.isDone()) {
+        return false;
+    }
+
+    int scanCount = 0;
+    for (const SkJpegSegment& segment : scanner.getSegments()) {
+        const uint8_t marker = segment.marker;
+        if (marker == 0xC0 || marker == 0xC1) {
+            // Baseline or extended sequential DCT: precision (1 byte) then height (2 bytes).
+            if (segment.parameterLength < kJpegSegmentParameterLengthSize + 3) {
+                return false;
+            }
+            layout->fFrameHeightOffset =
+                    segment.offset + kJpegMarkerCodeSize + kJpegSegmentParameterLengthSize + 1;
+        } else if (marker == kJpegMarkerStartOfScan) {
+            if (++scanCount > 1) {
+                return false;
+            }
+            layout->fScanDataOffset = segment.offset + kJpegMarkerCodeSize +
+                                      segment.parameterLength;
+        } else if (marker == kJpegMarkerEndOfImage) {
+            layout->fScanDataEnd = segment.offset;
+        } else if (scanCount == 1) {
+            // Within the scan, only restart markers are expected (e.g. no DNL).
+            if (marker < 0xD0 || marker > 0xD7) {
+                return false;
+            }
+            layout->fRestartMarkers.push_back(segment.offset);
+        }
+    }
+    return scanCount == 1 && layout->fFrameHeightOffset != 0 &&
+           layout->fFrameHeightOffset < layout->fScanDataOffset &&
+           layout->fScanDataOffset <= layout->fScanDataEnd;
+}
+
+// Decodes a standalone JPEG holding a strip of the original image, skipping its first 'skipRows'
+// rows (which only provide upsampling context) and passing the next 'rowCount' rows to 'onRow'.
+// If 'rowDst' returns non-null for a row, libjpeg-turbo decodes straight into that memory.
+static bool decode_restart_strip(sk_sp<SkData> strip,
+                                 const jpeg_decompress_struct& settings,
+                                 int skipRows,
+                                 int rowCount,
+                                 const std::function<JSAMPLE*(int row)>& rowDst,
+                                 const std::function<void(int row, const JSAMPLE*)>& onRow) {
+    SkMemoryStream stream(std::move(strip));
+    JpegDecoderMgr decoderMgr(&stream);
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(decoderMgr.errorMgr());
+    if (setjmp(jmp)) {
+        return false;
+    }
+
+    decoderMgr.init();
+    jpeg_decompress_struct* dinfo = decoderMgr.dinfo();
+    if (jpeg_read_header(dinfo, TRUE) != JPEG_HEADER_OK) {
+        return false;
+    }
+    dinfo->out_color_space = settings.out_color_space;
+    dinfo->dither_mode = settings.dither_mode;
+    if (!jpeg_start_decompress(dinfo)) {
+        return false;
+    }
+
+    AutoTMalloc<JSAMPLE> scratch(get_row_bytes(dinfo));
+    for (int y = 0; y < skipRows + rowCount; ++y) {
+        const int row = y - skipRows;
+        JSAMPLE* decodeDst = row >= 0 ? rowDst(row) : nullptr;
+        if (!decodeDst) {
+            decodeDst = scratch.get();
+        }
+        if (jpeg_read_scanlines(dinfo, &decodeDst, 1) != 1) {
+            return false;
+        }
+        if (row >= 0) {
+            onRow(row, decodeDst);
+        }
+    }
+    // The remaining rows only provide context; the decoder manager aborts the decompress.
+    return true;
+}
+
+// Restart intervals this many at a time are handed to each task. Each strip also decodes one
+// extra interval above and below for upsampling context, so shorter strips waste more work.
+static constexpr int kMinRestartIntervalsPerStrip = 4;
+static constexpr int kMaxRestartStrips = 32;
+
+bool SkJpegCodec::decodeRestartIntervalsInParallel(const SkImageInfo& dstInfo,
+                                                   void* dst,
+                                                   size_t rowBytes,
+                                                   const Options& options) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    if (!options.fExecutor || options.fSubset || dinfo->progressive_mode ||
+        dinfo->restart_interval == 0 || dinfo->comps_in_scan != dinfo->num_components ||
+        dinfo->scale_num != dinfo->scale_denom || dstInfo.dimensions() != this->dimensions()) {
+        return false;
+    }
+
+    SkStream* stream = this->stream();
+    const uint8_t* data = static_cast<const uint8_t*>(stream->getMemoryBase());
+    if (!data || !stream->hasLength()) {
+        return false;
+    }
+    RestartIntervalLayout layout;
+    if (!find_restart_intervals(data, stream->getLength(), &layout)) {
+        return false;
+    }
+
+    // Strips must be whole MCU rows, so each restart interval must be too.
+    const int width = dstInfo.width();
+    const int height = dstInfo.height();
+    int mcuWidth = DCTSIZE * dinfo->max_h_samp_factor;
+    int mcuHeight = DCTSIZE * dinfo->max_v_samp_factor;
+    if (dinfo->comps_in_scan == 1) {
+        mcuWidth /= dinfo->comp_info[0].h_samp_factor;
+        mcuHeight /= dinfo->comp_info[0].v_samp_factor;
+    }
+    const int mcusPerRow = (width + mcuWidth - 1) / mcuWidth;
+    const int mcuRows = (height + mcuHeight - 1) / mcuHeight;
+    if (dinfo->restart_interval % mcusPerRow != 0) {
+        return false;
+    }
+    const int rowsPerInterval = dinfo->restart_interval / mcusPerRow * mcuHeight;
+    const int intervalCount = (mcuRows * mcusPerRow + dinfo->restart_interval - 1) /
+                              dinfo->restart_interval;
+    if (SkToInt(layout.fRestartMarkers.size()) != intervalCount - 1) {
+        return false;
+    }
+    const int stripCount = std::min(kMaxRestartStrips,
+                                    intervalCount / kMinRestartIntervalsPerStrip);
+    if (stripCount < 2) {
+        return false;
+    }
+
+    // Each concurrent libjpeg-turbo decompressor needs roughly what the serial decode does.
+    if (!this->allocateFromBudget(stripCount * 34 * SkToSizeT(width))) {
+        return false;
+    }
+    if (needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
+                                            this->getEncodedInfo().colorProfile(),
+                                            this->colorXform())) {
+        this->initializeSwizzler(dstInfo, options, true);
+    }
+    const bool convertRows = fSwizzler || this->colorXform();
+    const int swizzleWidth = fSwizzler ? fSwizzler->swizzleWidth() : width;
+
+    std::atomic<bool> succeeded{true};
+    SkTaskGroup strips(*options.fExecutor);
+    strips.batch(stripCount, [&](int i) {
+        const int first = intervalCount *  i      / stripCount;
+        const int last  = intervalCount * (i + 1) / stripCount;
+        const int decodeFirst = std::max(first - 1, 0);
+        const int decodeLast  = std::min(last + 1, intervalCount);
+
+        // Build a JPEG holding intervals [decodeFirst, decodeLast): the original headers with
+        // the frame height reduced, then that part of the scan with its restart markers
+        // renumbered to start from RST0, then EOI.
+        const size_t headerSize = layout.fScanDataOffset;
+        const size_t scanBegin = decodeFirst == 0
+                ? layout.fScanDataOffset
+                : layout.fRestartMarkers[decodeFirst - 1] + kJpegMarkerCodeSize;
+        const size_t scanEnd = decodeLast == intervalCount
+                ? layout.fScanDataEnd
+                : layout.fRestartMarkers[decodeLast - 1];
+        const int stripHeight = std::min(height, decodeLast * rowsPerInterval) -
+                                decodeFirst * rowsPerInterval;
+
+        sk_sp<SkData> strip = SkData::MakeUninitialized(headerSize + (scanEnd - scanBegin) +
+                                                        kJpegMarkerCodeSize);
+        uint8_t* bytes = static_cast<uint8_t*>(strip->writable_data());
+        memcpy(bytes, data, headerSize);
+        bytes[layout.fFrameHeightOffset]     = SkToU8(stripHeight >> 8);
+        bytes[layout.fFrameHeightOffset + 1] = SkToU8(stripHeight);
+        memcpy(bytes + headerSize, data + scanBegin, scanEnd - scanBegin);
+        for (int interval = decodeFirst; interval < decodeLast - 1; ++interval) {
+            bytes[headerSize + layout.fRestartMarkers[interval] - scanBegin + 1] =
+                    SkToU8(0xD0 + (interval - decodeFirst) % 8);
+        }
+        bytes[strip->size() - 2] = 0xFF;
+        bytes[strip->size() - 1] = kJpegMarkerEndOfImage;
+
+        const int firstRow = first * rowsPerInterval;
+        const int rowCount = std::min(height, last * rowsPerInterval) - firstRow;
+        AutoTMalloc<uint32_t> xformRow(fSwizzler && this->colorXform() ? swizzleWidth : 0);
+        auto rowDst = [&](int row) -> JSAMPLE* {
+            return convertRows ? nullptr
+                               : SkTAddOffset<JSAMPLE>(dst, (firstRow + row) * rowBytes);
+        };
+        auto onRow = [&](int row, const JSAMPLE* decoded) {
+            if (!convertRows) {
+                return;
+            }
+            void* dstRow = SkTAddOffset<void>(dst, (firstRow + row) * rowBytes);
+            const void* src = decoded;
+            if (fSwizzler) {
+                void* swizzleDst = this->colorXform() ? xformRow.get() : dstRow;
+                fSwizzler->swizzle(swizzleDst, decoded);
+                src = swizzleDst;
+            }
+            if (this->colorXform()) {
+                this->applyColorXform(dstRow, src, swizzleWidth);
+            }
+        };
+        if (!decode_restart_strip(std::move(strip), *dinfo,
+                                  (first - decodeFirst) * rowsPerInterval, rowCount,
+                                  rowDst, onRow)) {
+            succeeded = false;
+        }
+    });
+    strips.wait();
+    return succeeded;
+}
+
 /*
  * Performs the jpeg decode
  */
@@ -500,6 +732,10 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
         return kUnimplemented;
     }
 
+    if (this->decodeRestartIntervalsInParallel(dstInfo, dst, dstRowBytes, options)) {
+        return kSuccess;
+    }
+
     // Get a pointer to the decompress info since we will use it quite frequently
     jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
 
@@ -589,6 +825,150 @@ SkCodec::Result SkJpegCodec::onGetPixels(const SkImageInfo& dstInfo,
     return kSuccess;
 }
 
+bool SkJpegCodec::onSupportsIncrementalDecode(const SkImageInfo&, const Options& options) {
+    // Without previews, decoding incrementally only costs the memory of buffered image mode.
+    return fDecoderMgr->dinfo()->progressive_mode && options.fProgressivePreviews &&
+           !options.fSubset;
+}
+
+SkCodec::Result SkJpegCodec::onStartIncrementalDecode(const SkImageInfo& dstInfo,
+                                                      void* dst,
+                                                      size_t rowBytes,
+                                                      const Options& options) {
+    // Checked by onSupportsIncrementalDecode().
+    SkASSERT(options.fProgressivePreviews && !options.fSubset);
+
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return fDecoderMgr->returnFailure("setjmp", kInvalidInput);
+    }
+
+    // In buffered image mode this only sets up the decompressor; scans are read as they arrive.
+    fDecoderMgr->beginSuspendingInput();
+    dinfo->buffered_image = TRUE;
+    jpeg_start_decompress(dinfo);
+
+    if (needs_swizzler_to_convert_from_cmyk(dinfo->out_color_space,
+                                            this->getEncodedInfo().colorProfile(),
+                                            this->colorXform())) {
+        this->initializeSwizzler(dstInfo, options, true);
+    }
+    if (!this->allocateStorage(dstInfo)) {
+        return kOutOfMemory;
+    }
+    // See the progressive case in onGetPixels().
+    if (!this->allocateFromBudget(6 * this->dimensions().area())) {
+        return kOutOfMemory;
+    }
+
+    fIncrementalDst = dst;
+    fIncrementalRowBytes = rowBytes;
+    fScansCompleted = 0;
+    fScansWritten = 0;
+    fFinishingOutput = false;
+    return kSuccess;
+}
+
+SkCodec::Result SkJpegCodec::onIncrementalDecode(int* rowsDecoded) {
+    jpeg_decompress_struct* dinfo = fDecoderMgr->dinfo();
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fDecoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return fDecoderMgr->returnFailure("setjmp", kErrorInInput);
+    }
+
+    const SkImageInfo& dstInfo = this->dstInfo();
+    // SkSampledCodec samples rows by calling setSampleY() on the sampler after starting the
+    // decode, so only every sampleY'th row goes to dst.
+    const int sampleY = fSwizzler ? fSwizzler->sampleY() : 1;
+    const int rowsNeeded = SkCodecPriv::GetSampledDimension(dstInfo.height(), sampleY);
+    auto incomplete = [&]() {
+        if (rowsDecoded) {
+            *rowsDecoded = fScansWritten > 0 ? rowsNeeded : 0;
+        }
+        return kIncompleteInput;
+    };
+
+    fDecoderMgr->readAvailableData();
+    if (fFinishingOutput) {
+        if (!jpeg_finish_output(dinfo)) {
+            return incomplete();
+        }
+        fFinishingOutput = false;
+    }
+
+    while (!jpeg_input_complete(dinfo)) {
+        // Call the progress monitor hook if present, to prevent decoder from hanging.
+        if (dinfo->progress) {
+            dinfo->progress->progress_monitor((j_common_ptr)dinfo);
+        }
+        const int res = jpeg_consume_input(dinfo);
+        if (res == JPEG_SUSPENDED) {
+            break;
+        }
+        if (res == JPEG_SCAN_COMPLETED) {
+            fScansCompleted = dinfo->input_scan_number;
+        }
+    }
+
+    const bool inputComplete = jpeg_input_complete(dinfo);
+    if (!inputComplete && (!this->options().fProgressivePreviews ||
+                           fScansCompleted == fScansWritten)) {
+        return incomplete();
+    }
+
+    // Once input is complete, the final output pass should use the last scan.
+    const int scan = inputComplete ? dinfo->input_scan_number : fScansCompleted;
+    jpeg_start_output(dinfo, scan);
+    int rows = 0;
+    if (sampleY == 1) {
+        const Result readResult = this->readRows(dstInfo, fIncrementalDst, fIncrementalRowBytes,
+                                                 dstInfo.height(), this->options(), &rows);
+        if (readResult != kSuccess) {
+            return fDecoderMgr->returnFailure("readRows", readResult);
+        }
+    } else {
+        // An output pass must read every row. Rows dst does not need are read into the
+        // swizzler's source row and dropped.
+        void* dstRow = fIncrementalDst;
+        for (int y = 0; y < dstInfo.height() && rows < rowsNeeded; ++y) {
+            if (!fSwizzler->rowNeeded(y)) {
+                JSAMPLE* skipRow = reinterpret_cast<JSAMPLE*>(fSwizzleSrcRow);
+                if (jpeg_read_scanlines(dinfo, &skipRow, 1) != 1) {
+                    break;
+                }
+                continue;
+            }
+            int rowRead = 0;
+            const Result readResult = this->readRows(dstInfo, dstRow, fIncrementalRowBytes, 1,
+                                                     this->options(), &rowRead);
+            if (readResult != kSuccess) {
+                return fDecoderMgr->returnFailure("readRows", readResult);
+            }
+            if (rowRead == 0) {
+                break;
+            }
+            dstRow = SkTAddOffset<void>(dstRow, fIncrementalRowBytes);
+            rows++;
+        }
+        // jpeg_finish_output() skips the rows below the last one dst needs.
+    }
+    if (rows < rowsNeeded) {
+        // The scan was complete, so libjpeg must have hit an error.
+        if (rowsDecoded) {
+            *rowsDecoded = rows;
+        }
+        return fDecoderMgr->returnFailure("readRows", kErrorInInput);
+    }
+    fScansWritten = scan;
+    // This reads ahead to the next scan's header, so it may suspend.
+    if (!jpeg_finish_output(dinfo)) {
+        fFinishingOutput = true;
+        return incomplete();
+    }
+    return inputComplete ? kSuccess : incomplete();
+}
+
 bool SkJpegCodec::allocateStorage(const SkImageInfo& dstInfo) {
     int dstWidth = dstInfo.width();
 
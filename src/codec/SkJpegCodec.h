@@ -70,6 +70,17 @@ protected:
 
     bool onRewind() override;
 
+    /*
+     * Incremental decoding, supported for whole progressive images when fProgressivePreviews is
+     * set. Each call consumes whatever data has arrived and, when another scan completes, writes
+     * the image as of the latest complete scan to dst. Other decodes return kUnimplemented, so
+     * SkAndroidCodec falls back to scanline decoding for them.
+     */
+    bool onSupportsIncrementalDecode(const SkImageInfo&, const Options&) override;
+    Result onStartIncrementalDecode(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                    const Options&) override;
+    Result onIncrementalDecode(int* rowsDecoded) override;
+
     bool onDimensionsSupported(const SkISize&) override;
 
     bool conversionSupported(const SkImageInfo&, bool, bool) override;
@@ -107,6 +118,15 @@ private:
     Result readRows(const SkImageInfo& dstInfo, void* dst, size_t rowBytes, int count,
                   const Options&, int* rowsDecoded);
 
+    /*
+     * Decodes a baseline image whose restart intervals cover whole MCU rows by splitting its
+     * scan at the restart markers and decoding the strips concurrently on options.fExecutor.
+     * Returns false, leaving fDecoderMgr untouched, if the image or options do not allow this
+     * or any strip fails; the caller then decodes serially.
+     */
+    bool decodeRestartIntervalsInParallel(const SkImageInfo& dstInfo, void* dst, size_t rowBytes,
+                                          const Options&);
+
     /*
      * Scanline decoding.
      */
@@ -133,6 +153,14 @@ private:
 
     std::unique_ptr<SkSwizzler> fSwizzler;
 
+    // State of an incremental decode. fScansWritten is the last scan written to the dst, and
+    // fFinishingOutput is set if libjpeg suspended while finishing that output pass.
+    void*  fIncrementalDst = nullptr;
+    size_t fIncrementalRowBytes = 0;
+    int    fScansCompleted = 0;
+    int    fScansWritten = 0;
+    bool   fFinishingOutput = false;
+
     friend class SkRawCodec;
 };
 
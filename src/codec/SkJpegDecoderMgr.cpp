@@ -6,6 +6,7 @@
  */
 #include "src/codec/SkJpegDecoderMgr.h"
 
+#include "include/core/SkStream.h"
 #include "include/core/SkTypes.h"
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkJpegSourceMgr.h"
@@ -17,6 +18,7 @@
 
 #include <jpeglib.h>
 #include <cstddef>
+#include <cstring>
 #include <utility>
 
 class SkStream;
@@ -93,7 +95,7 @@ SkJpegSourceMgr* JpegDecoderMgr::getSourceMgr() {
 }
 
 JpegDecoderMgr::JpegDecoderMgr(SkStream* stream)
-        : fSrcMgr(SkJpegSourceMgr::Make(stream)), fInit(false) {
+        : fStream(stream), fSrcMgr(SkJpegSourceMgr::Make(stream)), fInit(false) {
     // An error manager must be set before any calls to libjpeg, in order to handle failures.
     fDInfo.err = jpeg_std_error(&fErrorMgr);
     fErrorMgr.error_exit = skjpeg_err_exit;
@@ -114,6 +116,57 @@ JpegDecoderMgr::~JpegDecoderMgr() {
     }
 }
 
+void JpegDecoderMgr::beginSuspendingInput() {
+    if (fSrcMgr.fSuspending) {
+        return;
+    }
+    fSrcMgr.fSuspending = true;
+    if (!fSrcMgr.fSourceMgr->readsIncrementally()) {
+        // All of the data is already in memory, and libjpeg can keep reading from it directly.
+        return;
+    }
+    // Take over the bytes the source has buffered. The stream continues after them.
+    fSrcMgr.fSuspendedInput.assign(fSrcMgr.next_input_byte,
+                                   fSrcMgr.next_input_byte + fSrcMgr.bytes_in_buffer);
+    fSrcMgr.next_input_byte = fSrcMgr.fSuspendedInput.data();
+}
+
+bool JpegDecoderMgr::readAvailableData() {
+    SkASSERT(fSrcMgr.fSuspending);
+    if (!fSrcMgr.fSourceMgr->readsIncrementally()) {
+        return false;
+    }
+    while (fSrcMgr.fPendingSkip > 0) {
+        const size_t skipped = fStream->skip(fSrcMgr.fPendingSkip);
+        if (skipped == 0) {
+            return false;
+        }
+        fSrcMgr.fPendingSkip -= skipped;
+    }
+
+    // libjpeg backs up to the start of whatever it could not finish when it suspends, so keep
+    // everything from next_input_byte on and append the new data after it.
+    std::vector<uint8_t>& input = fSrcMgr.fSuspendedInput;
+    size_t size = fSrcMgr.bytes_in_buffer;
+    if (size > 0) {
+        memmove(input.data(), fSrcMgr.next_input_byte, size);
+    }
+    const size_t oldSize = size;
+    constexpr size_t kReadSize = 4096;
+    while (true) {
+        input.resize(size + kReadSize);
+        const size_t bytesRead = fStream->read(input.data() + size, kReadSize);
+        if (bytesRead == 0) {
+            break;
+        }
+        size += bytesRead;
+    }
+    input.resize(size);
+    fSrcMgr.next_input_byte = input.data();
+    fSrcMgr.bytes_in_buffer = size;
+    return size > oldSize;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // JpegDecoderMgr::SourceMgr
 
@@ -127,6 +180,13 @@ void JpegDecoderMgr::SourceMgr::InitSource(j_decompress_ptr dinfo) {
 void JpegDecoderMgr::SourceMgr::SkipInputData(j_decompress_ptr dinfo, long num_bytes_long) {
     JpegDecoderMgr::SourceMgr* src = (JpegDecoderMgr::SourceMgr*)dinfo->src;
     size_t num_bytes = static_cast<size_t>(num_bytes_long);
+    if (src->fSuspending && num_bytes > src->bytes_in_buffer) {
+        // Skip the rest once the stream has it.
+        src->fPendingSkip += num_bytes - src->bytes_in_buffer;
+        src->next_input_byte += src->bytes_in_buffer;
+        src->bytes_in_buffer = 0;
+        return;
+    }
     if (!src->fSourceMgr->skipInputBytes(num_bytes, src->next_input_byte, src->bytes_in_buffer)) {
         SkCodecPrintf("Failure to skip.\n");
         src->next_input_byte = nullptr;
@@ -138,6 +198,10 @@ void JpegDecoderMgr::SourceMgr::SkipInputData(j_decompress_ptr dinfo, long num_b
 // static
 boolean JpegDecoderMgr::SourceMgr::FillInputBuffer(j_decompress_ptr dinfo) {
     JpegDecoderMgr::SourceMgr* src = (JpegDecoderMgr::SourceMgr*)dinfo->src;
+    if (src->fSuspending) {
+        // libjpeg backs up and suspends. The input it has not consumed must be left in place.
+        return false;
+    }
     if (!src->fSourceMgr->fillInputBuffer(src->next_input_byte, src->bytes_in_buffer)) {
         SkCodecPrintf("Failure to fill input buffer.\n");
         src->next_input_byte = nullptr;
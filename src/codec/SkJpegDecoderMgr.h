@@ -18,7 +18,9 @@ extern "C" {
     #include "jpeglib.h"  // NO_G3_REWRITE
 }
 
+#include <cstdint>
 #include <memory>
+#include <vector>
 
 class SkStream;
 
@@ -71,6 +73,19 @@ public:
     // Get the source manager.
     SkJpegSourceMgr* getSourceMgr();
 
+    /*
+     * Switch the source to suspending input, for decodes that resume as more data arrives. Once
+     * libjpeg has used up the data read so far, it returns JPEG_SUSPENDED rather than waiting on
+     * the stream, and picks up where it left off after readAvailableData().
+     */
+    void beginSuspendingInput();
+
+    /*
+     * Append whatever the stream has received since the last call to the suspending input.
+     * Returns true if there was any.
+     */
+    bool readAvailableData();
+
 private:
     // Wrapper that calls into the full SkJpegSourceMgr interface.
     struct SourceMgr : jpeg_source_mgr {
@@ -81,8 +96,16 @@ private:
 
         explicit SourceMgr(std::unique_ptr<SkJpegSourceMgr> mgr);
         std::unique_ptr<SkJpegSourceMgr> fSourceMgr;
+
+        // Used once suspending. Holds the input libjpeg has not consumed yet. fPendingSkip
+        // counts bytes libjpeg asked to skip that the stream has not received yet.
+        bool                 fSuspending = false;
+        std::vector<uint8_t> fSuspendedInput;
+        size_t               fPendingSkip = 0;
     };
 
+    SkStream* const        fStream;
+
     jpeg_decompress_struct fDInfo;
     SourceMgr              fSrcMgr;
     skjpeg_error_mgr       fErrorMgr;
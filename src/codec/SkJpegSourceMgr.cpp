@@ -74,6 +74,7 @@ public:
         bytesInBuffer -= bytesToSkip;
         return true;
     }
+    bool readsIncrementally() const override { return false; }
 #ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
     const std::vector<SkJpegSegment>& getAllSegments() override {
         if (fScanner) {
@@ -90,6 +91,10 @@ public:
         if (wasCopied) {
             *wasCopied = false;
         }
+        // Share the stream's data when it has one, so the subset can outlive the stream.
+        if (sk_sp<const SkData> data = fStream->getData()) {
+            return SkData::MakeSubset(data.get(), offset, size);
+        }
         return SkData::MakeWithoutCopy(
                 reinterpret_cast<const uint8_t*>(fStream->getMemoryBase()) + offset, size);
     }
@@ -48,6 +48,11 @@ public:
                                 const uint8_t*& nextInputByte,
                                 size_t& bytesInBuffer) = 0;
 
+    // Returns true if the source reads from the stream only as libjpeg asks for more data, so that
+    // the stream is positioned after the last byte handed to libjpeg. Sources that hand libjpeg all
+    // of the data up front return false.
+    virtual bool readsIncrementally() const { return true; }
+
 #ifdef SK_CODEC_DECODES_JPEG_GAINMAPS
     // Parse this stream all the way through its EndOfImage marker and return the list of segments.
     // Return false if there is an error or if no EndOfImage marker is found.
@@ -26,6 +26,7 @@
 #include "src/codec/SkCodecPriv.h"
 #include "src/codec/SkPngCompositeChunkReader.h"
 #include "src/codec/SkPngPriv.h"
+#include "src/codec/SkPngRowIndex.h"
 #include "src/codec/SkSwizzler.h"
 #include "src/core/SkSafeMath.h"
 
@@ -147,18 +148,34 @@ static inline bool is_chunk(const png_byte* chunk, const char* tag) {
     return memcmp(chunk + 4, tag, 4) == 0;
 }
 
-static inline bool process_data(png_structp png_ptr, png_infop info_ptr,
-        SkStream* stream, void* buffer, size_t bufferSize, size_t length) {
-    while (length > 0) {
-        const size_t bytesToProcess = std::min(bufferSize, length);
+// Hands the next *length bytes of the stream to libpng, or as many as it has, and subtracts what
+// it hands over from *length. libpng may longjmp out of png_process_data(), for instance once the
+// rows we want are decoded, so *length is updated before each call. Streams in memory, such as
+// memory mapped files, are handed over in place rather than being copied through buffer first.
+static void process_data(png_structp png_ptr, png_infop info_ptr,
+        SkStream* stream, void* buffer, size_t bufferSize, size_t* length) {
+    const uint8_t* base = static_cast<const uint8_t*>(stream->getMemoryBase());
+    if (base && stream->hasPosition() && stream->hasLength()) {
+        const size_t position = stream->getPosition();
+        const size_t bytes = std::min(*length, stream->getLength() - position);
+        if (stream->skip(bytes) != bytes) {
+            return;
+        }
+        *length -= bytes;
+        // libpng only reads from the buffer.
+        png_process_data(png_ptr, info_ptr, const_cast<png_bytep>(base + position), bytes);
+        return;
+    }
+
+    while (*length > 0) {
+        const size_t bytesToProcess = std::min(bufferSize, *length);
         const size_t bytesRead = stream->read(buffer, bytesToProcess);
+        *length -= bytesRead;
         png_process_data(png_ptr, info_ptr, (png_bytep) buffer, bytesRead);
         if (bytesRead < bytesToProcess) {
-            return false;
+            break;
         }
-        length -= bytesToProcess;
     }
-    return true;
 }
 
 bool AutoCleanPng::decodeBounds() {
@@ -201,7 +218,9 @@ bool AutoCleanPng::decodeBounds() {
 
         png_process_data(fPng_ptr, fInfo_ptr, chunk, 8);
         // Process the full chunk + CRC.
-        if (!process_data(fPng_ptr, fInfo_ptr, fStream, buffer, kBufferSize, length + 4)) {
+        size_t bytesRemaining = length + 4;
+        process_data(fPng_ptr, fInfo_ptr, fStream, buffer, kBufferSize, &bytesRemaining);
+        if (bytesRemaining > 0) {
             return false;
         }
     }
@@ -230,33 +249,36 @@ bool SkPngCodec::processData() {
     constexpr size_t kBufferSize = 4096;
     char buffer[kBufferSize];
 
-    bool iend = false;
     while (true) {
-        size_t length;
-        if (fDecodedIdat) {
-            // Parse chunk length and type.
-            if (this->stream()->read(buffer, 8) < 8) {
-                break;
-            }
-
-            png_byte* chunk = reinterpret_cast<png_byte*>(buffer);
-            png_process_data(fPng_ptr, fInfo_ptr, chunk, 8);
-            if (is_chunk(chunk, "IEND")) {
-                iend = true;
+        if (fChunkBytesRemaining == 0) {
+            if (fDecodedIdat) {
+                // Parse chunk length and type. If the stream runs out partway through, keep
+                // what was read for the next call.
+                fChunkHeaderBytes += this->stream()->read(fChunkHeader + fChunkHeaderBytes,
+                                                          8 - fChunkHeaderBytes);
+                if (fChunkHeaderBytes < 8) {
+                    break;
+                }
+                fChunkHeaderBytes = 0;
+                png_process_data(fPng_ptr, fInfo_ptr, fChunkHeader, 8);
+            } else {
+                png_save_uint_32(fChunkHeader, fIdatLength);
+                memcpy(fChunkHeader + 4, "IDAT", 4);
+                png_process_data(fPng_ptr, fInfo_ptr, fChunkHeader, 8);
+                fDecodedIdat = true;
             }
-
-            length = png_get_uint_32(chunk);
-        } else {
-            length = fIdatLength;
-            png_byte idat[] = {0, 0, 0, 0, 'I', 'D', 'A', 'T'};
-            png_save_uint_32(idat, length);
-            png_process_data(fPng_ptr, fInfo_ptr, idat, 8);
-            fDecodedIdat = true;
+            // The chunk's data and CRC.
+            fChunkBytesRemaining = png_get_uint_32(fChunkHeader) + 4;
         }
 
-        // Process the full chunk + CRC.
-        if (!process_data(fPng_ptr, fInfo_ptr, this->stream(), buffer, kBufferSize, length + 4)
-                || iend) {
+        // Process the rest of the chunk + CRC.
+        process_data(fPng_ptr, fInfo_ptr, this->stream(), buffer, kBufferSize,
+                     &fChunkBytesRemaining);
+        if (fChunkBytesRemaining > 0) {
+            // The stream ran out partway through the chunk.
+            break;
+        }
+        if (is_chunk(fChunkHeader, "IEND")) {
             break;
         }
     }
@@ -407,6 +429,7 @@ public:
                          gainmapInfo)
             , fRowsWrittenToOutput(0)
             , fDst(nullptr)
+            , fDstStart(nullptr)
             , fRowBytes(0)
             , fFirstRow(0)
             , fLastRow(0) {}
@@ -422,6 +445,7 @@ public:
 private:
     int                         fRowsWrittenToOutput;
     void*                       fDst;
+    void*                       fDstStart;
     size_t                      fRowBytes;
 
     // Variables for partial decode
@@ -467,6 +491,7 @@ private:
         fFirstRow = firstRow;
         fLastRow = lastRow;
         fDst = dst;
+        fDstStart = dst;
         fRowBytes = rowBytes;
         fRowsWrittenToOutput = 0;
         fRowsNeeded = fLastRow - fFirstRow + 1;
@@ -479,6 +504,10 @@ private:
             fRowsNeeded = SkCodecPriv::GetSampledDimension(fLastRow - fFirstRow + 1, sampleY);
         }
 
+        if (fFirstRow > 0 && this->rowIndex()) {
+            return this->decodeFromIndex(rowsDecoded);
+        }
+
         const bool success = this->processData();
         if (success && fRowsWrittenToOutput == fRowsNeeded) {
             return kSuccess;
@@ -491,13 +520,28 @@ private:
         return log_and_return_error(success);
     }
 
-    void rowCallback(png_bytep row, int rowNum) {
-        if (rowNum < fFirstRow) {
-            // Ignore this row.
-            return;
+    Result decodeFromIndex(int* rowsDecoded) {
+        // The index does not keep any state between calls, so a call after kIncompleteInput
+        // starts over and rewrites the rows it already wrote.
+        fDst = fDstStart;
+        fRowsWrittenToOutput = 0;
+        const Result result = this->rowIndex()->decodeRows(
+                this->stream(), fFirstRow, fLastRow,
+                [this](const uint8_t* row, int rowNum) { return !this->writeRow(row, rowNum); });
+        if (result == kSuccess && fRowsWrittenToOutput == fRowsNeeded) {
+            return kSuccess;
         }
 
-        SkASSERT(rowNum <= fLastRow);
+        if (rowsDecoded) {
+            *rowsDecoded = fRowsWrittenToOutput;
+        }
+
+        return result == kIncompleteInput ? kIncompleteInput : log_and_return_error(false);
+    }
+
+    // Returns true once all of the rows needed have been written.
+    bool writeRow(const uint8_t* row, int rowNum) {
+        SkASSERT(rowNum >= fFirstRow && rowNum <= fLastRow);
         SkASSERT(fRowsWrittenToOutput < fRowsNeeded);
 
         // If there is no swizzler, all rows are needed.
@@ -507,7 +551,16 @@ private:
             fRowsWrittenToOutput++;
         }
 
-        if (fRowsWrittenToOutput == fRowsNeeded) {
+        return fRowsWrittenToOutput == fRowsNeeded;
+    }
+
+    void rowCallback(png_bytep row, int rowNum) {
+        if (rowNum < fFirstRow) {
+            // Ignore this row.
+            return;
+        }
+
+        if (this->writeRow(row, rowNum)) {
             // Fake error to stop decoding scanlines.
             longjmp(PNG_JMPBUF(this->png_ptr()), kStopDecoding);
         }
@@ -536,6 +589,8 @@ public:
             , fLastRow(0)
             , fLinesDecoded(0)
             , fInterlacedComplete(false)
+            , fPassesCompleted(0)
+            , fPassesWritten(0)
             , fPng_rowbytes(0) {}
 
     static void InterlacedRowCallback(png_structp png_ptr, png_bytep row, png_uint_32 rowNum, int pass) {
@@ -551,6 +606,10 @@ private:
     size_t                  fRowBytes;
     int                     fLinesDecoded;
     bool                    fInterlacedComplete;
+    // Adam7 passes that have reached fLastRow, and how many of them have been written to fDst
+    // as a preview.
+    int                     fPassesCompleted;
+    int                     fPassesWritten;
     size_t                  fPng_rowbytes;
     std::unique_ptr<png_byte, SkOverloadedFunctionObject<void(void*), sk_free>> fInterlaceBuffer;
 
@@ -565,6 +624,9 @@ private:
 
         png_bytep oldRow = fInterlaceBuffer.get() + (rowNum - fFirstRow) * fPng_rowbytes;
         png_progressive_combine_row(this->png_ptr(), oldRow, row);
+        if (rowNum == fLastRow) {
+            fPassesCompleted = pass + 1;
+        }
 
         if (0 == pass) {
             // The first pass initializes all rows.
@@ -632,6 +694,8 @@ private:
         fDst = dst;
         fRowBytes = rowBytes;
         fLinesDecoded = 0;
+        fPassesCompleted = 0;
+        fPassesWritten = 0;
         return kSuccess;
     }
 
@@ -649,6 +713,20 @@ private:
         const int sampleY = this->swizzler() ? this->swizzler()->sampleY() : 1;
         const int rowsNeeded = SkCodecPriv::GetSampledDimension(fLastRow - fFirstRow + 1, sampleY);
 
+        if (this->options().fProgressivePreviews && !(success && fInterlacedComplete)) {
+            // libpng fills in each pass by repeating its pixels over the rows and columns the
+            // later passes will cover, so once the first pass is in, the buffer holds a blocky
+            // preview of the whole range. Only write it when another pass is done, rather than
+            // converting the rows again on every call.
+            if (fPassesCompleted == fPassesWritten) {
+                if (rowsDecoded) {
+                    *rowsDecoded = fPassesWritten > 0 ? rowsNeeded : 0;
+                }
+                return log_and_return_error(success);
+            }
+            fPassesWritten = fPassesCompleted;
+        }
+
         // FIXME: For resuming interlace, we may swizzle a row that hasn't changed. But it
         // may be too tricky/expensive to handle that correctly.
 
@@ -778,12 +856,16 @@ void AutoCleanPng::infoCallback(size_t idatLength) {
     png_get_IHDR(fPng_ptr, fInfo_ptr, &origWidth, &origHeight, &bitDepth,
                  &encodedColorType, nullptr, nullptr, nullptr);
 
+    // Whether libpng's output rows differ from the unfiltered image data.
+    bool transformsRows = false;
+
     // TODO(https://crbug.com/359245096): Should we support 16-bits of precision
     // for gray images?
     if (bitDepth == 16 && (PNG_COLOR_TYPE_GRAY == encodedColorType ||
                            PNG_COLOR_TYPE_GRAY_ALPHA == encodedColorType)) {
         bitDepth = 8;
         png_set_strip_16(fPng_ptr);
+        transformsRows = true;
     }
 
     // Now determine the default colorType and alphaType and set the required transforms.
@@ -799,6 +881,7 @@ void AutoCleanPng::infoCallback(size_t idatLength) {
                 // TODO: Should we use SkSwizzler here?
                 bitDepth = 8;
                 png_set_packing(fPng_ptr);
+                transformsRows = true;
             }
 
             color = SkEncodedInfo::kPalette_Color;
@@ -810,6 +893,7 @@ void AutoCleanPng::infoCallback(size_t idatLength) {
             if (png_get_valid(fPng_ptr, fInfo_ptr, PNG_INFO_tRNS)) {
                 // Convert to RGBA if transparency chunk exists.
                 png_set_tRNS_to_alpha(fPng_ptr);
+                transformsRows = true;
                 color = SkEncodedInfo::kRGBA_Color;
                 alpha = SkEncodedInfo::kBinary_Alpha;
             } else {
@@ -823,10 +907,12 @@ void AutoCleanPng::infoCallback(size_t idatLength) {
                 // TODO: Should we use SkSwizzler here?
                 bitDepth = 8;
                 png_set_expand_gray_1_2_4_to_8(fPng_ptr);
+                transformsRows = true;
             }
 
             if (png_get_valid(fPng_ptr, fInfo_ptr, PNG_INFO_tRNS)) {
                 png_set_tRNS_to_alpha(fPng_ptr);
+                transformsRows = true;
                 color = SkEncodedInfo::kGrayAlpha_Color;
                 alpha = SkEncodedInfo::kBinary_Alpha;
             } else {
@@ -914,6 +1000,17 @@ void AutoCleanPng::infoCallback(size_t idatLength) {
                                                     fChunkReader->getGainmapInfo());
         }
         static_cast<SkPngCodec*>(*fOutCodec)->setIdatLength(idatLength);
+
+        // The stream is positioned at the start of the image data. If it can seek back there,
+        // subset decodes can skip ahead using a row index instead of inflating every row above
+        // the subset.
+        if (1 == numberPasses && !transformsRows && fStream->hasPosition()) {
+            const int bytesPerPixel = std::max(1, png_get_channels(fPng_ptr, fInfo_ptr) *
+                                                  bitDepth / 8);
+            static_cast<SkPngCodec*>(*fOutCodec)->setRowIndex(std::make_unique<SkPngRowIndex>(
+                    fStream->getPosition(), idatLength, origHeight,
+                    png_get_rowbytes(fPng_ptr, fInfo_ptr), bytesPerPixel));
+        }
     }
 
     // Release the pointers, which are now owned by the codec or the caller is expected to
@@ -941,12 +1038,18 @@ SkPngCodec::SkPngCodec(SkEncodedInfo&& encodedInfo,
         , fPng_ptr(png_ptr)
         , fInfo_ptr(info_ptr)
         , fIdatLength(0)
-        , fDecodedIdat(false) {}
+        , fDecodedIdat(false)
+        , fChunkHeaderBytes(0)
+        , fChunkBytesRemaining(0) {}
 
 SkPngCodec::~SkPngCodec() {
     this->destroyReadStruct();
 }
 
+void SkPngCodec::setRowIndex(std::unique_ptr<SkPngRowIndex> rowIndex) {
+    fRowIndex = std::move(rowIndex);
+}
+
 void SkPngCodec::destroyReadStruct() {
     if (fPng_ptr) {
         // We will never have a nullptr fInfo_ptr with a non-nullptr fPng_ptr
@@ -996,6 +1099,8 @@ bool SkPngCodec::onRewind() {
     fPng_ptr = png_ptr;
     fInfo_ptr = info_ptr;
     fDecodedIdat = false;
+    fChunkHeaderBytes = 0;
+    fChunkBytesRemaining = 0;
     return true;
 }
 
@@ -20,6 +20,7 @@
 
 class SkPngChunkReader;
 class SkPngCompositeChunkReader;
+class SkPngRowIndex;
 class SkStream;
 struct SkEncodedInfo;
 struct SkImageInfo;
@@ -33,6 +34,11 @@ public:
     // FIXME (scroggo): Temporarily needed by AutoCleanPng.
     void setIdatLength(size_t len) { fIdatLength = len; }
 
+    // Enables decoding subsets from an SkPngRowIndex. Only for images whose rows need no libpng
+    // transforms, and whose stream supports seeking.
+    void setRowIndex(std::unique_ptr<SkPngRowIndex>);
+    const SkPngRowIndex* rowIndexForTesting() const { return fRowIndex.get(); }
+
     ~SkPngCodec() override;
 
 protected:
@@ -64,6 +70,8 @@ protected:
     voidp png_ptr() { return fPng_ptr; }
     voidp info_ptr() { return fInfo_ptr; }
 
+    SkPngRowIndex* rowIndex() const { return fRowIndex.get(); }
+
     /**
      *  Pass available input to libpng to process it.
      *
@@ -72,7 +80,7 @@ protected:
      */
     bool processData();
 
-    bool onSupportsIncrementalDecode(const SkImageInfo&) override { return true; }
+    bool onSupportsIncrementalDecode(const SkImageInfo&, const Options&) override { return true; }
     Result onStartIncrementalDecode(const SkImageInfo& dstInfo, void* pixels, size_t rowBytes,
             const SkCodec::Options&) override;
     Result onIncrementalDecode(int*) override;
@@ -99,5 +107,11 @@ private:
 
     size_t                         fIdatLength;
     bool fDecodedIdat;
+    // The chunk being fed to libpng, so that processData() can resume partway through it when
+    // the stream runs out of data.
+    uint8_t                        fChunkHeader[8];
+    size_t                         fChunkHeaderBytes;
+    size_t                         fChunkBytesRemaining;
+    std::unique_ptr<SkPngRowIndex> fRowIndex;
 };
 #endif  // SkPngCodec_DEFINED
@@ -0,0 +1,290 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/codec/SkPngRowIndex.h"
+
+#include "include/core/SkStream.h"
+#include "include/core/SkTypes.h"
+#include "include/private/SkTemplates.h"
+#include "src/core/SkScopeExit.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+#include <zlib.h>
+
+namespace {
+// Deflate never refers back further than this.
+constexpr size_t kWindowSize = 32768;
+constexpr size_t kInputBufferSize = 16384;
+
+uint32_t read_be32(const uint8_t* p) {
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | p[3];
+}
+
+uint8_t paeth(int a, int b, int c) {
+    const int p = a + b - c;
+    const int pa = std::abs(p - a);
+    const int pb = std::abs(p - b);
+    const int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+// Reverses the filter of row, in place. Both rows start with their filter type byte; prev is all
+// zeros for the first row.
+bool unfilter_row(uint8_t* row, const uint8_t* prev, size_t rowBytes, size_t bpp) {
+    const uint8_t filter = row[0];
+    uint8_t* x = row + 1;
+    const uint8_t* b = prev + 1;
+    switch (filter) {
+        case 0:  // None
+            break;
+        case 1:  // Sub
+            for (size_t i = bpp; i < rowBytes; ++i) {
+                x[i] += x[i - bpp];
+            }
+            break;
+        case 2:  // Up
+            for (size_t i = 0; i < rowBytes; ++i) {
+                x[i] += b[i];
+            }
+            break;
+        case 3:  // Average
+            for (size_t i = 0; i < std::min(bpp, rowBytes); ++i) {
+                x[i] += b[i] >> 1;
+            }
+            for (size_t i = bpp; i < rowBytes; ++i) {
+                x[i] += (x[i - bpp] + b[i]) >> 1;
+            }
+            break;
+        case 4:  // Paeth
+            for (size_t i = 0; i < std::min(bpp, rowBytes); ++i) {
+                x[i] += b[i];
+            }
+            for (size_t i = bpp; i < rowBytes; ++i) {
+                x[i] += paeth(x[i - bpp], b[i], b[i - bpp]);
+            }
+            break;
+        default:
+            return false;
+    }
+    return true;
+}
+}  // namespace
+
+SkPngRowIndex::SkPngRowIndex(size_t idatOffset, size_t idatLength, int height, size_t rowBytes,
+                             int bytesPerPixel)
+        : fHeight(height)
+        , fRowBytes(rowBytes)
+        , fBytesPerPixel(bytesPerPixel)
+        , fCheckpointSpacing(kCheckpointRatio * (kWindowSize + 2 * (rowBytes + 1))) {
+    SkASSERT(idatLength <= UINT32_MAX);
+    fChunks.push_back({idatOffset, 0, static_cast<uint32_t>(idatLength)});
+}
+
+SkPngRowIndex::~SkPngRowIndex() = default;
+
+bool SkPngRowIndex::findNextChunk(SkStream* stream) {
+    if (fFoundLastChunk) {
+        return false;
+    }
+    const Chunk& last = fChunks.back();
+    // Skip the CRC of the last chunk.
+    const size_t headerOffset = last.fStreamOffset + last.fLength + 4;
+    uint8_t header[8];
+    if (!stream->seek(headerOffset) || stream->read(header, sizeof(header)) != sizeof(header)) {
+        return false;
+    }
+    if (memcmp(header + 4, "IDAT", 4) != 0) {
+        fFoundLastChunk = true;
+        return false;
+    }
+    fChunks.push_back({headerOffset + sizeof(header), last.fStart + last.fLength,
+                       read_be32(header)});
+    return true;
+}
+
+size_t SkPngRowIndex::readCompressed(SkStream* stream, size_t offset, uint8_t* dst, size_t size,
+                                     const uint8_t** data) {
+    while (offset >= fChunks.back().fStart + fChunks.back().fLength) {
+        if (!this->findNextChunk(stream)) {
+            return 0;
+        }
+    }
+    // Find the last chunk starting at or before offset. Zero length chunks are skipped, since the
+    // chunk that follows them has the same start.
+    auto chunk = std::upper_bound(fChunks.begin(), fChunks.end(), offset,
+                                  [](size_t o, const Chunk& c) { return o < c.fStart; }) - 1;
+    const size_t offsetInChunk = offset - chunk->fStart;
+    const size_t streamOffset = chunk->fStreamOffset + offsetInChunk;
+    const uint8_t* base = static_cast<const uint8_t*>(stream->getMemoryBase());
+    if (data && base && stream->hasLength()) {
+        if (streamOffset >= stream->getLength()) {
+            return 0;
+        }
+        *data = base + streamOffset;
+        return std::min<size_t>(chunk->fLength - offsetInChunk,
+                                stream->getLength() - streamOffset);
+    }
+
+    const size_t bytesToRead = std::min<size_t>(size, chunk->fLength - offsetInChunk);
+    if (!stream->seek(streamOffset)) {
+        return 0;
+    }
+    if (data) {
+        *data = dst;
+    }
+    return stream->read(dst, bytesToRead);
+}
+
+void SkPngRowIndex::addCheckpoint(size_t in, int bits, uint8_t byte, size_t out,
+                                  const uint8_t* window, size_t windowSize,
+                                  const uint8_t* prevRow, const uint8_t* currRow) {
+    const size_t stride = this->rowStride();
+    const size_t offsetInRow = out % stride;
+
+    Checkpoint checkpoint;
+    checkpoint.fIn = in;
+    checkpoint.fBits = bits;
+    checkpoint.fByte = byte;
+    checkpoint.fOut = out;
+    checkpoint.fWindowSize = windowSize;
+    checkpoint.fData.reset(new uint8_t[windowSize + stride + offsetInRow]);
+    uint8_t* data = checkpoint.fData.get();
+    memcpy(data, window, windowSize);
+    memcpy(data + windowSize, prevRow, stride);
+    memcpy(data + windowSize + stride, currRow, offsetInRow);
+    fCheckpoints.push_back(std::move(checkpoint));
+}
+
+SkCodec::Result SkPngRowIndex::decodeRows(SkStream* stream, int firstRow, int lastRow,
+                                          const RowProc& rowProc) {
+    SkASSERT(0 <= firstRow && firstRow <= lastRow && lastRow < fHeight);
+    const size_t stride = this->rowStride();
+
+    // Resume from the last checkpoint that is not past the start of firstRow.
+    auto next = std::upper_bound(fCheckpoints.begin(), fCheckpoints.end(), firstRow,
+                                 [stride](int row, const Checkpoint& c) {
+                                     return (size_t)row < c.fOut / stride;
+                                 });
+    const Checkpoint* start = next == fCheckpoints.begin() ? nullptr : &*(next - 1);
+
+    skia_private::AutoTMalloc<uint8_t> storage(2 * stride + kInputBufferSize + kWindowSize);
+    uint8_t* prevRow = storage.get();
+    uint8_t* currRow = prevRow + stride;
+    uint8_t* input = currRow + stride;
+    uint8_t* window = input + kInputBufferSize;
+
+    z_stream strm;
+    memset(&strm, 0, sizeof(strm));
+    // The zlib header is handled below, so that checkpoints can restart a raw inflate.
+    if (inflateInit2(&strm, -15) != Z_OK) {
+        return SkCodec::kErrorInInput;
+    }
+    SK_AT_SCOPE_EXIT(inflateEnd(&strm));
+
+    size_t in, out;
+    uint8_t lastByte = 0;
+    if (start) {
+        in = start->fIn;
+        out = start->fOut;
+        lastByte = start->fByte;
+        const uint8_t* data = start->fData.get();
+        if (start->fBits && inflatePrime(&strm, start->fBits, lastByte >> (8 - start->fBits))
+                != Z_OK) {
+            return SkCodec::kErrorInInput;
+        }
+        if (inflateSetDictionary(&strm, data, start->fWindowSize) != Z_OK) {
+            return SkCodec::kErrorInInput;
+        }
+        memcpy(prevRow, data + start->fWindowSize, stride);
+        memcpy(currRow, data + start->fWindowSize + stride, out % stride);
+    } else {
+        uint8_t header[2];
+        if (this->readCompressed(stream, 0, header, 1) != 1 ||
+            this->readCompressed(stream, 1, header + 1, 1) != 1) {
+            return SkCodec::kIncompleteInput;
+        }
+        // PNG requires deflate, and does not allow a preset dictionary.
+        if ((header[0] & 0x0F) != 8 || (header[1] & 0x20) ||
+            ((header[0] << 8) | header[1]) % 31 != 0) {
+            return SkCodec::kErrorInInput;
+        }
+        in = 2;
+        out = 0;
+        memset(prevRow, 0, stride);
+    }
+
+    int row = static_cast<int>(out / stride);
+    size_t offsetInRow = out % stride;
+    fLastStartRow = row;
+    while (true) {
+        if (strm.avail_in == 0) {
+            const uint8_t* data = nullptr;
+            const size_t bytesRead =
+                    this->readCompressed(stream, in, input, kInputBufferSize, &data);
+            if (bytesRead == 0) {
+                return SkCodec::kIncompleteInput;
+            }
+            // zlib does not write to its input.
+            strm.next_in = const_cast<uint8_t*>(data);
+            strm.avail_in = static_cast<uInt>(bytesRead);
+        }
+        strm.next_out = currRow + offsetInRow;
+        strm.avail_out = static_cast<uInt>(stride - offsetInRow);
+
+        const uInt availIn = strm.avail_in;
+        // Z_BLOCK also returns at the end of each deflate block, where a checkpoint can be taken.
+        const int ret = inflate(&strm, Z_BLOCK);
+        if (ret != Z_OK && ret != Z_STREAM_END && ret != Z_BUF_ERROR) {
+            return SkCodec::kErrorInInput;
+        }
+        if (strm.avail_in != availIn) {
+            in += availIn - strm.avail_in;
+            lastByte = strm.next_in[-1];
+        }
+        offsetInRow = stride - strm.avail_out;
+
+        if (offsetInRow == stride) {
+            if (!unfilter_row(currRow, prevRow, fRowBytes, fBytesPerPixel)) {
+                return SkCodec::kErrorInInput;
+            }
+            if (row >= firstRow && !rowProc(currRow + 1, row)) {
+                return SkCodec::kSuccess;
+            }
+            if (row == lastRow) {
+                return SkCodec::kSuccess;
+            }
+            std::swap(prevRow, currRow);
+            offsetInRow = 0;
+            row++;
+        }
+        out = row * stride + offsetInRow;
+
+        if (ret == Z_STREAM_END) {
+            // The image data ended before the last row.
+            return SkCodec::kErrorInInput;
+        }
+
+        // Bit 7 of data_type is set at the end of a block, and bit 6 if it was the last one.
+        const bool atBlockBoundary = (strm.data_type & 128) && !(strm.data_type & 64);
+        const size_t lastCheckpoint = fCheckpoints.empty() ? 0 : fCheckpoints.back().fOut;
+        if (atBlockBoundary && out >= lastCheckpoint + fCheckpointSpacing) {
+            uInt windowSize = kWindowSize;
+            if (inflateGetDictionary(&strm, window, &windowSize) != Z_OK) {
+                return SkCodec::kErrorInInput;
+            }
+            this->addCheckpoint(in, strm.data_type & 7, lastByte, out, window, windowSize,
+                                prevRow, currRow);
+        }
+    }
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPngRowIndex_DEFINED
+#define SkPngRowIndex_DEFINED
+
+#include "include/codec/SkCodec.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <vector>
+
+class SkStream;
+
+/**
+ *  Random access to the rows of a non-interlaced PNG.
+ *
+ *  libpng can only inflate the image data from the start, so decoding a band of rows near the
+ *  bottom of a large PNG costs as much as decoding everything above it. SkPngRowIndex inflates
+ *  the IDAT data itself. At deflate block boundaries it records checkpoints, each holding the
+ *  inflate window, the bit position in the compressed data, and the row state needed to resume
+ *  unfiltering. A later decode resumes from the last checkpoint at or above its first row, so
+ *  once the index covers a region, decoding a band of rows there costs time proportional to the
+ *  band (plus at most one checkpoint interval), not to the rows above it.
+ *
+ *  Checkpoints are added whenever a decode reaches a part of the image the index does not cover
+ *  yet, so building the index costs no more than the prefix decode it replaces. Checkpoints are
+ *  spaced so that together they take about 1/kCheckpointRatio of the decoded image's memory.
+ *
+ *  Rows are produced exactly as libpng would produce them with no transforms set, so this must
+ *  only be used for images whose rows need none. Unlike libpng, the index does not check the CRCs
+ *  of the IDAT chunks it reads; a corrupt chunk is only caught if zlib rejects its data.
+ */
+class SkPngRowIndex {
+public:
+    static constexpr int kCheckpointRatio = 64;
+
+    /**
+     *  @param idatOffset Stream position of the data of the first IDAT chunk.
+     *  @param idatLength Length of the first IDAT chunk.
+     *  @param rowBytes   Bytes in an unfiltered row, not counting the filter type byte.
+     *  @param bytesPerPixel Distance used by the sub, average and paeth filters.
+     */
+    SkPngRowIndex(size_t idatOffset, size_t idatLength, int height, size_t rowBytes,
+                  int bytesPerPixel);
+    ~SkPngRowIndex();
+
+    /**
+     *  Called with each unfiltered row, in order. Returns false to stop decoding.
+     */
+    using RowProc = std::function<bool(const uint8_t* row, int rowNum)>;
+
+    /**
+     *  Decodes rows firstRow through lastRow from stream, which must be seekable, and passes
+     *  them to rowProc.
+     *
+     *  Returns kSuccess once lastRow was decoded or rowProc returned false, kIncompleteInput if
+     *  the stream ended first, and kErrorInInput if the data was invalid.
+     */
+    SkCodec::Result decodeRows(SkStream*, int firstRow, int lastRow, const RowProc& rowProc);
+
+    int checkpointCount() const { return static_cast<int>(fCheckpoints.size()); }
+
+    // The row the last call to decodeRows() started inflating at: the row of the checkpoint it
+    // resumed from, or 0.
+    int lastStartRow() const { return fLastStartRow; }
+
+private:
+    struct Chunk {
+        size_t   fStreamOffset;  // Position of the chunk data in the stream.
+        size_t   fStart;         // Offset of the chunk data in the zlib stream.
+        uint32_t fLength;
+    };
+
+    struct Checkpoint {
+        size_t  fIn;          // Offset of the next byte in the zlib stream.
+        int     fBits;        // Bits of the previous byte that inflate has not consumed.
+        uint8_t fByte;        // The previous byte, if fBits is non-zero.
+        size_t  fOut;         // Offset in the filtered image data.
+        size_t  fWindowSize;
+        // The inflate window, then the unfiltered previous row (with its filter type byte), then
+        // the filtered bytes of the current row that precede fOut.
+        std::unique_ptr<uint8_t[]> fData;
+    };
+
+    size_t rowStride() const { return fRowBytes + 1; }
+
+    // Reads up to size bytes of the zlib stream, starting at offset. The result never spans
+    // more than one IDAT chunk. Returns 0 if the stream ended.
+    //
+    // If data is not null, it is pointed at the result. Streams in memory are then not copied to
+    // dst; data points into them instead, and the result may be longer than size.
+    size_t readCompressed(SkStream*, size_t offset, uint8_t* dst, size_t size,
+                          const uint8_t** data = nullptr);
+
+    // Finds the IDAT chunk following the last one found so far.
+    bool findNextChunk(SkStream*);
+
+    void addCheckpoint(size_t in, int bits, uint8_t byte, size_t out,
+                       const uint8_t* window, size_t windowSize,
+                       const uint8_t* prevRow, const uint8_t* currRow);
+
+    const int                 fHeight;
+    const size_t              fRowBytes;
+    const int                 fBytesPerPixel;
+    const size_t              fCheckpointSpacing;
+    std::vector<Chunk>        fChunks;
+    bool                      fFoundLastChunk = false;
+    std::vector<Checkpoint>   fCheckpoints;
+    int                       fLastStartRow = 0;
+};
+
+#endif  // SkPngRowIndex_DEFINED
@@ -416,7 +416,9 @@ public:
             return nullptr;
         }
 
-        if (fStream->getMemoryBase()) {  // directly copy if getMemoryBase() is available.
+        if (sk_sp<const SkData> data = fStream->getData()) {  // share the data if available.
+            return SkMemoryStream::Make(SkData::MakeSubset(data.get(), offset, bytesToRead));
+        } else if (fStream->getMemoryBase()) {  // directly copy if getMemoryBase() is available.
             sk_sp<SkData> data(SkData::MakeWithCopy(
                 static_cast<const uint8_t*>(fStream->getMemoryBase()) + offset, bytesToRead));
             fStream.reset();
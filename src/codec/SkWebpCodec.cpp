@@ -9,6 +9,7 @@
 
 #include "include/codec/SkCodec.h"
 #include "include/codec/SkCodecAnimation.h"
+#include "include/codec/SkEncodedOrigin.h"
 #include "include/codec/SkWebpDecoder.h"
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkBitmap.h"
@@ -17,6 +18,7 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkStream.h"
+#include "include/core/SkYUVAInfo.h"
 #include "include/private/SkAlign.h"
 #include "include/private/SkMath.h"
 #include "include/private/SkNoncopyable.h"
@@ -32,6 +34,7 @@
 #include "src/core/SkStreamPriv.h"
 
 #include <algorithm>
+#include <array>
 #include <cstdint>
 #include <cstring>
 #include <optional>
@@ -686,6 +689,9 @@ SkCodec::Result SkWebpCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
         webpDst.installPixels(webpInfo, dst, rowBytes);
     }
 
+    // libwebp can filter rows on a worker thread of its own while it decodes the next ones.
+    config.options.use_threads = options.fUseDecoderThreads ? 1 : 0;
+
     config.output.colorspace = webp_decode_mode(webpInfo.colorType(),
             webpInfo.alphaType() == kPremul_SkAlphaType);
     config.output.is_external_memory = 1;
@@ -766,6 +772,105 @@ SkCodec::Result SkWebpCodec::onGetPixels(const SkImageInfo& dstInfo, void* dst,
     return result;
 }
 
+bool SkWebpCodec::isYUVSupported(const SkYUVAPixmapInfo::SupportedDataTypes* supportedDataTypes,
+                                 SkYUVAPixmapInfo* yuvaPixmapInfo) const {
+    // Only lossy (VP8) images are stored as YUV. Lossless images would need an RGB->YUV
+    // conversion, and animated frames need to be composited, so both are left to onGetPixels.
+    auto flags = WebPDemuxGetI(fDemux.get(), WEBP_FF_FORMAT_FLAGS);
+    if (flags & ANIMATION_FLAG) {
+        return false;
+    }
+    const SkEncodedInfo::Color color = this->getEncodedInfo().color();
+    if (color != SkEncodedInfo::kYUV_Color && color != SkEncodedInfo::kYUVA_Color) {
+        return false;
+    }
+
+    const auto planeConfig = color == SkEncodedInfo::kYUVA_Color
+                                     ? SkYUVAInfo::PlaneConfig::kY_U_V_A
+                                     : SkYUVAInfo::PlaneConfig::kY_U_V;
+    if (supportedDataTypes &&
+        !supportedDataTypes->supported(planeConfig, SkYUVAPixmapInfo::DataType::kUnorm8)) {
+        return false;
+    }
+    if (yuvaPixmapInfo) {
+        // VP8 is always 4:2:0 with BT.601 limited range coefficients and centered chroma.
+        SkISize dimensions = this->dimensions();
+        if (SkEncodedOriginSwapsWidthHeight(this->getOrigin())) {
+            dimensions = {dimensions.height(), dimensions.width()};
+        }
+        SkYUVAInfo yuvaInfo(dimensions,
+                            planeConfig,
+                            SkYUVAInfo::Subsampling::k420,
+                            kRec601_Limited_SkYUVColorSpace,
+                            this->getOrigin(),
+                            SkYUVAInfo::Siting::kCentered,
+                            SkYUVAInfo::Siting::kCentered);
+        *yuvaPixmapInfo = SkYUVAPixmapInfo(yuvaInfo, SkYUVAPixmapInfo::DataType::kUnorm8, nullptr);
+    }
+    return true;
+}
+
+bool SkWebpCodec::onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes& supportedDataTypes,
+                                  SkYUVAPixmapInfo* yuvaPixmapInfo) const {
+    return this->isYUVSupported(&supportedDataTypes, yuvaPixmapInfo);
+}
+
+SkCodec::Result SkWebpCodec::onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) {
+    if (!this->isYUVSupported(nullptr, nullptr)) {
+        return kInvalidInput;
+    }
+#ifdef SK_DEBUG
+    {
+        SkYUVAPixmapInfo info;
+        SkASSERT(this->isYUVSupported(nullptr, &info));
+        SkASSERT(info.yuvaInfo() == yuvaPixmaps.yuvaInfo());
+        SkASSERT(info.dataType() == yuvaPixmaps.dataType());
+    }
+#endif
+
+    WebPDecoderConfig config;
+    if (0 == WebPInitDecoderConfig(&config)) {
+        // ABI mismatch.
+        return kInvalidInput;
+    }
+
+    // Free any memory associated with the buffer. Must be called last, so we declare it first.
+    SkAutoTCallVProc<WebPDecBuffer, WebPFreeDecBuffer> autoFree(&(config.output));
+
+    WebPIterator frame;
+    SkAutoTCallVProc<WebPIterator, WebPDemuxReleaseIterator> autoFrame(&frame);
+    if (!this->ensureAllData() || !WebPDemuxGetFrame(fDemux, 1, &frame)) {
+        return kInvalidInput;
+    }
+
+    // libwebp writes each plane straight into the client's memory.
+    const std::array<SkPixmap, SkYUVAPixmaps::kMaxPlanes>& planes = yuvaPixmaps.planes();
+    const bool hasAlpha = yuvaPixmaps.numPlanes() == 4;
+    WebPYUVABuffer& buffer = config.output.u.YUVA;
+    config.output.colorspace = hasAlpha ? MODE_YUVA : MODE_YUV;
+    config.output.is_external_memory = 1;
+    buffer.y        = static_cast<uint8_t*>(planes[0].writable_addr());
+    buffer.y_stride = static_cast<int>(planes[0].rowBytes());
+    buffer.y_size   = planes[0].computeByteSize();
+    buffer.u        = static_cast<uint8_t*>(planes[1].writable_addr());
+    buffer.u_stride = static_cast<int>(planes[1].rowBytes());
+    buffer.u_size   = planes[1].computeByteSize();
+    buffer.v        = static_cast<uint8_t*>(planes[2].writable_addr());
+    buffer.v_stride = static_cast<int>(planes[2].rowBytes());
+    buffer.v_size   = planes[2].computeByteSize();
+    if (hasAlpha) {
+        buffer.a        = static_cast<uint8_t*>(planes[3].writable_addr());
+        buffer.a_stride = static_cast<int>(planes[3].rowBytes());
+        buffer.a_size   = planes[3].computeByteSize();
+    }
+
+    if (VP8_STATUS_OK != WebPDecode(frame.fragment.bytes, frame.fragment.size, &config)) {
+        // FIXME: Handle incomplete YUV decodes without signalling an error.
+        return kInvalidInput;
+    }
+    return kSuccess;
+}
+
 SkWebpCodec::SkWebpCodec(SkEncodedInfo&& info, std::unique_ptr<SkStream> stream,
                          WebPDemuxer* demux, sk_sp<SkData> data, SkEncodedOrigin origin,
                          bool onlyHeaderParsed)
@@ -13,6 +13,7 @@
 #include "include/core/SkData.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
+#include "include/core/SkYUVAPixmaps.h"
 #include "include/private/SkEncodedInfo.h"
 #include "include/private/SkTemplates.h"
 #include "src/codec/SkFrameHolder.h"
@@ -43,6 +44,11 @@ protected:
 
     bool onGetValidSubset(SkIRect* /* desiredSubset */) const override;
 
+    bool onQueryYUVAInfo(const SkYUVAPixmapInfo::SupportedDataTypes&,
+                         SkYUVAPixmapInfo*) const override;
+
+    Result onGetYUVAPlanes(const SkYUVAPixmaps& yuvaPixmaps) override;
+
     int onGetFrameCount() override;
     bool onGetFrameInfo(int, FrameInfo*) const override;
     int onGetRepetitionCount() override;
@@ -60,6 +66,11 @@ private:
     // else does nothing, returns true on success.
     bool ensureAllData();
 
+    // Returns true if this is a still, lossy image whose Y, U, V (and alpha) planes libwebp can
+    // write directly. If yuvaPixmapInfo is non-null it is set to describe those planes.
+    bool isYUVSupported(const SkYUVAPixmapInfo::SupportedDataTypes* supportedDataTypes,
+                        SkYUVAPixmapInfo* yuvaPixmapInfo) const;
+
     SkAutoTCallVProc<WebPDemuxer, WebPDemuxDelete> fDemux;
 
     // fDemux has a pointer into this data.
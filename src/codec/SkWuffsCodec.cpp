@@ -254,7 +254,9 @@ private:
     SkEncodedImageFormat onGetEncodedFormat() const override;
     Result onGetPixels(const SkImageInfo&, void*, size_t, const Options&, int*) override;
     const SkFrameHolder* getFrameHolder() const override;
-    bool                 onSupportsIncrementalDecode(const SkImageInfo&) override { return true; }
+    bool                 onSupportsIncrementalDecode(const SkImageInfo&, const Options&) override {
+        return true;
+    }
     Result               onStartIncrementalDecode(const SkImageInfo&      dstInfo,
                                                   void*                   dst,
                                                   size_t                  rowBytes,
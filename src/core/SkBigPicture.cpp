@@ -9,6 +9,8 @@
 
 #include "include/core/SkBBHFactory.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkSize.h"
 #include "include/private/SkAssert.h"
 #include "src/core/SkRecord.h"
 #include "src/core/SkRecordDraw.h"
@@ -43,6 +45,38 @@ void SkBigPicture::playback(SkCanvas* canvas, AbortCallback* callback) const {
                  callback);
 }
 
+void SkBigPicture::playbackTiled(const SkPixmap& dst,
+                                 const SkSurfaceProps& props,
+                                 SkISize tileSize,
+                                 SkExecutor* executor) const {
+    SkRecordDrawTiled(*fRecord,
+                      fCullRect,
+                      this->drawablePicts(),
+                      this->drawableCount(),
+                      fBBH.get(),
+                      dst,
+                      props,
+                      tileSize,
+                      executor);
+}
+
+bool SkBigPicture::playbackTiles(SkISize area,
+                                 SkISize tileSize,
+                                 SkSpan<const SkPixmap> tiles,
+                                 const SkSurfaceProps& props,
+                                 SkExecutor* executor) const {
+    return SkRecordDrawTiles(*fRecord,
+                             fCullRect,
+                             this->drawablePicts(),
+                             this->drawableCount(),
+                             fBBH.get(),
+                             area,
+                             tileSize,
+                             tiles,
+                             props,
+                             executor);
+}
+
 struct NestedApproxOpCounter {
     int fCount = 0;
 
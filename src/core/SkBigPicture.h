@@ -12,6 +12,7 @@
 #include "include/core/SkPicture.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkSpan.h"
 #include "include/private/SkNoncopyable.h"
 #include "include/private/SkTemplates.h"
 #include "src/core/SkRecord.h"
@@ -20,6 +21,10 @@
 #include <memory>
 
 class SkCanvas;
+class SkExecutor;
+class SkPixmap;
+class SkSurfaceProps;
+struct SkISize;
 
 // An implementation of SkPicture supporting an arbitrary number of drawing commands.
 // This is called "big" because there used to be a "mini" that only supported a subset of the
@@ -53,6 +58,14 @@ public:
     size_t approximateBytesUsed() const override;
     const SkBigPicture* asSkBigPicture() const override { return this; }
 
+// Rasterizes directly into dst, drawing tiles of tileSize concurrently on executor.
+    void playbackTiled(const SkPixmap& dst, const SkSurfaceProps&,
+                       SkISize tileSize, SkExecutor*) const;
+// Rasterizes the grid of tiles of tileSize covering area into separate pixels, concurrently on
+// executor.  Returns false if scratch pixels could not be allocated.  See SkRecordDrawTiles().
+    bool playbackTiles(SkISize area, SkISize tileSize, SkSpan<const SkPixmap> tiles,
+                       const SkSurfaceProps&, SkExecutor*) const;
+
 // Used by GrRecordReplaceDraw
     const SkBBoxHierarchy* bbh() const { return fBBH.get(); }
     const SkRecord*     record() const { return fRecord.get(); }
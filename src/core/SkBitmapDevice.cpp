@@ -31,6 +31,7 @@
 #include "include/private/SkTo.h"
 #include "src/core/SkCPURecorderImpl.h"
 #include "src/core/SkDraw.h"
+#include "src/core/SkImageFilterTypes.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkMatrixPriv.h"
 #include "src/core/SkRasterClip.h"
@@ -262,7 +263,8 @@ SkBitmapDevice::SkBitmapDevice(skcpu::RecorderImpl* recorder,
 
 sk_sp<SkBitmapDevice> SkBitmapDevice::Create(const SkImageInfo& origInfo,
                                              const SkSurfaceProps& surfaceProps,
-                                             SkRasterHandleAllocator* allocator) {
+                                             SkRasterHandleAllocator* allocator,
+                                             skcpu::RecorderImpl* recorder) {
     SkAlphaType newAT = origInfo.alphaType();
     if (!valid_for_bitmap_device(origInfo, &newAT)) {
         return nullptr;
@@ -295,6 +297,9 @@ sk_sp<SkBitmapDevice> SkBitmapDevice::Create(const SkImageInfo& origInfo,
         }
     }
 
+    if (recorder) {
+        return sk_make_sp<SkBitmapDevice>(recorder, bitmap, surfaceProps, hndl);
+    }
     return sk_make_sp<SkBitmapDevice>(bitmap, surfaceProps, hndl);
 }
 
@@ -317,7 +322,15 @@ sk_sp<SkDevice> SkBitmapDevice::createDevice(const CreateInfo& cinfo, const SkPa
         info = info.makeColorType(kN32_SkColorType);
     }
 
-    return SkBitmapDevice::Create(info, surfaceProps, cinfo.fAllocator);
+    // Layers draw with the same context, so they use its executor too.
+    return SkBitmapDevice::Create(info, surfaceProps, cinfo.fAllocator, fRecorder);
+}
+
+sk_sp<skif::Backend> SkBitmapDevice::createImageFilteringBackend(
+        const SkSurfaceProps& surfaceProps, SkColorType colorType) const {
+    const SkBlurEngine* blurEngine =
+            fRecorder && fRecorder->ctx() ? fRecorder->ctx()->blurEngine() : nullptr;
+    return skif::MakeRasterBackend(surfaceProps, colorType, blurEngine);
 }
 
 bool SkBitmapDevice::onAccessPixels(SkPixmap* pmap) {
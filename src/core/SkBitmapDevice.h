@@ -67,8 +67,10 @@ public:
                    const SkSurfaceProps& surfaceProps,
                    void* externalHandle = nullptr);
 
+    // If the recorder is null, the device draws with skcpu::Recorder::TODO().
     static sk_sp<SkBitmapDevice> Create(const SkImageInfo&, const SkSurfaceProps&,
-                                        SkRasterHandleAllocator* = nullptr);
+                                        SkRasterHandleAllocator* = nullptr,
+                                        skcpu::RecorderImpl* = nullptr);
 
     void drawPaint(const SkPaint& paint) override;
     void drawPoints(SkCanvas::PointMode, SkSpan<const SkPoint>, const SkPaint&) override;
@@ -118,6 +120,8 @@ public:
     sk_sp<SkSpecialImage> snapSpecial(const SkIRect&, bool forceCopy = false) override;
 
     sk_sp<SkDevice> createDevice(const CreateInfo&, const SkPaint*) override;
+    sk_sp<skif::Backend> createImageFilteringBackend(const SkSurfaceProps& surfaceProps,
+                                                     SkColorType colorType) const override;
 
     sk_sp<SkSurface> makeSurface(const SkImageInfo&, const SkSurfaceProps&) override;
 
@@ -22,6 +22,7 @@ namespace SkOpts {
     DEFINE_DEFAULT(blit_row_s32a_opaque);
 
     void Init_BlitRow_ml3();
+    void Init_BlitRow_ml4();
     void Init_BlitRow_lasx();
 
     static bool init() {
@@ -31,6 +32,10 @@ namespace SkOpts {
         #if SK_CPU_X64_LEVEL < SK_CPU_X64_LEVEL_AVX2
             if (SkCpu::Supports(SkX64::ML3)) { Init_BlitRow_ml3(); }
         #endif
+
+        #if SK_CPU_X64_LEVEL < SK_CPU_X64_LEVEL_ML4 && !defined(SK_DISABLE_AVX512_OPTS)
+            if (SkCpu::Supports(SkX64::ML4)) { Init_BlitRow_ml4(); }
+        #endif
     #elif defined(SK_CPU_LOONGARCH)
         #if SK_CPU_LSX_LEVEL < SK_CPU_LSX_LEVEL_LASX
             if (SkCpu::Supports(SkLoongArch::ASX)) { Init_BlitRow_lasx(); }
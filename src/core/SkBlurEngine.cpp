@@ -14,6 +14,7 @@
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h" // IWYU pragma: keep
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkM44.h"
 #include "include/core/SkMatrix.h"
@@ -35,6 +36,7 @@
 #include "src/core/SkDevice.h"
 #include "src/core/SkKnownRuntimeEffects.h"
 #include "src/core/SkSpecialImage.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkVx.h"
 
 #include <algorithm>
@@ -42,6 +44,7 @@
 #include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <memory>
 #include <utility>
 
 
@@ -153,12 +156,58 @@ private:
     const float fSigma;
 };
 
+// Blurs below this many pixels are not worth the overhead of distributing to an executor.
+static constexpr int kMinParallelBlurPixels = 256 * 256;
+// The minimum number of rows or columns handed to a single task.
+static constexpr int kMinLinesPerBlurTask = 32;
+static constexpr int kMaxBlurTasks = 64;
+
+// Runs 'blurSpan' over the lines [start, end), each 'lineLength' pixels long. When 'executor' is
+// non-null and the area is large enough, the lines are split into contiguous spans that run
+// concurrently. Every span gets its own Pass and scratch buffer since the Passes keep their
+// running sums in those buffers. Each line is blurred independently, so the output does not
+// depend on how the lines are split.
+template <typename T, typename Fn>
+static void blur_lines(SkExecutor* executor, PassMaker* maker, void* buffer,
+                       int start, int end, int lineLength, SkArenaAlloc* alloc, Fn&& blurSpan) {
+    static constexpr int N = sizeof(T) / sizeof(uint8_t);
+
+    const int lineCount = end - start;
+    int taskCount = 1;
+    if (executor && (int64_t) lineCount * lineLength >= kMinParallelBlurPixels) {
+        taskCount = std::clamp(lineCount / kMinLinesPerBlurTask, 1, kMaxBlurTasks);
+    }
+
+    if (taskCount == 1) {
+        blurSpan(maker->makePass(buffer, alloc), start, end);
+        return;
+    }
+
+    // The arena is not thread safe, so all of the Passes are made up front.
+    Pass** passes = alloc->makeArrayDefault<Pass*>(taskCount);
+    for (int i = 0; i < taskCount; ++i) {
+        void* taskBuffer = i == 0 ? buffer
+                                  : alloc->makeBytesAlignedTo(maker->bufferSizeBytes(),
+                                                              alignof(skvx::Vec<N, uint32_t>));
+        passes[i] = maker->makePass(taskBuffer, alloc);
+    }
+
+    SkTaskGroup tasks(*executor);
+    tasks.batch(taskCount, [&](int i) {
+        blurSpan(passes[i],
+                 start + (int) ((int64_t) lineCount *  i      / taskCount),
+                 start + (int) ((int64_t) lineCount * (i + 1) / taskCount));
+    });
+    tasks.wait();
+}
+
 // T is type of the pixel format for the color type.
 // This should only be used for 8bit color channels.
 template <typename T>
 static sk_sp<SkSpecialImage> eval_blur_passes(PassMaker* makerX, PassMaker* makerY,
                                               SkBitmap src, const SkIRect& originalSrcBounds,
                                               const SkIRect& originalDstBounds,
+                                              SkExecutor* executor,
                                               SkArenaAlloc* alloc) {
     static constexpr int N = sizeof(T) / sizeof(uint8_t);
     static_assert(N*sizeof(uint8_t) == sizeof(T), "N must be the the size of T in bytes.");
@@ -204,20 +253,21 @@ static sk_sp<SkSpecialImage> eval_blur_passes(PassMaker* makerX, PassMaker* make
         loopEnd   = std::min(srcBounds.bottom(), dstBounds.bottom());
 
         if (loopStart < loopEnd) {
-            auto srcAddr = reinterpret_cast<T*>(src.getAddr(0, loopStart - srcBounds.top()));
-            auto dstAddr = reinterpret_cast<T*>(dst.getAddr(0, loopStart - dstBounds.top()));
-
             // Iterate over each row to calculate 1D blur along X.
-            Pass* pass = makerX->makePass(buffer, alloc);
-            for (int y = loopStart; y < loopEnd; ++y) {
-                pass->blur<T>(srcBounds.left()  - dstBounds.left(),
-                              srcBounds.right() - dstBounds.left(),
-                              dstBounds.width(),
-                              srcAddr, 1,
-                              dstAddr, 1);
-                srcAddr += src.rowBytesAsPixels();
-                dstAddr += dst.rowBytesAsPixels();
-            }
+            blur_lines<T>(executor, makerX, buffer, loopStart, loopEnd, dstBounds.width(), alloc,
+                       [&](Pass* pass, int start, int end) {
+                auto srcAddr = reinterpret_cast<T*>(src.getAddr(0, start - srcBounds.top()));
+                auto dstAddr = reinterpret_cast<T*>(dst.getAddr(0, start - dstBounds.top()));
+                for (int y = start; y < end; ++y) {
+                    pass->blur<T>(srcBounds.left()  - dstBounds.left(),
+                                  srcBounds.right() - dstBounds.left(),
+                                  dstBounds.width(),
+                                  srcAddr, 1,
+                                  dstAddr, 1);
+                    srcAddr += src.rowBytesAsPixels();
+                    dstAddr += dst.rowBytesAsPixels();
+                }
+            });
         }
 
         // Set up the Y pass to blur from the full dst into the non-outset portion of dst
@@ -238,19 +288,23 @@ static sk_sp<SkSpecialImage> eval_blur_passes(PassMaker* makerX, PassMaker* make
     // blur.
     if (makerY->window() > 1) {
         if (loopStart < loopEnd) {
-            auto srcAddr = reinterpret_cast<T*>(src.getAddr(loopStart - srcBounds.left(), 0));
-            auto dstAddr = reinterpret_cast<T*>(dst.getAddr(loopStart - dstBounds.left(), dstYOffset));
-
-            Pass* pass = makerY->makePass(buffer, alloc);
-            for (int x = loopStart; x < loopEnd; ++x) {
-                pass->blur<T>(srcBounds.top()    - dstBounds.top(),
-                              srcBounds.bottom() - dstBounds.top(),
-                              dstBounds.height(),
-                              srcAddr, src.rowBytesAsPixels(),
-                              dstAddr, dst.rowBytesAsPixels());
-                srcAddr += 1;
-                dstAddr += 1;
-            }
+            // Each column only reads from and writes to itself, so the in-place Y pass can be
+            // split into spans of columns just like the rows of the X pass.
+            blur_lines<T>(executor, makerY, buffer, loopStart, loopEnd, dstBounds.height(), alloc,
+                       [&](Pass* pass, int start, int end) {
+                auto srcAddr = reinterpret_cast<T*>(src.getAddr(start - srcBounds.left(), 0));
+                auto dstAddr = reinterpret_cast<T*>(dst.getAddr(start - dstBounds.left(),
+                                                                dstYOffset));
+                for (int x = start; x < end; ++x) {
+                    pass->blur<T>(srcBounds.top()    - dstBounds.top(),
+                                  srcBounds.bottom() - dstBounds.top(),
+                                  dstBounds.height(),
+                                  srcAddr, src.rowBytesAsPixels(),
+                                  dstAddr, dst.rowBytesAsPixels());
+                    srcAddr += 1;
+                    dstAddr += 1;
+                }
+            });
         }
     }
 
@@ -1150,8 +1204,22 @@ private:
     uint32_t fSum2;
 };
 
-class RasterA8BlurAlgorithm : public SkBlurEngine::Algorithm {
+// Base for the Pass-based algorithms, which can split their rows and columns across an executor.
+class RasterPassBlurAlgorithm : public SkBlurEngine::Algorithm {
 public:
+    explicit RasterPassBlurAlgorithm(SkExecutor* executor) : fExecutor(executor) {}
+
+protected:
+    SkExecutor* executor() const { return fExecutor; }
+
+private:
+    SkExecutor* const fExecutor;
+};
+
+class RasterA8BlurAlgorithm : public RasterPassBlurAlgorithm {
+public:
+    using RasterPassBlurAlgorithm::RasterPassBlurAlgorithm;
+
     // See analysis in description of GaussPass for the max supported sigma.
     float maxSigma() const override {
         static constexpr float kMaxSigma = 135.f;
@@ -1197,12 +1265,14 @@ public:
         PassMaker* makerY = makeMaker(sigma.height());
 
         return eval_blur_passes<uint8_t>(makerX, makerY, src, originalSrcBounds,
-                                         originalDstBounds, &alloc);
+                                         originalDstBounds, this->executor(), &alloc);
     }
 };
 
-class Raster8888BlurAlgorithm : public SkBlurEngine::Algorithm {
+class Raster8888BlurAlgorithm : public RasterPassBlurAlgorithm {
 public:
+    using RasterPassBlurAlgorithm::RasterPassBlurAlgorithm;
+
     // See analysis in description of TentPass for the max supported sigma.
     float maxSigma() const override {
         // TentPass supports a sigma up to 2183, and was added so that the CPU blur algorithm's
@@ -1265,7 +1335,7 @@ public:
         PassMaker* makerY = makeMaker(sigma.height());
 
         return eval_blur_passes<uint32_t>(makerX, makerY, src, originalSrcBounds,
-                                          originalDstBounds, &alloc);
+                                          originalDstBounds, this->executor(), &alloc);
     }
 
 };
@@ -1282,6 +1352,10 @@ public:
 
 class RasterBlurEngine : public SkBlurEngine {
 public:
+    explicit RasterBlurEngine(SkExecutor* executor)
+            : fRGBA8BlurAlgorithm(executor)
+            , fA8BlurAlgorithm(executor) {}
+
     const Algorithm* findAlgorithm(SkSize sigma,  SkColorType colorType) const override {
         // The box blur doesn't actually care about channel order as long as it's 4 8-bit channels.
         const bool rgba8Blur = colorType == kRGBA_8888_SkColorType ||
@@ -1313,10 +1387,14 @@ private:
 } // anonymous namespace
 
 const SkBlurEngine* SkBlurEngine::GetRasterBlurEngine() {
-    static const RasterBlurEngine kInstance;
+    static const RasterBlurEngine kInstance{/*executor=*/nullptr};
     return &kInstance;
 }
 
+std::unique_ptr<SkBlurEngine> SkBlurEngine::MakeRasterBlurEngine(SkExecutor* executor) {
+    return std::make_unique<RasterBlurEngine>(executor);
+}
+
 // SkShaderBlurAlgorithm
 // ----------------------------------------------------------------------------
 
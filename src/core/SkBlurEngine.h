@@ -17,8 +17,10 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <memory>
 
 class SkDevice;
+class SkExecutor;
 class SkRuntimeEffect;
 class SkRuntimeEffectBuilder;
 class SkSpecialImage;
@@ -74,8 +76,14 @@ public:
     // Get the default CPU-backed SkBlurEngine. This has specialized algorithms for 32-bit RGBA
     // and BGRA colors, and A8 alpha-only images when the sigma is large enough. For small blurs
     // and other color types, it uses SkShaderBlurAlgorithm backed by the raster pipeline.
+    // Every blur runs on the calling thread, in a single pass over the image.
     static const SkBlurEngine* GetRasterBlurEngine();
 
+    // Make a CPU-backed SkBlurEngine with the same algorithms as GetRasterBlurEngine() that splits
+    // large blurs across 'executor' instead. If 'executor' is null, every blur runs on the calling
+    // thread. The executor must outlive the returned engine.
+    static std::unique_ptr<SkBlurEngine> MakeRasterBlurEngine(SkExecutor* executor);
+
     // TODO: These are internal functions of the raster blur engine but need to be public for legacy
     // code paths to invoke them directly.
 
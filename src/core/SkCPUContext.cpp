@@ -12,8 +12,10 @@
 
 namespace skcpu {
 
+Context::~Context() = default;
+
 std::unique_ptr<const Context> Context::Make(const Context::Options& opts) {
-    return std::make_unique<ContextImpl>();
+    return std::make_unique<ContextImpl>(opts);
 }
 
 std::unique_ptr<const Context> Context::Make() {
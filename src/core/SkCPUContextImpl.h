@@ -9,14 +9,35 @@
 
 #include "include/core/SkCPUContext.h"
 #include "include/core/SkSurfaceProps.h"
+#include "src/core/SkBlurEngine.h"
 #include "src/core/SkResourceCache.h"
 
+#include <memory>
+
 namespace skcpu {
 class ContextImpl final : public Context {
 public:
     ContextImpl() = default;
+    explicit ContextImpl(const Options& options)
+            : fExecutor(options.fExecutor)
+            , fBlurEngine(options.fExecutor ? SkBlurEngine::MakeRasterBlurEngine(options.fExecutor)
+                                            : nullptr) {}
+
+    // Returns the executor used to scan convert large paths in bands, or null.
+    SkExecutor* executor() const { return fExecutor; }
+
+    // Returns the blur engine for image filters drawn by this context's devices. With an
+    // executor, large blurs split their passes across it; otherwise this is the shared serial
+    // engine.
+    const SkBlurEngine* blurEngine() const {
+        return fBlurEngine ? fBlurEngine.get() : SkBlurEngine::GetRasterBlurEngine();
+    }
 
     static const ContextImpl* TODO();
+
+private:
+    SkExecutor* fExecutor = nullptr;
+    std::unique_ptr<SkBlurEngine> fBlurEngine;
 };
 }  // namespace skcpu
 
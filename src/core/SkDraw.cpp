@@ -9,6 +9,7 @@
 
 #include "include/core/SkBitmap.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
@@ -38,6 +39,7 @@
 #include "src/core/SkBlendModePriv.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkBlitter_A8.h"
+#include "src/core/SkCPUContextImpl.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkDrawProcs.h"
 #include "src/core/SkDrawTypes.h"
@@ -60,6 +62,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <string>
 
@@ -909,6 +912,11 @@ void Draw::drawDevPath(const SkPathRaw& raw,
         return;
     }
 
+    if (doFill && paint.isAntiAlias() && !paint.getMaskFilter() && !customBlitter &&
+        this->antiFillDevPathInBands(raw, paint, drawCoverage)) {
+        return;
+    }
+
     SkBlitter* blitter = nullptr;
     SkAutoBlitterChoose blitterStorage;
     if (nullptr == customBlitter) {
@@ -963,6 +971,49 @@ void Draw::drawDevPath(const SkPathRaw& raw,
     proc(raw, *fRC, blitter);
 }
 
+// Paths with fewer points than this are scan converted on the calling thread; the bands only pay
+// off when blitting, rather than the edge walk they all resume from, dominates the fill.
+static constexpr size_t kMinBandedPathPoints = 4096;
+static constexpr int kMinPathBandHeight = 64;
+static constexpr int kMaxPathBands = 16;
+
+bool Draw::antiFillDevPathInBands(const SkPathRaw& raw,
+                                  const SkPaint& paint,
+                                  SkDrawCoverage drawCoverage) const {
+    SkExecutor* executor = fCtx ? fCtx->executor() : nullptr;
+    if (!executor || raw.points().size() < kMinBandedPathPoints || !fRC->isBW() ||
+        !fRC->bwRgn().isRect() || !SkScan::CanAntiFillPathInBands(raw, fRC->getBounds())) {
+        return false;
+    }
+
+    SkIRect bounds = fRC->getBounds();
+    if (!bounds.intersect(raw.bounds().roundOut().makeOutset(1, 1))) {
+        return false;
+    }
+
+    // Bands start on multiples of the band height in device space, so a given band height always
+    // splits the destination at the same rows. Each band blits only its own rows of fDst, with its
+    // own blitter, chosen here since choosing one isn't thread safe.
+    int bandHeight = kMinPathBandHeight;
+    while (bounds.height() > bandHeight * kMaxPathBands) {
+        bandHeight *= 2;
+    }
+    const int firstBandTop = bounds.fTop - bounds.fTop % bandHeight;
+    const int bandCount = (bounds.fBottom - firstBandTop + bandHeight - 1) / bandHeight;
+    if (bandCount < 2) {
+        return false;
+    }
+
+    auto blitterStorage = std::make_unique<SkAutoBlitterChoose[]>(bandCount);
+    skia_private::AutoSTArray<kMaxPathBands, SkBlitter*> blitters(bandCount);
+    for (int i = 0; i < bandCount; ++i) {
+        blitters[i] = blitterStorage[i].choose(*this, nullptr, paint, raw.bounds(), drawCoverage);
+    }
+    SkScan::AntiFillPathInBands(raw, fRC->getBounds(), firstBandTop, bandHeight,
+                                SkSpan(blitters.get(), bandCount), executor);
+    return true;
+}
+
 /*
  *  Tricky idea: can we treat thin strokes as hairlines? If so, depending on how
  *  thin, we may decide to modulate the paint's alpha to 'simulate' very think
@@ -225,6 +225,11 @@ private:
                      SkDrawCoverage drawCoverage,
                      SkBlitter* customBlitter,
                      bool doFill) const;
+    // If fCtx has an executor, the clip is a rectangle and the path is a large enough polygon,
+    // scan converts an anti-aliased fill of the path in horizontal bands of the clip concurrently,
+    // with the same coverage as a single fill, and returns true. Otherwise returns false and
+    // draws nothing.
+    bool antiFillDevPathInBands(const SkPathRaw&, const SkPaint&, SkDrawCoverage) const;
     /**
      *  Return the current clip bounds, in local coordinates, with slop to account
      *  for antialiasing or hairlines (i.e. device-bounds outset by 1, and then
@@ -183,8 +183,11 @@ std::optional<LayerSpace<SkMatrix>> periodic_axis_transform(
 class RasterBackend : public Backend {
 public:
 
-    RasterBackend(const SkSurfaceProps& surfaceProps, SkColorType colorType)
-            : Backend(SkImageFilterCache::Get(), surfaceProps, colorType) {}
+    RasterBackend(const SkSurfaceProps& surfaceProps,
+                  SkColorType colorType,
+                  const SkBlurEngine* blurEngine)
+            : Backend(SkImageFilterCache::Get(), surfaceProps, colorType)
+            , fBlurEngine(blurEngine ? blurEngine : SkBlurEngine::GetRasterBlurEngine()) {}
 
     sk_sp<SkDevice> makeDevice(SkISize size,
                                sk_sp<SkColorSpace> colorSpace,
@@ -204,9 +207,10 @@ public:
         return SkImages::RasterFromBitmap(data);
     }
 
-    const SkBlurEngine* getBlurEngine() const override {
-        return SkBlurEngine::GetRasterBlurEngine();
-    }
+    const SkBlurEngine* getBlurEngine() const override { return fBlurEngine; }
+
+private:
+    const SkBlurEngine* const fBlurEngine;
 };
 
 } // anonymous namespace
@@ -222,8 +226,10 @@ Backend::Backend(sk_sp<SkImageFilterCache> cache,
 
 Backend::~Backend() = default;
 
-sk_sp<Backend> MakeRasterBackend(const SkSurfaceProps& surfaceProps, SkColorType colorType) {
-    return sk_make_sp<RasterBackend>(surfaceProps, colorType);
+sk_sp<Backend> MakeRasterBackend(const SkSurfaceProps& surfaceProps,
+                                 SkColorType colorType,
+                                 const SkBlurEngine* blurEngine) {
+    return sk_make_sp<RasterBackend>(surfaceProps, colorType, blurEngine);
 }
 
 void Stats::dumpStats() const {
@@ -1134,7 +1134,11 @@ private:
     SkColorType fColorType;
 };
 
-sk_sp<Backend> MakeRasterBackend(const SkSurfaceProps& surfaceProps, SkColorType colorType);
+// If 'blurEngine' is null, blurs use SkBlurEngine::GetRasterBlurEngine(). Otherwise it must outlive
+// the returned Backend.
+sk_sp<Backend> MakeRasterBackend(const SkSurfaceProps& surfaceProps,
+                                 SkColorType colorType,
+                                 const SkBlurEngine* blurEngine = nullptr);
 
 // Stats for a single image filter evaluation
 struct Stats {
@@ -12,6 +12,7 @@
 #define SK_OPTS_TARGET_SSSE3   0x01
 #define SK_OPTS_TARGET_AVX     0x02
 #define SK_OPTS_TARGET_ML3     0x04
+#define SK_OPTS_TARGET_ML4     0x08
 
 #define SK_OPTS_TARGET_LASX    0xE0
 
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkPackedRTree.h"
+
+#include "include/private/SkAssert.h"
+#include "src/core/SkMathPriv.h"
+
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#if SK_CPU_X64_LEVEL >= SK_CPU_X64_LEVEL_AVX
+    #include <immintrin.h>
+#elif SK_CPU_X64_LEVEL >= SK_CPU_X64_LEVEL_SSE1
+    #include <xmmintrin.h>
+#elif defined(SK_ARM_HAS_NEON) && defined(__aarch64__)
+    #include <arm_neon.h>
+#else
+    #include "src/core/SkVx.h"
+#endif
+
+namespace {
+// A bounding box and what it bounds, while the tree is built.
+struct Entry {
+    SkRect  fBounds;
+    int32_t fIndex;
+};
+}  // namespace
+
+void SkPackedRTree::insert(const SkRect boundsArray[], int N) {
+    SkASSERT(0 == fCount);
+
+    std::vector<Entry> entries;
+    entries.reserve(N);
+    for (int i = 0; i < N; i++) {
+        if (!boundsArray[i].isEmpty()) {
+            entries.push_back({boundsArray[i], i});
+        }
+    }
+
+    fCount = (int)entries.size();
+    if (!fCount) {
+        return;
+    }
+
+    // Each level has ceil(n / kFanout) nodes, down to a single root.
+    size_t nodeCount = 0;
+    for (size_t n = entries.size(); ; n = (n + kFanout - 1) / kFanout) {
+        nodeCount += (n + kFanout - 1) / kFanout;
+        if (n <= kFanout) {
+            break;
+        }
+    }
+    fNodes.reserve(nodeCount);
+
+    constexpr float kInf = std::numeric_limits<float>::infinity();
+    do {
+        const size_t levelStart = fNodes.size();
+        for (size_t i = 0; i < entries.size(); i += kFanout) {
+            Node& node = fNodes.emplace_back();
+            SkRect bounds = SkRect::MakeEmpty();
+            for (int k = 0; k < kFanout; k++) {
+                if (i + k < entries.size()) {
+                    const Entry& entry = entries[i + k];
+                    node.fLeft[k]     = entry.fBounds.fLeft;
+                    node.fTop[k]      = entry.fBounds.fTop;
+                    node.fRight[k]    = entry.fBounds.fRight;
+                    node.fBottom[k]   = entry.fBounds.fBottom;
+                    node.fChildren[k] = entry.fIndex;
+                    bounds.join(entry.fBounds);
+                } else {
+                    node.fLeft[k]   = node.fTop[k]    =  kInf;
+                    node.fRight[k]  = node.fBottom[k] = -kInf;
+                    node.fChildren[k] = -1;
+                }
+            }
+            entries[i / kFanout] = {bounds, (int32_t)(fNodes.size() - 1)};
+        }
+        if (fDepth == 0) {
+            fLeafCount = (int)fNodes.size();
+        }
+        fDepth++;
+        entries.resize(fNodes.size() - levelStart);
+    } while (entries.size() > 1);
+    SkASSERT(fNodes.size() == nodeCount);
+}
+
+uint32_t SkPackedRTree::Hits(const Node& node, const SkRect& query) {
+    static_assert(kFanout == 8);
+    // Child k intersects query if left < query.right, query.left < right, and likewise for y.
+#if SK_CPU_X64_LEVEL >= SK_CPU_X64_LEVEL_AVX
+    const __m256 hit = _mm256_and_ps(
+            _mm256_and_ps(_mm256_cmp_ps(_mm256_load_ps(node.fLeft),
+                                        _mm256_set1_ps(query.fRight), _CMP_LT_OQ),
+                          _mm256_cmp_ps(_mm256_set1_ps(query.fLeft),
+                                        _mm256_load_ps(node.fRight), _CMP_LT_OQ)),
+            _mm256_and_ps(_mm256_cmp_ps(_mm256_load_ps(node.fTop),
+                                        _mm256_set1_ps(query.fBottom), _CMP_LT_OQ),
+                          _mm256_cmp_ps(_mm256_set1_ps(query.fTop),
+                                        _mm256_load_ps(node.fBottom), _CMP_LT_OQ)));
+    return _mm256_movemask_ps(hit);
+#elif SK_CPU_X64_LEVEL >= SK_CPU_X64_LEVEL_SSE1
+    const __m128 l = _mm_set1_ps(query.fLeft),  t = _mm_set1_ps(query.fTop),
+                 r = _mm_set1_ps(query.fRight), b = _mm_set1_ps(query.fBottom);
+    uint32_t bits = 0;
+    for (int k = 0; k < kFanout; k += 4) {
+        const __m128 hit = _mm_and_ps(
+                _mm_and_ps(_mm_cmplt_ps(_mm_load_ps(node.fLeft + k), r),
+                           _mm_cmplt_ps(l, _mm_load_ps(node.fRight + k))),
+                _mm_and_ps(_mm_cmplt_ps(_mm_load_ps(node.fTop + k), b),
+                           _mm_cmplt_ps(t, _mm_load_ps(node.fBottom + k))));
+        bits |= _mm_movemask_ps(hit) << k;
+    }
+    return bits;
+#elif defined(SK_ARM_HAS_NEON) && defined(__aarch64__)
+    const float32x4_t l = vdupq_n_f32(query.fLeft),  t = vdupq_n_f32(query.fTop),
+                      r = vdupq_n_f32(query.fRight), b = vdupq_n_f32(query.fBottom);
+    // Weight each lane by its bit, so that a horizontal add makes the mask.
+    const uint32x4_t weights = {1, 2, 4, 8};
+    uint32_t bits = 0;
+    for (int k = 0; k < kFanout; k += 4) {
+        const uint32x4_t hit = vandq_u32(
+                vandq_u32(vcltq_f32(vld1q_f32(node.fLeft + k), r),
+                          vcltq_f32(l, vld1q_f32(node.fRight + k))),
+                vandq_u32(vcltq_f32(vld1q_f32(node.fTop + k), b),
+                          vcltq_f32(t, vld1q_f32(node.fBottom + k))));
+        bits |= vaddvq_u32(vandq_u32(hit, weights)) << k;
+    }
+    return bits;
+#else
+    using skvx::float8;
+    const skvx::int8 hit = (float8::Load(node.fLeft) < query.fRight) &
+                           (query.fLeft < float8::Load(node.fRight)) &
+                           (float8::Load(node.fTop) < query.fBottom) &
+                           (query.fTop < float8::Load(node.fBottom));
+    uint32_t bits = 0;
+    for (int k = 0; k < kFanout; k++) {
+        bits |= (hit[k] & 1) << k;
+    }
+    return bits;
+#endif
+}
+
+void SkPackedRTree::search(const SkRect& query, std::vector<int>* results) const {
+    // Hits() would find the children an empty or unsorted query lies on, but like
+    // SkRect::Intersects() it should find nothing.
+    if (fCount > 0 && !query.isEmpty()) {
+        this->search(this->root(), query, results);
+    }
+}
+
+void SkPackedRTree::search(int index, const SkRect& query, std::vector<int>* results) const {
+    const Node& node = fNodes[index];
+    for (uint32_t hits = Hits(node, query); hits; hits &= hits - 1) {
+        const int child = node.fChildren[SkCTZ(hits)];
+        if (this->isLeaf(index)) {
+            results->push_back(child);
+        } else {
+            this->search(child, query, results);
+        }
+    }
+}
+
+void SkPackedRTree::searchBatch(SkSpan<const SkRect> queries, std::vector<int> results[]) const {
+    if (fCount == 0) {
+        return;
+    }
+    // Walk the tree once for each 64 queries, so that each node is loaded once for all of them.
+    for (size_t start = 0; start < queries.size(); start += 64) {
+        const size_t count = std::min<size_t>(64, queries.size() - start);
+        // Empty and unsorted queries find nothing, as in search().
+        uint64_t mask = 0;
+        for (size_t q = 0; q < count; q++) {
+            if (!queries[start + q].isEmpty()) {
+                mask |= uint64_t(1) << q;
+            }
+        }
+        if (mask) {
+            this->searchBatch(this->root(), queries.data() + start, mask, results + start);
+        }
+    }
+}
+
+void SkPackedRTree::searchBatch(int index, const SkRect queries[], uint64_t queryMask,
+                                std::vector<int> results[]) const {
+    const Node& node = fNodes[index];
+    if (this->isLeaf(index)) {
+        for (uint64_t q = queryMask; q; q &= q - 1) {
+            const int query = std::countr_zero(q);
+            for (uint32_t hits = Hits(node, queries[query]); hits; hits &= hits - 1) {
+                results[query].push_back(node.fChildren[SkCTZ(hits)]);
+            }
+        }
+        return;
+    }
+
+    uint64_t childMasks[kFanout] = {};
+    for (uint64_t q = queryMask; q; q &= q - 1) {
+        const int query = std::countr_zero(q);
+        for (uint32_t hits = Hits(node, queries[query]); hits; hits &= hits - 1) {
+            childMasks[SkCTZ(hits)] |= uint64_t(1) << query;
+        }
+    }
+    // Children are visited in order, so each query's results stay sorted.
+    for (int k = 0; k < kFanout; k++) {
+        if (childMasks[k]) {
+            this->searchBatch(node.fChildren[k], queries, childMasks[k], results);
+        }
+    }
+}
+
+size_t SkPackedRTree::bytesUsed() const {
+    return sizeof(SkPackedRTree) + fNodes.capacity() * sizeof(Node);
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPackedRTree_DEFINED
+#define SkPackedRTree_DEFINED
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkSpan.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * An R-Tree laid out for wide compares. Each node stores the bounds of its children as four
+ * arrays (lefts, tops, rights, bottoms), so a query is tested against all of a node's children
+ * with one vector compare per edge. Nodes are cache-line aligned and live in one flat array,
+ * leaves first.
+ *
+ * Like SkRTree it only supports bulk-loading, and it packs consecutive bounding boxes together,
+ * relying on the recorded order to keep nearby draws close. Every node but the last on each
+ * level is full.
+ */
+class SkPackedRTree : public SkBBoxHierarchy {
+public:
+    SkPackedRTree() = default;
+
+    void insert(const SkRect[], int N) override;
+    void search(const SkRect& query, std::vector<int>* results) const override;
+    void searchBatch(SkSpan<const SkRect> queries, std::vector<int> results[]) const override;
+    size_t bytesUsed() const override;
+
+    // Methods and constants below here are only public for tests.
+
+    // Return the depth of the tree structure.
+    int getDepth() const { return fDepth; }
+    // Insertion count (not overall node count, which may be greater).
+    int getCount() const { return fCount; }
+
+    // One AVX register, or two SSE or NEON registers, of floats.
+    static constexpr int kFanout = 8;
+
+private:
+    struct alignas(64) Node {
+        // Unused slots have an inverted infinite bounds, which no query intersects.
+        float   fLeft[kFanout];
+        float   fTop[kFanout];
+        float   fRight[kFanout];
+        float   fBottom[kFanout];
+        // Op indices in leaves, node indices otherwise.
+        int32_t fChildren[kFanout];
+    };
+
+    // Returns a bit for each child of node whose bounds intersect query.
+    static uint32_t Hits(const Node& node, const SkRect& query);
+
+    bool isLeaf(int node) const { return node < fLeafCount; }
+    int root() const { return (int)fNodes.size() - 1; }
+
+    void search(int node, const SkRect& query, std::vector<int>* results) const;
+    // queryMask has a bit for each of queries that may intersect node.
+    void searchBatch(int node, const SkRect queries[], uint64_t queryMask,
+                     std::vector<int> results[]) const;
+
+    int fCount = 0;
+    int fDepth = 0;
+    int fLeafCount = 0;
+    std::vector<Node> fNodes;
+};
+
+#endif
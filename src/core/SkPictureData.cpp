@@ -7,17 +7,18 @@
 
 #include "src/core/SkPictureData.h"
 
+#include "include/core/SkData.h"
 #include "include/core/SkFlattenable.h"
 #include "include/core/SkFontMgr.h"
 #include "include/core/SkSerialProcs.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypeface.h"
+#include "include/private/SkAlign.h"
 #include "include/private/SkDebug.h"
 #include "include/private/SkTFitsIn.h"
 #include "include/private/SkTemplates.h"
 #include "include/private/SkTo.h"
-#include "src/core/SkAutoMalloc.h"
 #include "src/core/SkDebugUtils.h"
 #include "src/core/SkPicturePriv.h"
 #include "src/core/SkPictureRecord.h"
@@ -93,6 +94,16 @@ static void write_tag_size(SkWStream* stream, uint32_t tag, size_t size) {
     stream->write32(SkToU32(size));
 }
 
+// The op data and the buffer section are preceded by a pad count and that many zeros, which
+// 4-byte align them within the stream. A reader with the whole stream in memory can then use
+// them in place.
+static void write_payload_padding(SkWStream* stream) {
+    const size_t pad = (4 - (stream->bytesWritten() + 1) % 4) % 4;
+    static constexpr uint8_t kZeros[3] = {0, 0, 0};
+    stream->write8(SkToU8(pad));
+    stream->write(kZeros, pad);
+}
+
 void SkPictureData::WriteFactories(SkWStream* stream, const SkFactorySet& rec) {
     int count = rec.count();
 
@@ -220,6 +231,7 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
                               SkRefCntSet* topLevelTypeFaceSet, bool textBlobsOnly) const {
     // This can happen at pretty much any time, so might as well do it first.
     write_tag_size(stream, SK_PICT_READER_TAG, fOpData->size());
+    write_payload_padding(stream);
     stream->write(fOpData->bytes(), fOpData->size());
 
     // We serialize all typefaces into the typeface section of the top-level picture.
@@ -257,6 +269,7 @@ void SkPictureData::serialize(SkWStream* stream, const SkSerialProcs& procs,
 
     // Write the buffer.
     write_tag_size(stream, SK_PICT_BUFFER_SIZE_TAG, buffer.bytesWritten());
+    write_payload_padding(stream);
     buffer.writeToStream(stream);
 
     // Write sub-pictures by calling serialize again.
@@ -295,12 +308,37 @@ void SkPictureData::flatten(SkWriteBuffer& buffer) const {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+static bool skip_payload_padding(SkStream* stream) {
+    uint8_t pad;
+    return stream->readU8(&pad) && pad < 4 && stream->skip(pad) == pad;
+}
+
+// Reads a payload of size bytes. If the stream is backed by memory, and the payload is aligned
+// there, it is shared rather than copied, and *shared is set.
+static sk_sp<SkData> read_payload(SkStream* stream, size_t size, bool* shared = nullptr) {
+    if (sk_sp<const SkData> data = stream->getData(); data && stream->hasPosition()) {
+        const size_t offset = stream->getPosition();
+        if (offset <= data->size() && size <= data->size() - offset &&
+            SkIsAlign4(reinterpret_cast<uintptr_t>(data->bytes() + offset))) {
+            if (stream->skip(size) != size) {
+                return nullptr;
+            }
+            if (shared) {
+                *shared = true;
+            }
+            return SkData::MakeSubset(data.get(), offset, size);
+        }
+    }
+    return SkData::MakeFromStream(stream, size);
+}
+
 bool SkPictureData::parseStreamTag(SkStream* stream,
                                    uint32_t tag,
                                    uint32_t size,
                                    const SkDeserialProcs& procs,
                                    SkTypefacePlayback* topLevelTFPlayback,
-                                   int recursionLimit) {
+                                   int recursionLimit,
+                                   bool shareStreamData) {
     if (procs.fAllowTagsProc && !procs.fAllowTagsProc(tag, procs.fAllowTagsCtx)) {
         // Typefaces are always set but if there's 0 of them, we won't mark the stream as invalid
         // if the typeface tag is not allowed.
@@ -309,7 +347,11 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
     switch (tag) {
         case SK_PICT_READER_TAG:
             SkASSERT(nullptr == fOpData);
-            fOpData = SkData::MakeFromStream(stream, size);
+            if (fInfo.getVersion() >= SkPicturePriv::kAlignedStreamPayloads &&
+                !skip_payload_padding(stream)) {
+                return false;
+            }
+            fOpData = read_payload(stream, size);
             if (!fOpData) {
                 return false;
             }
@@ -365,8 +407,8 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             fPictures.reserve_exact(SkToInt(size));
 
             for (uint32_t i = 0; i < size; i++) {
-                auto pic = SkPicture::MakeFromStreamPriv(stream, &procs,
-                                                         topLevelTFPlayback, recursionLimit - 1);
+                auto pic = SkPicture::MakeFromStreamPriv(stream, &procs, topLevelTFPlayback,
+                                                         recursionLimit - 1, shareStreamData);
                 if (!pic) {
                     return false;
                 }
@@ -374,15 +416,23 @@ bool SkPictureData::parseStreamTag(SkStream* stream,
             }
         } break;
         case SK_PICT_BUFFER_SIZE_TAG: {
-            if (SkStreamPriv::RemainingLengthIsBelow(stream, size)) {
+            if (fInfo.getVersion() >= SkPicturePriv::kAlignedStreamPayloads &&
+                !skip_payload_padding(stream)) {
                 return false;
             }
-            SkAutoMalloc storage(size);
-            if (stream->read(storage.get(), size) != size) {
+            bool shared = false;
+            sk_sp<SkData> storage = read_payload(stream, size, &shared);
+            if (!storage) {
                 return false;
             }
 
-            SkReadBuffer buffer(storage.get(), size);
+            SkReadBuffer buffer;
+            if (shared && shareStreamData) {
+                // Encoded images will reference the stream's memory rather than copy it.
+                buffer.setData(std::move(storage));
+            } else {
+                buffer.setMemory(storage->data(), storage->size());
+            }
             buffer.setVersion(fInfo.getVersion());
             // A Picture stream can contain a ReadBuffer which can, in turn, contain more
             // pictures (but not more streams or buffers), so we need to remove 1 from the
@@ -538,7 +588,8 @@ SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
                                                const SkPictInfo& info,
                                                const SkDeserialProcs& procs,
                                                SkTypefacePlayback* topLevelTFPlayback,
-                                               int recursionLimit) {
+                                               int recursionLimit,
+                                               bool shareStreamData) {
     if (recursionLimit <= 0) {
         return nullptr;
     }
@@ -547,7 +598,7 @@ SkPictureData* SkPictureData::CreateFromStream(SkStream* stream,
         topLevelTFPlayback = &data->fTFPlayback;
     }
 
-    if (!data->parseStream(stream, procs, topLevelTFPlayback, recursionLimit)) {
+    if (!data->parseStream(stream, procs, topLevelTFPlayback, recursionLimit, shareStreamData)) {
         return nullptr;
     }
     return data.release();
@@ -570,7 +621,8 @@ SkPictureData* SkPictureData::CreateFromBuffer(SkReadBuffer& buffer,
 bool SkPictureData::parseStream(SkStream* stream,
                                 const SkDeserialProcs& procs,
                                 SkTypefacePlayback* topLevelTFPlayback,
-                                int recursionLimit) {
+                                int recursionLimit,
+                                bool shareStreamData) {
     for (;;) {
         uint32_t tag;
         if (!stream->readU32(&tag)) { return false; }
@@ -580,7 +632,8 @@ bool SkPictureData::parseStream(SkStream* stream,
 
         uint32_t size;
         if (!stream->readU32(&size)) { return false; }
-        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback, recursionLimit)) {
+        if (!this->parseStreamTag(stream, tag, size, procs, topLevelTFPlayback, recursionLimit,
+                                  shareStreamData)) {
             return false; // we're invalid
         }
     }
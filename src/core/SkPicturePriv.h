@@ -128,6 +128,7 @@ public:
     // v108: Serialize stable keys of runtime effects
     // v109: Extend SkWorkingColorSpaceShader to have alpha type + output control
     // v110: Add restrictOutputToInputBounds to SkImageFilters::RuntimeShader
+    // v111: Op data and the buffer section are 4-byte aligned within the stream
 
     enum Version {
         kPictureShaderFilterParam_Version   = 82,
@@ -159,6 +160,7 @@ public:
         kSerializeStableKeys                = 108,
         kWorkingColorSpaceOutput            = 109,
         kRuntimeImageFilterRestrictedOutput = 110,
+        kAlignedStreamPayloads              = 111,
 
         // Only SKPs within the min/current picture version range (inclusive) can be read.
         //
@@ -183,7 +185,7 @@ public:
         //
         // Contact the Infra Gardener if the above steps do not work for you.
         kMin_Version     = kPictureShaderFilterParam_Version,
-        kCurrent_Version = kRuntimeImageFilterRestrictedOutput
+        kCurrent_Version = kAlignedStreamPayloads
     };
 };
 
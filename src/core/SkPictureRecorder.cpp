@@ -73,7 +73,11 @@ sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPicture() {
     }
 
     // TODO: delay as much of this work until just before first playback?
-    SkRecordOptimize(fRecord.get());
+    if (fOptimizeForPlayback) {
+        SkRecordOptimizeForPlayback(fRecord.get(), fCullRect);
+    } else {
+        SkRecordOptimize(fRecord.get());
+    }
 
     SkDrawableList* drawableList = fRecorder->getDrawableList();
     std::unique_ptr<SkBigPicture::SnapshotArray> pictList{
@@ -133,7 +137,11 @@ sk_sp<SkDrawable> SkPictureRecorder::finishRecordingAsDrawable() {
     fActivelyRecording = false;
     fRecorder->restoreToCount(1);  // If we were missing any restores, add them now.
 
-    SkRecordOptimize(fRecord.get());
+    if (fOptimizeForPlayback) {
+        SkRecordOptimizeForPlayback(fRecord.get(), fCullRect);
+    } else {
+        SkRecordOptimize(fRecord.get());
+    }
 
     if (fBBH) {
         AutoTArray<SkRect> bounds(fRecord->count());
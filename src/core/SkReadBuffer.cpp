@@ -58,6 +58,13 @@ void SkReadBuffer::setMemory(const void* data, size_t size) {
     }
 }
 
+void SkReadBuffer::setData(sk_sp<const SkData> data) {
+    this->setMemory(data->data(), data->size());
+    if (!fError) {
+        fData = std::move(data);
+    }
+}
+
 void SkReadBuffer::setInvalid() {
     if (!fError) {
         // When an error is found, send the read cursor to the end of the stream
@@ -335,6 +342,24 @@ sk_sp<SkData> SkReadBuffer::readByteArrayAsData() {
     return SkData::MakeFromMalloc(buffer.release(), numBytes);
 }
 
+sk_sp<SkData> SkReadBuffer::readByteArrayAsSharedData() {
+    if (!fData) {
+        return this->readByteArrayAsData();
+    }
+    size_t numBytes = this->getArrayCount();
+    if (!this->validate(this->isAvailable(numBytes))) {
+        return nullptr;
+    }
+
+    // Skip the count, then share the bytes that follow it.
+    const size_t offset = fCurr + sizeof(uint32_t) - static_cast<const char*>(fData->data());
+    this->skipByteArray(nullptr);
+    if (!this->isValid()) {
+        return nullptr;
+    }
+    return SkData::MakeSubset(fData.get(), offset, numBytes);
+}
+
 uint32_t SkReadBuffer::getArrayCount() {
     const size_t inc = sizeof(uint32_t);
     if (!this->validate(IsPtrAlign4(fCurr) && this->isAvailable(inc))) {
@@ -410,7 +435,7 @@ sk_sp<SkImage> SkReadBuffer::readImage() {
     }
     sk_sp<SkImage> image;
     {
-        sk_sp<SkData> data = this->readByteArrayAsData();
+        sk_sp<SkData> data = this->readByteArrayAsSharedData();
         if (!data) {
             this->validate(false);
             return nullptr;
@@ -60,6 +60,9 @@ public:
     }
 
     void setMemory(const void*, size_t);
+    // Like setMemory(), but encoded images read from the buffer will share data rather than
+    // copy it.
+    void setData(sk_sp<const SkData> data);
 
     /**
      *  Returns true IFF the version is older than the specified version.
@@ -255,12 +258,16 @@ private:
 
     void setInvalid();
     bool readArray(void* value, size_t size, size_t elementSize);
+    // Like readByteArrayAsData(), but references fData if it is set. The result must not be
+    // written to.
+    sk_sp<SkData> readByteArrayAsSharedData();
     bool isAvailable(size_t size) const { return size <= this->available(); }
 
     // These are always 4-byte aligned
     const char* fCurr = nullptr;  // current position within buffer
     const char* fStop = nullptr;  // end of buffer
     const char* fBase = nullptr;  // beginning of buffer
+    sk_sp<const SkData> fData;    // owns the buffer, if set by setData()
 
     // Only used if we do not have an fFactoryArray.
     skia_private::THashMap<uint32_t, SkFlattenable::Factory> fFlattenableDict;
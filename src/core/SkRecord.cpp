@@ -7,13 +7,72 @@
 
 #include "src/core/SkRecord.h"
 
+#include "include/core/SkColor.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "src/core/SkChecksum.h"
+
 #include <algorithm>
+#include <cstring>
+#include <new>
 
 SkRecord::~SkRecord() {
     Destroyer destroyer;
     for (int i = 0; i < this->count(); i++) {
         this->mutate(i, destroyer);
     }
+    fPaints.foreach([](SkPaint** paint) { (*paint)->~SkPaint(); });
+    fPaths.foreach([](SkPath** path) { (*path)->~SkPath(); });
+}
+
+uint32_t SkRecord::PaintTraits::Hash(const SkPaint& paint) {
+    // Everything operator== compares.  Paints that compare equal but hash differently (e.g.
+    // with a stroke width of -0 and 0) are just not shared.
+    struct {
+        SkColor4f   color;
+        float       width, miter;
+        uint32_t    bits;
+        const void* effects[6];
+    } key;
+    memset(&key, 0, sizeof(key));
+    key.color = paint.getColor4f();
+    key.width = paint.getStrokeWidth();
+    key.miter = paint.getStrokeMiter();
+    key.bits  = (uint32_t)paint.isAntiAlias()         |
+                (uint32_t)paint.isDither()       << 1 |
+                (uint32_t)paint.getStrokeCap()   << 2 |
+                (uint32_t)paint.getStrokeJoin()  << 4 |
+                (uint32_t)paint.getStyle()       << 6;
+    key.effects[0] = paint.getPathEffect();
+    key.effects[1] = paint.getShader();
+    key.effects[2] = paint.getMaskFilter();
+    key.effects[3] = paint.getColorFilter();
+    key.effects[4] = paint.getImageFilter();
+    key.effects[5] = paint.getBlender();
+    return SkChecksum::Hash32(&key, sizeof(key));
+}
+
+uint32_t SkRecord::PathTraits::Hash(const SkPath& path) {
+    // operator== ignores volatility, but keeping volatile and non-volatile paths apart keeps
+    // backends from caching (or not caching) a path they were not asked to.
+    const uint32_t seed = (uint32_t)path.getFillType() | (uint32_t)path.isVolatile() << 2;
+    uint32_t hash = SkChecksum::Hash32(path.verbs().data(), path.verbs().size_bytes(), seed);
+    hash = SkChecksum::Hash32(path.points().data(), path.points().size_bytes(), hash);
+    return SkChecksum::Hash32(path.conicWeights().data(), path.conicWeights().size_bytes(), hash);
+}
+
+const SkPaint* SkRecord::intern(const SkPaint& paint) {
+    if (SkPaint* const* found = fPaints.find(paint)) {
+        return *found;
+    }
+    return *fPaints.set(new (this->alloc<SkPaint>()) SkPaint(paint));
+}
+
+const SkPath* SkRecord::intern(const SkPath& path) {
+    if (SkPath* const* found = fPaths.find(path)) {
+        return *found;
+    }
+    return *fPaths.set(new (this->alloc<SkPath>()) SkPath(path));
 }
 
 void SkRecord::grow() {
@@ -24,6 +83,7 @@ void SkRecord::grow() {
 
 size_t SkRecord::bytesUsed() const {
     size_t bytes = fApproxBytesAllocated + sizeof(SkRecord);
+    bytes += fPaints.approxBytesUsed() + fPaths.approxBytesUsed();
     return bytes;
 }
 
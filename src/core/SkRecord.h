@@ -13,8 +13,10 @@
 #include "include/private/SkTemplates.h"
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkRecords.h"
+#include "src/core/SkTHash.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <type_traits>
 
 // SkRecord represents a sequence of SkCanvas calls, saved for future use.
@@ -67,6 +69,11 @@ public:
         return (T*)fAlloc.makeArrayDefault<RawBytes>(count);
     }
 
+    // Return a copy of paint or path, to be freed when the SkRecord is destroyed.  Identical
+    // paints (or paths) share one copy, which ops refer to with an SkRecords::Interned.
+    const SkPaint* intern(const SkPaint&);
+    const SkPath*  intern(const SkPath&);
+
     // Add a new command of type T to the end of this SkRecord.
     // You are expected to placement new an object of type T onto this pointer.
     template <typename T>
@@ -90,8 +97,8 @@ public:
         return fRecords[i].set(this->allocCommand<T>());
     }
 
-    // Does not return the bytes in any pointers embedded in the Records; callers
-    // need to iterate with a visitor to measure those they care for.
+    // Does not return the bytes in any pointers embedded in the Records (other than interned
+    // paints and paths); callers need to iterate with a visitor to measure those they care for.
     size_t bytesUsed() const;
 
     // Rearrange and resize this record to eliminate any NoOps.
@@ -181,6 +188,18 @@ private:
     // chunks, returning a stable handle to that data for later retrieval.
     SkArenaAlloc fAlloc{256};
     size_t       fApproxBytesAllocated{0};
+
+    // The interned paints and paths, which live in fAlloc.
+    struct PaintTraits {
+        static const SkPaint& GetKey(const SkPaint* paint) { return *paint; }
+        static uint32_t Hash(const SkPaint&);
+    };
+    struct PathTraits {
+        static const SkPath& GetKey(const SkPath* path) { return *path; }
+        static uint32_t Hash(const SkPath&);
+    };
+    skia_private::THashTable<SkPaint*, SkPaint, PaintTraits> fPaints;
+    skia_private::THashTable<SkPath*,  SkPath,  PathTraits>  fPaths;
 };
 
 #endif//SkRecord_DEFINED
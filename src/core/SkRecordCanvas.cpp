@@ -162,30 +162,31 @@ template <> char* SkRecordCanvas::copy(const char src[], size_t count) {
 template <> char* SkRecordCanvas::copy(const char* src) { return this->copy(src, strlen(src) + 1); }
 
 void SkRecordCanvas::onDrawPaint(const SkPaint& paint) {
-    this->append<SkRecords::DrawPaint>(paint);
+    this->append<SkRecords::DrawPaint>(fRecord->intern(paint));
 }
 
 void SkRecordCanvas::onDrawBehind(const SkPaint& paint) {
-    this->append<SkRecords::DrawBehind>(paint);
+    this->append<SkRecords::DrawBehind>(fRecord->intern(paint));
 }
 
 void SkRecordCanvas::onDrawPoints(PointMode mode,
                                   size_t count,
                                   const SkPoint pts[],
                                   const SkPaint& paint) {
-    this->append<SkRecords::DrawPoints>(paint, mode, SkToUInt(count), this->copy(pts, count));
+    this->append<SkRecords::DrawPoints>(
+            fRecord->intern(paint), mode, SkToUInt(count), this->copy(pts, count));
 }
 
 void SkRecordCanvas::onDrawRect(const SkRect& rect, const SkPaint& paint) {
-    this->append<SkRecords::DrawRect>(paint, rect);
+    this->append<SkRecords::DrawRect>(fRecord->intern(paint), rect);
 }
 
 void SkRecordCanvas::onDrawRegion(const SkRegion& region, const SkPaint& paint) {
-    this->append<SkRecords::DrawRegion>(paint, region);
+    this->append<SkRecords::DrawRegion>(fRecord->intern(paint), region);
 }
 
 void SkRecordCanvas::onDrawOval(const SkRect& oval, const SkPaint& paint) {
-    this->append<SkRecords::DrawOval>(paint, oval);
+    this->append<SkRecords::DrawOval>(fRecord->intern(paint), oval);
 }
 
 void SkRecordCanvas::onDrawArc(const SkRect& oval,
@@ -193,17 +194,18 @@ void SkRecordCanvas::onDrawArc(const SkRect& oval,
                                SkScalar sweepAngle,
                                bool useCenter,
                                const SkPaint& paint) {
-    this->append<SkRecords::DrawArc>(paint, oval, startAngle, sweepAngle, useCenter);
+    this->append<SkRecords::DrawArc>(
+            fRecord->intern(paint), oval, startAngle, sweepAngle, useCenter);
 }
 
 void SkRecordCanvas::onDrawRRect(const SkRRect& rrect, const SkPaint& paint) {
-    this->append<SkRecords::DrawRRect>(paint, rrect);
+    this->append<SkRecords::DrawRRect>(fRecord->intern(paint), rrect);
 }
 
 void SkRecordCanvas::onDrawDRRect(const SkRRect& outer,
                                   const SkRRect& inner,
                                   const SkPaint& paint) {
-    this->append<SkRecords::DrawDRRect>(paint, outer, inner);
+    this->append<SkRecords::DrawDRRect>(fRecord->intern(paint), outer, inner);
 }
 
 void SkRecordCanvas::onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) {
@@ -216,7 +218,7 @@ void SkRecordCanvas::onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix
 }
 
 void SkRecordCanvas::onDrawPath(const SkPath& path, const SkPaint& paint) {
-    this->append<SkRecords::DrawPath>(paint, path);
+    this->append<SkRecords::DrawPath>(fRecord->intern(paint), fRecord->intern(path));
 }
 
 void SkRecordCanvas::onDrawImage2(const SkImage* image,
@@ -262,11 +264,11 @@ void SkRecordCanvas::onDrawTextBlob(const SkTextBlob* blob,
                                     SkScalar x,
                                     SkScalar y,
                                     const SkPaint& paint) {
-    this->append<SkRecords::DrawTextBlob>(paint, sk_ref_sp(blob), x, y);
+    this->append<SkRecords::DrawTextBlob>(fRecord->intern(paint), sk_ref_sp(blob), x, y);
 }
 
 void SkRecordCanvas::onDrawSlug(const sktext::gpu::Slug* slug, const SkPaint& paint) {
-    this->append<SkRecords::DrawSlug>(paint, sk_ref_sp(slug));
+    this->append<SkRecords::DrawSlug>(fRecord->intern(paint), sk_ref_sp(slug));
 }
 
 void SkRecordCanvas::onDrawGlyphRunList(const sktext::GlyphRunList& glyphRunList,
@@ -291,13 +293,13 @@ void SkRecordCanvas::onDrawVerticesObject(const SkVertices* vertices,
                                           SkBlendMode bmode,
                                           const SkPaint& paint) {
     this->append<SkRecords::DrawVertices>(
-            paint, sk_ref_sp(const_cast<SkVertices*>(vertices)), bmode);
+            fRecord->intern(paint), sk_ref_sp(const_cast<SkVertices*>(vertices)), bmode);
 }
 
 void SkRecordCanvas::onDrawMesh(const SkMesh& mesh,
                                 sk_sp<SkBlender> blender,
                                 const SkPaint& paint) {
-    this->append<SkRecords::DrawMesh>(paint, mesh, std::move(blender));
+    this->append<SkRecords::DrawMesh>(fRecord->intern(paint), mesh, std::move(blender));
 }
 
 void SkRecordCanvas::onDrawPatch(const SkPoint cubics[12],
@@ -306,7 +308,7 @@ void SkRecordCanvas::onDrawPatch(const SkPoint cubics[12],
                                  SkBlendMode bmode,
                                  const SkPaint& paint) {
     this->append<SkRecords::DrawPatch>(
-            paint,
+            fRecord->intern(paint),
             cubics ? this->copy(cubics, SkPatchUtils::kNumCtrlPts) : nullptr,
             colors ? this->copy(colors, SkPatchUtils::kNumCorners) : nullptr,
             texCoords ? this->copy(texCoords, SkPatchUtils::kNumCorners) : nullptr,
@@ -334,7 +336,7 @@ void SkRecordCanvas::onDrawAtlas2(const SkImage* atlas,
 }
 
 void SkRecordCanvas::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) {
-    this->append<SkRecords::DrawShadowRec>(path, rec);
+    this->append<SkRecords::DrawShadowRec>(fRecord->intern(path), rec);
 }
 
 void SkRecordCanvas::onDrawAnnotation(const SkRect& rect, const char key[], SkData* value) {
@@ -423,7 +425,7 @@ void SkRecordCanvas::onClipRRect(const SkRRect& rrect, SkClipOp op, ClipEdgeStyl
 void SkRecordCanvas::onClipPath(const SkPath& path, SkClipOp op, ClipEdgeStyle edgeStyle) {
     INHERITED(onClipPath, path, op, edgeStyle);
     SkRecords::ClipOpAndAA opAA(op, kSoft_ClipEdgeStyle == edgeStyle);
-    this->append<SkRecords::ClipPath>(path, opAA);
+    this->append<SkRecords::ClipPath>(fRecord->intern(path), opAA);
 }
 
 void SkRecordCanvas::onClipShader(sk_sp<SkShader> cs, SkClipOp op) {
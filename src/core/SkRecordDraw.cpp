@@ -8,6 +8,7 @@
 #include "src/core/SkRecordDraw.h"
 
 #include "include/core/SkBBHFactory.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkBlender.h"
 #include "include/core/SkColor.h"
@@ -15,6 +16,7 @@
 #include "include/core/SkMatrix.h"
 #include "include/core/SkMesh.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkPoint.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkRSXform.h"
@@ -23,24 +25,33 @@
 #include "include/core/SkRegion.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkShader.h"
+#include "include/core/SkSize.h"
 #include "include/core/SkString.h"
+#include "include/core/SkSurfaceProps.h"
 #include "include/core/SkTextBlob.h"
 #include "include/core/SkVertices.h"
 #include "include/private/SkAssert.h"
 #include "include/private/SkTDArray.h"
 #include "include/private/SkTemplates.h"
 #include "include/private/chromium/Slug.h"
+#include "src/core/SkBigPicture.h"
 #include "src/core/SkCanvasPriv.h"
 #include "src/core/SkDrawShadowInfo.h"
 #include "src/core/SkImageFilter_Base.h"
+#include "src/core/SkPicturePriv.h"
 #include "src/core/SkRecord.h"
 #include "src/core/SkRecords.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/effects/colorfilters/SkColorFilterBase.h"
 #include "src/utils/SkPatchUtils.h"
 
 #include <algorithm>
+#include <atomic>
 #include <cstddef>
+#include <functional>
+#include <memory>
 #include <optional>
+#include <type_traits>
 #include <vector>
 
 class SkImageFilter;
@@ -90,6 +101,493 @@ void SkRecordDraw(const SkRecord& record,
     }
 }
 
+// Finds the ops of record that touch each tile of tileSize in the grid covering area, with one
+// list per tile in row-major order.  Each list is in record order.  bounds holds each op's
+// SkRecordFillBounds() bounds, used when there is no bbh.
+static std::vector<std::vector<int>> find_tile_ops(const SkRecord& record,
+                                                   const SkRect bounds[],
+                                                   const SkBBoxHierarchy* bbh,
+                                                   SkISize area,
+                                                   SkISize tileSize) {
+    const int tileW  = tileSize.width(),
+              tileH  = tileSize.height(),
+              tilesX = (area.width()  + tileW - 1) / tileW,
+              tilesY = (area.height() + tileH - 1) / tileH;
+    std::vector<std::vector<int>> tileOps(tilesX * tilesY);
+
+    if (bbh) {
+        // Query for every tile in one pass over the BBH.  Like SkRecordDraw(), query the tile's
+        // local clip bounds, which getLocalClipBounds() outsets by a pixel for antialiasing.
+        std::vector<SkRect> queries(tileOps.size());
+        for (int tile = 0; tile < (int)tileOps.size(); tile++) {
+            queries[tile] = SkRect::Make(SkIRect::MakeXYWH((tile % tilesX) * tileW,
+                                                           (tile / tilesX) * tileH,
+                                                           tileW,
+                                                           tileH)).makeOutset(1, 1);
+        }
+        bbh->searchBatch(queries, tileOps.data());
+        return tileOps;
+    }
+
+    // Bin every op into each tile its bounds touch.  We visit ops in record order, so each
+    // tile's list stays sorted and replays ops in the same order SkRecordDraw() would.  Like a
+    // BBH query, this skips ops with empty bounds; SkRecordFillBounds() gives matching
+    // Save/Restore pairs the same bounds, so those are always kept or dropped together.
+    const SkIRect areaBounds = SkIRect::MakeSize(area);
+    for (int i = 0; i < record.count(); i++) {
+        SkIRect opBounds = bounds[i].roundOut();
+        if (!opBounds.intersect(areaBounds)) {
+            continue;
+        }
+        for (int y = opBounds.fTop / tileH; y <= (opBounds.fBottom - 1) / tileH; y++) {
+            for (int x = opBounds.fLeft / tileW; x <= (opBounds.fRight - 1) / tileW; x++) {
+                tileOps[y * tilesX + x].push_back(i);
+            }
+        }
+    }
+    return tileOps;
+}
+
+static void run_tiles(int count, SkExecutor* executor, const std::function<void(int)>& drawTile) {
+    if (executor) {
+        SkTaskGroup tg(*executor);
+        tg.batch(count, drawTile);
+        tg.wait();
+    } else {
+        for (int tile = 0; tile < count; tile++) {
+            drawTile(tile);
+        }
+    }
+}
+
+namespace {
+
+// Where an op can be drawn so that its pixels match drawing it on one canvas.  The raster
+// backend clips path edges to the clip bounds before scan converting them, so most geometry
+// only rasterizes the same in a tile if the tile's clip doesn't cut through it.  Fills of the
+// whole clip, axis-aligned rects and images, and rectangular clips cover each pixel the same
+// under any clip.  Image filters size their intermediate images to the clip, backdrops and
+// layers initialized from the previous layer read pixels other tiles are drawing, the "behind"
+// ops reach below their layer, and ResetClip drops the tile's clip; those need one canvas.
+enum class TileSplit {
+    kAnyTiles,   // Can be drawn in every tile it touches.
+    kOneTile,    // Can be drawn in a tile only if it fits inside that tile.
+    kOneCanvas,  // Must be drawn on one canvas covering every tile.
+};
+
+const SkPaint* op_paint(const SkRecords::Optional<SkPaint>& paint) { return paint; }
+const SkPaint* op_paint(const SkRecords::Interned<SkPaint>& paint) { return paint.get(); }
+
+// Visits ops in record order, tracking the matrix to classify each op's TileSplit.
+class TileSplitter {
+public:
+    TileSplitter(const SkMatrix& initialCTM,
+                 SkPicture const* const drawablePicts[],
+                 int drawableCount)
+            : fInitialCTM(initialCTM)
+            , fCTM(initialCTM)
+            , fDrawablePicts(drawablePicts)
+            , fDrawableCount(drawableCount) {}
+
+    template <typename T>
+    TileSplit operator()(const T& op) {
+        const TileSplit split = this->split(op);
+        this->updateCTM(op);
+        return split;
+    }
+
+    // Splits of a nested picture's ops, drawn with matrix.  The picture's own drawables aren't
+    // reachable from here, so any it has must be drawn on one canvas.
+    static TileSplit PictureSplit(const SkPicture* picture, const SkMatrix& matrix) {
+        if (picture->approximateOpCount() == 0) {
+            return TileSplit::kAnyTiles;
+        }
+        const SkBigPicture* bigPicture = SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture));
+        if (!bigPicture) {
+            return TileSplit::kOneCanvas;
+        }
+        const SkRecord& record = *bigPicture->record();
+        TileSplitter splitter(matrix, nullptr, 0);
+        TileSplit split = TileSplit::kAnyTiles;
+        for (int i = 0; i < record.count() && split != TileSplit::kOneCanvas; i++) {
+            split = std::max(split, record.visit(i, splitter));
+        }
+        return split;
+    }
+
+private:
+    template <typename T>
+    TileSplit split(const T& op) const {
+        using namespace SkRecords;
+        if constexpr ((T::kTags & kHasPaint_Tag) != 0) {
+            const SkPaint* paint = op_paint(op.paint);
+            if (paint && paint->getImageFilter()) {
+                return TileSplit::kOneCanvas;
+            }
+        }
+
+        if constexpr (std::is_same_v<T, SaveLayer>) {
+            return op.filters.empty() && !op.backdrop &&
+                   !(op.saveLayerFlags & SkCanvas::kInitWithPrevious_SaveLayerFlag)
+                           ? TileSplit::kAnyTiles
+                           : TileSplit::kOneCanvas;
+        } else if constexpr (std::is_same_v<T, ClipRect>) {
+            return fCTM.isScaleTranslate() ? TileSplit::kAnyTiles : TileSplit::kOneCanvas;
+        } else if constexpr (std::is_same_v<T, ClipRRect> || std::is_same_v<T, ClipPath> ||
+                             std::is_same_v<T, ResetClip> || std::is_same_v<T, SaveBehind> ||
+                             std::is_same_v<T, DrawBehind>) {
+            return TileSplit::kOneCanvas;
+        } else if constexpr (std::is_same_v<T, DrawPaint>) {
+            return op.paint->getMaskFilter() ? TileSplit::kOneTile : TileSplit::kAnyTiles;
+        } else if constexpr (std::is_same_v<T, DrawRect>) {
+            return fCTM.isScaleTranslate() && op.paint->getStyle() == SkPaint::kFill_Style &&
+                   !op.paint->getPathEffect() && !op.paint->getMaskFilter()
+                           ? TileSplit::kAnyTiles
+                           : TileSplit::kOneTile;
+        } else if constexpr (std::is_same_v<T, DrawImage> || std::is_same_v<T, DrawImageRect>) {
+            return fCTM.isScaleTranslate() && !(op.paint && op.paint->getMaskFilter())
+                           ? TileSplit::kAnyTiles
+                           : TileSplit::kOneTile;
+        } else if constexpr (std::is_same_v<T, DrawPicture>) {
+            return PictureSplit(op.picture.get(), SkMatrix::Concat(fCTM, op.matrix));
+        } else if constexpr (std::is_same_v<T, DrawDrawable>) {
+            if (!fDrawablePicts || op.index >= fDrawableCount) {
+                return TileSplit::kOneCanvas;
+            }
+            return PictureSplit(fDrawablePicts[op.index],
+                                op.matrix ? SkMatrix::Concat(fCTM, *op.matrix) : fCTM);
+        } else {
+            return (T::kTags & kDraw_Tag) != 0 ? TileSplit::kOneTile : TileSplit::kAnyTiles;
+        }
+    }
+
+    // Like SkRecords::Draw, matrices set by the record are relative to the initial matrix.
+    template <typename T> void updateCTM(const T&) {}
+    void updateCTM(const SkRecords::Restore& op)   { fCTM.setConcat(fInitialCTM, op.matrix); }
+    void updateCTM(const SkRecords::SetMatrix& op) { fCTM.setConcat(fInitialCTM, op.matrix); }
+    void updateCTM(const SkRecords::SetM44& op) {
+        fCTM.setConcat(fInitialCTM, op.matrix.asM33());
+    }
+    void updateCTM(const SkRecords::Concat44& op)  { fCTM.preConcat(op.matrix.asM33()); }
+    void updateCTM(const SkRecords::Concat& op)    { fCTM.preConcat(op.matrix); }
+    void updateCTM(const SkRecords::Scale& op)     { fCTM.preScale(op.sx, op.sy); }
+    void updateCTM(const SkRecords::Translate& op) { fCTM.preTranslate(op.dx, op.dy); }
+
+    const SkMatrix          fInitialCTM;
+    SkMatrix                fCTM;
+    SkPicture const* const* fDrawablePicts;
+    int                     fDrawableCount;
+};
+
+// Ops [begin, end) that must be drawn on one canvas spanning the tiles in tiles, measured in
+// tiles, after each of those tiles has drawn the ops before begin.
+struct TileBarrier {
+    int     begin, end;
+    SkIRect tiles;
+};
+
+}  // namespace
+
+// Finds the ops that can't be drawn tile by tile.  Ops are grouped with the rest of their
+// outermost Save/Restore block, so every barrier starts with an empty save stack, and ops after a
+// ResetClip or non-rectangular clip outside any block all form one barrier across every tile.
+// Also lists the matrix and clip ops outside any block, which each canvas replays up to its
+// first op to start from the same state.
+static std::vector<TileBarrier> find_tile_barriers(const SkRecord& record,
+                                                   const SkRect& cullRect,
+                                                   const SkRect bounds[],
+                                                   SkPicture const* const drawablePicts[],
+                                                   int drawableCount,
+                                                   SkISize area,
+                                                   SkISize tileSize,
+                                                   std::vector<int>* topLevelState) {
+    const int tileW = tileSize.width(),
+              tileH = tileSize.height();
+    const SkIRect allTiles = SkIRect::MakeWH((area.width()  + tileW - 1) / tileW,
+                                             (area.height() + tileH - 1) / tileH);
+
+    // Bounds stop at the cull rect, but ops may draw past it, so any edge on the cull rect might
+    // go on to the edge of the area.  Anything that touches only one tile is split by no tile edge.
+    auto touchedTiles = [&](const SkRect& opBounds) {
+        if (opBounds.isEmpty()) {
+            return SkIRect::MakeEmpty();
+        }
+        SkIRect r = opBounds.makeOutset(1, 1).roundOut();
+        if (opBounds.fLeft   <= cullRect.fLeft)   { r.fLeft   = 0; }
+        if (opBounds.fTop    <= cullRect.fTop)    { r.fTop    = 0; }
+        if (opBounds.fRight  >= cullRect.fRight)  { r.fRight  = area.width(); }
+        if (opBounds.fBottom >= cullRect.fBottom) { r.fBottom = area.height(); }
+        if (!r.intersect(SkIRect::MakeSize(area))) {
+            return SkIRect::MakeEmpty();
+        }
+        return SkIRect::MakeLTRB(r.fLeft / tileW, r.fTop / tileH,
+                                 (r.fRight - 1) / tileW + 1, (r.fBottom - 1) / tileH + 1);
+    };
+
+    std::vector<TileBarrier> barriers;
+    auto addBarrier = [&](int begin, int end, TileSplit split, const SkRect& opBounds) {
+        SkIRect tiles = allTiles;
+        if (split == TileSplit::kOneTile) {
+            tiles = touchedTiles(opBounds);
+            if (tiles.width() * tiles.height() <= 1) {
+                return;
+            }
+        } else if (split != TileSplit::kOneCanvas) {
+            return;
+        }
+        // Back to back barriers across every tile might as well be drawn together.
+        if (!barriers.empty() && barriers.back().end == begin &&
+            barriers.back().tiles == allTiles && tiles == allTiles) {
+            barriers.back().end = end;
+            return;
+        }
+        barriers.push_back({begin, end, tiles});
+    };
+
+    const int count = record.count();
+    TileSplitter splitter(SkMatrix::I(), drawablePicts, drawableCount);
+    int depth = 0,
+        blockBegin = 0;
+    TileSplit blockSplit = TileSplit::kAnyTiles;
+    for (int i = 0; i < count; i++) {
+        const int depthChange = record.visit(i, [](const auto& op) {
+            using T = std::decay_t<decltype(op)>;
+            if constexpr (std::is_same_v<T, SkRecords::Save> ||
+                          std::is_same_v<T, SkRecords::SaveLayer> ||
+                          std::is_same_v<T, SkRecords::SaveBehind>) {
+                return 1;
+            } else {
+                return std::is_same_v<T, SkRecords::Restore> ? -1 : 0;
+            }
+        });
+        const bool isDraw = record.visit(i, [](const auto& op) {
+            return (std::decay_t<decltype(op)>::kTags & SkRecords::kDraw_Tag) != 0;
+        });
+        const TileSplit split = record.visit(i, splitter);
+
+        if (depth == 0 && depthChange > 0) {
+            blockBegin = i;
+            blockSplit = split;
+        } else if (depth > 0) {
+            blockSplit = std::max(blockSplit, split);
+            if (depth + depthChange == 0) {
+                // SkRecordFillBounds() gives the Save the bounds of the whole block.
+                addBarrier(blockBegin, i + 1, blockSplit, bounds[blockBegin]);
+            }
+        } else if (depthChange == 0) {
+            if (split == TileSplit::kOneCanvas && !isDraw) {
+                addBarrier(i, count, split, bounds[i]);
+                return barriers;
+            }
+            if (isDraw) {
+                addBarrier(i, i + 1, split, bounds[i]);
+            } else {
+                topLevelState->push_back(i);
+            }
+        }
+        // A Restore with nothing to restore is ignored, as SkCanvas does.
+        depth = std::max(depth + depthChange, 0);
+    }
+    if (depth > 0) {
+        addBarrier(blockBegin, count, blockSplit, bounds[blockBegin]);
+    }
+    return barriers;
+}
+
+void SkRecordDrawTiled(const SkRecord& record,
+                       const SkRect& cullRect,
+                       SkPicture const* const drawablePicts[],
+                       int drawableCount,
+                       const SkBBoxHierarchy* bbh,
+                       const SkPixmap& dst,
+                       const SkSurfaceProps& props,
+                       SkISize tileSize,
+                       SkExecutor* executor) {
+    if (dst.bounds().isEmpty() || tileSize.isEmpty()) {
+        return;
+    }
+    const int tileW  = tileSize.width(),
+              tileH  = tileSize.height(),
+              tilesX = (dst.width() + tileW - 1) / tileW;
+
+    skia_private::AutoTArray<SkRect> bounds(record.count());
+    skia_private::AutoTMalloc<SkBBoxHierarchy::Metadata> meta(record.count());
+    SkRecordFillBounds(cullRect, record, bounds.data(), meta);
+
+    std::vector<int> topLevelState;
+    const std::vector<TileBarrier> barriers =
+            find_tile_barriers(record, cullRect, bounds.data(), drawablePicts, drawableCount,
+                               dst.dimensions(), tileSize, &topLevelState);
+    const std::vector<std::vector<int>> tileOps =
+            find_tile_ops(record, bounds.data(), bbh, dst.dimensions(), tileSize);
+
+    // Each tile's queue holds the ops it draws itself, or ~b for barrier b, in record order.
+    skia_private::AutoTArray<int> opBarrier(record.count());
+    std::fill(opBarrier.begin(), opBarrier.end(), -1);
+    std::vector<std::vector<int>> tileBarriers(tileOps.size());
+    for (int b = 0; b < (int)barriers.size(); b++) {
+        std::fill(opBarrier.begin() + barriers[b].begin, opBarrier.begin() + barriers[b].end, b);
+        const SkIRect& tiles = barriers[b].tiles;
+        for (int y = tiles.fTop; y < tiles.fBottom; y++) {
+            for (int x = tiles.fLeft; x < tiles.fRight; x++) {
+                tileBarriers[y * tilesX + x].push_back(b);
+            }
+        }
+    }
+    std::vector<std::vector<int>> queues(tileOps.size());
+    for (int tile = 0; tile < (int)tileOps.size(); tile++) {
+        auto b = tileBarriers[tile].begin();
+        for (int op : tileOps[tile]) {
+            for (; b != tileBarriers[tile].end() && barriers[*b].begin <= op; ++b) {
+                queues[tile].push_back(~*b);
+            }
+            if (opBarrier[op] < 0) {
+                queues[tile].push_back(op);
+            }
+        }
+        for (; b != tileBarriers[tile].end(); ++b) {
+            queues[tile].push_back(~*b);
+        }
+    }
+
+    // Replays the matrix and clip ops outside any block that come before op, leaving draw's
+    // canvas in the state op was recorded in.
+    auto replayStateBefore = [&](int op, SkRecords::Draw* draw) {
+        for (int state : topLevelState) {
+            if (state >= op) {
+                break;
+            }
+            record.visit(state, *draw);
+        }
+    };
+    auto tileRect = [&](int x, int y) {
+        return SkIRect::MakeXYWH(x * tileW, y * tileH, tileW, tileH);
+    };
+
+    // Every tile draws through its own canvas onto the shared pixels.  Geometry stays in device
+    // space and only the clip differs, which keeps every tile's writes disjoint.  A barrier is
+    // drawn by whichever of its tiles reaches it last, and then its tiles pick up after it, so
+    // tiles elsewhere keep drawing in the meantime.
+    struct Tile {
+        std::unique_ptr<SkCanvas>      canvas;
+        std::optional<SkRecords::Draw> draw;
+        size_t                         next = 0;
+    };
+    std::vector<Tile> tileState(queues.size());
+    std::unique_ptr<std::atomic<int>[]> arrivals(new std::atomic<int>[barriers.size()]);
+    for (int b = 0; b < (int)barriers.size(); b++) {
+        arrivals[b].store(barriers[b].tiles.width() * barriers[b].tiles.height(),
+                          std::memory_order_relaxed);
+    }
+
+    std::optional<SkTaskGroup> tg;
+    std::vector<int> pending;
+    std::function<void(int)> drawTile;
+    auto resume = [&](int tile) {
+        if (tg) {
+            tg->add([&drawTile, tile] { drawTile(tile); });
+        } else {
+            pending.push_back(tile);
+        }
+    };
+
+    drawTile = [&](int tile) {
+        const std::vector<int>& queue = queues[tile];
+        Tile& state = tileState[tile];
+        while (state.next < queue.size()) {
+            const int entry = queue[state.next++];
+            if (entry >= 0) {
+                if (!state.canvas) {
+                    SkBitmap bitmap;
+                    bitmap.installPixels(dst);
+                    state.canvas = std::make_unique<SkCanvas>(bitmap, props);
+                    state.canvas->clipIRect(tileRect(tile % tilesX, tile / tilesX));
+                    state.draw.emplace(state.canvas.get(), drawablePicts, nullptr, drawableCount);
+                    replayStateBefore(entry, &*state.draw);
+                }
+                record.visit(entry, *state.draw);
+                continue;
+            }
+
+            const TileBarrier& barrier = barriers[~entry];
+            if (arrivals[~entry].fetch_sub(1, std::memory_order_acq_rel) > 1) {
+                return;
+            }
+            {
+                SkBitmap bitmap;
+                bitmap.installPixels(dst);
+                SkCanvas canvas(bitmap, props);
+                canvas.clipIRect(SkIRect::MakeLTRB(barrier.tiles.fLeft  * tileW,
+                                                   barrier.tiles.fTop   * tileH,
+                                                   barrier.tiles.fRight * tileW,
+                                                   barrier.tiles.fBottom * tileH));
+                SkRecords::Draw draw(&canvas, drawablePicts, nullptr, drawableCount);
+                replayStateBefore(barrier.begin, &draw);
+                for (int op = barrier.begin; op < barrier.end; op++) {
+                    record.visit(op, draw);
+                }
+            }
+            // A tile's canvas was last used before the barrier, so its state needs no catching up.
+            for (int y = barrier.tiles.fTop; y < barrier.tiles.fBottom; y++) {
+                for (int x = barrier.tiles.fLeft; x < barrier.tiles.fRight; x++) {
+                    if (y * tilesX + x != tile) {
+                        resume(y * tilesX + x);
+                    }
+                }
+            }
+        }
+    };
+
+    if (executor) {
+        tg.emplace(*executor);
+    }
+    for (int tile = (int)queues.size(); tile-- > 0;) {
+        resume(tile);
+    }
+    if (tg) {
+        tg->wait();
+    } else {
+        while (!pending.empty()) {
+            const int tile = pending.back();
+            pending.pop_back();
+            drawTile(tile);
+        }
+    }
+}
+
+bool SkRecordDrawTiles(const SkRecord& record,
+                       const SkRect& cullRect,
+                       SkPicture const* const drawablePicts[],
+                       int drawableCount,
+                       const SkBBoxHierarchy* bbh,
+                       SkISize area,
+                       SkISize tileSize,
+                       SkSpan<const SkPixmap> tiles,
+                       const SkSurfaceProps& props,
+                       SkExecutor* executor) {
+    if (area.isEmpty() || tileSize.isEmpty()) {
+        return true;
+    }
+    // Drawing each tile at its own origin would move geometry relative to the pixel grid and
+    // the clip, which can change how it rasterizes.  Draw the whole area in place instead, then
+    // copy the tiles out of it.
+    SkBitmap whole;
+    if (!whole.tryAllocPixels(tiles[0].info().makeDimensions(area))) {
+        return false;
+    }
+    whole.eraseColor(SK_ColorTRANSPARENT);
+    SkRecordDrawTiled(record, cullRect, drawablePicts, drawableCount, bbh,
+                      whole.pixmap(), props, tileSize, executor);
+
+    const int tilesX = (area.width() + tileSize.width() - 1) / tileSize.width();
+    run_tiles((int)tiles.size(), executor, [&](int tile) {
+        whole.pixmap().readPixels(tiles[tile],
+                                  (tile % tilesX) * tileSize.width(),
+                                  (tile / tilesX) * tileSize.height());
+    });
+    return true;
+}
+
 namespace SkRecords {
 
 // NoOps draw nothing.
@@ -424,19 +922,19 @@ private:
     Bounds bounds(const DrawBehind&) const { return fCullRect; }
     Bounds bounds(const NoOp&)  const { return Bounds::MakeEmpty(); }    // NoOps don't draw.
 
-    Bounds bounds(const DrawRect& op) const { return this->adjustAndMap(op.rect, &op.paint); }
+    Bounds bounds(const DrawRect& op) const { return this->adjustAndMap(op.rect, op.paint.get()); }
     Bounds bounds(const DrawRegion& op) const {
         SkRect rect = SkRect::Make(op.region.getBounds());
-        return this->adjustAndMap(rect, &op.paint);
+        return this->adjustAndMap(rect, op.paint.get());
     }
-    Bounds bounds(const DrawOval& op) const { return this->adjustAndMap(op.oval, &op.paint); }
+    Bounds bounds(const DrawOval& op) const { return this->adjustAndMap(op.oval, op.paint.get()); }
     // Tighter arc bounds?
-    Bounds bounds(const DrawArc& op) const { return this->adjustAndMap(op.oval, &op.paint); }
+    Bounds bounds(const DrawArc& op) const { return this->adjustAndMap(op.oval, op.paint.get()); }
     Bounds bounds(const DrawRRect& op) const {
-        return this->adjustAndMap(op.rrect.rect(), &op.paint);
+        return this->adjustAndMap(op.rrect.rect(), op.paint.get());
     }
     Bounds bounds(const DrawDRRect& op) const {
-        return this->adjustAndMap(op.outer.rect(), &op.paint);
+        return this->adjustAndMap(op.outer.rect(), op.paint.get());
     }
     Bounds bounds(const DrawImage& op) const {
         const SkImage* image = op.image.get();
@@ -451,27 +949,28 @@ private:
         return this->adjustAndMap(op.dst, op.paint);
     }
     Bounds bounds(const DrawPath& op) const {
-        return op.path.isInverseFillType() ? fCullRect
-                                           : this->adjustAndMap(op.path.getBounds(), &op.paint);
+        return op.path->isInverseFillType()
+                       ? fCullRect
+                       : this->adjustAndMap(op.path->getBounds(), op.paint.get());
     }
     Bounds bounds(const DrawPoints& op) const {
         SkRect dst = SkRect::BoundsOrEmpty({op.pts.data(), op.count});
 
         // Pad the bounding box a little to make sure hairline points' bounds aren't empty.
-        SkScalar stroke = std::max(op.paint.getStrokeWidth(), 0.01f);
+        SkScalar stroke = std::max(op.paint->getStrokeWidth(), 0.01f);
         dst.outset(stroke/2, stroke/2);
 
-        return this->adjustAndMap(dst, &op.paint);
+        return this->adjustAndMap(dst, op.paint.get());
     }
     Bounds bounds(const DrawPatch& op) const {
         const auto dst = SkRect::BoundsOrEmpty({op.cubics.data(), (size_t)SkPatchUtils::kNumCtrlPts});
-        return this->adjustAndMap(dst, &op.paint);
+        return this->adjustAndMap(dst, op.paint.get());
     }
     Bounds bounds(const DrawVertices& op) const {
-        return this->adjustAndMap(op.vertices->bounds(), &op.paint);
+        return this->adjustAndMap(op.vertices->bounds(), op.paint.get());
     }
     Bounds bounds(const DrawMesh& op) const {
-        return this->adjustAndMap(op.mesh.bounds(), &op.paint);
+        return this->adjustAndMap(op.mesh.bounds(), op.paint.get());
     }
     Bounds bounds(const DrawAtlas& op) const {
         if (op.cull) {
@@ -498,12 +997,12 @@ private:
     Bounds bounds(const DrawTextBlob& op) const {
         SkRect dst = op.blob->bounds();
         dst.offset(op.x, op.y);
-        return this->adjustAndMap(dst, &op.paint);
+        return this->adjustAndMap(dst, op.paint.get());
     }
 
     Bounds bounds(const DrawSlug& op) const {
         SkRect dst = op.slug->sourceBoundsWithOrigin();
-        return this->adjustAndMap(dst, &op.paint);
+        return this->adjustAndMap(dst, op.paint.get());
     }
 
     Bounds bounds(const DrawDrawable& op) const {
@@ -12,10 +12,15 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkM44.h"
 #include "include/core/SkPicture.h"
+#include "include/core/SkSpan.h"
 #include "include/private/SkNoncopyable.h"
 
 class SkDrawable;
+class SkExecutor;
+class SkPixmap;
 class SkRecord;
+class SkSurfaceProps;
+struct SkISize;
 struct SkRect;
 
 // Calculate conservative identity space bounds for each op in the record.
@@ -27,6 +32,29 @@ void SkRecordDraw(const SkRecord&, SkCanvas*, SkPicture const* const drawablePic
                   SkDrawable* const drawables[], int drawableCount,
                   const SkBBoxHierarchy*, SkPicture::AbortCallback*);
 
+// Rasterize an SkRecord into dst by splitting dst into tiles of tileSize and drawing the tiles
+// concurrently on executor (or serially if executor is null).  Each tile's ops are found with one
+// batched search of bbh, or if there is none, by binning each op into the tiles touched by its
+// SkRecordFillBounds() bounds.  Each tile replays its ops in record order into a canvas clipped
+// to that tile.  Ops that would rasterize differently under the tile's clip, like paths crossing
+// tile edges and image filters, are instead drawn on one canvas covering the tiles they touch,
+// along with the rest of their outermost Save/Restore block, once those tiles have drawn the ops
+// before them.  The result matches SkRecordDraw() into the same pixels.
+void SkRecordDrawTiled(const SkRecord&, const SkRect& cullRect,
+                       SkPicture const* const drawablePicts[], int drawableCount,
+                       const SkBBoxHierarchy*, const SkPixmap& dst, const SkSurfaceProps&,
+                       SkISize tileSize, SkExecutor*);
+
+// Like SkRecordDrawTiled(), but copies each tile of the grid covering area into its own pixels.
+// tiles has a pixmap for each tile in row-major order, sized to the part of the tile in area.
+// The whole area is drawn into scratch pixels of the first tile's format, cleared first, so each
+// tile matches the same part of SkRecordDraw() into pixels of area's size.  Returns false if the
+// scratch pixels could not be allocated.
+bool SkRecordDrawTiles(const SkRecord&, const SkRect& cullRect,
+                       SkPicture const* const drawablePicts[], int drawableCount,
+                       const SkBBoxHierarchy*, SkISize area, SkISize tileSize,
+                       SkSpan<const SkPixmap> tiles, const SkSurfaceProps&, SkExecutor*);
+
 namespace SkRecords {
 
 // This is an SkRecord visitor that will draw that SkRecord to an SkCanvas.
@@ -10,18 +10,28 @@
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkM44.h"
+#include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkRegion.h"
 #include "include/private/SkMath.h"
 #include "include/private/SkTemplates.h"
 #include "src/core/SkRecord.h"
+#include "src/core/SkRecordDraw.h"
 #include "src/core/SkRecordPattern.h"
 #include "src/core/SkRecords.h"
+#include "src/core/SkRectPriv.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <optional>
+#include <type_traits>
+#include <vector>
 
 using namespace SkRecords;
+using namespace skia_private;
 
 // Most of the optimizations in this file are pattern-based.  These are all defined as structs with:
 //   - a Match typedef
@@ -172,7 +182,7 @@ struct SaveLayerDrawRestoreNooper {
 
         // A SaveLayer's bounds field is just a hint, so we should be free to ignore it.
         SkPaint* layerPaint = match->first<SaveLayer>()->paint;
-        SkPaint* drawPaint = match->second<SkPaint>();
+        const SkPaint* drawPaint = match->second<const SkPaint>();
 
         if (nullptr == layerPaint && effectively_srcover(drawPaint)) {
             // There wasn't really any point to this SaveLayer at all.
@@ -185,13 +195,31 @@ struct SaveLayerDrawRestoreNooper {
             return false;
         }
 
-        if (!fold_opacity_layer_color_to_paint(layerPaint, false /*isSaveLayer*/, drawPaint)) {
+        // The draw's paint may be shared with other draws, so fold into a copy.
+        SkPaint foldedPaint = *drawPaint;
+        if (!fold_opacity_layer_color_to_paint(layerPaint, false /*isSaveLayer*/, &foldedPaint)) {
             return false;
         }
+        SetPaint setPaint{record, foldedPaint};
+        record->mutate(begin+1, setPaint);
 
         return KillSaveLayerAndRestore(record, begin);
     }
 
+    // Gives a draw a new paint, interning it if the draw's paint is interned.
+    struct SetPaint {
+        SkRecord* record;
+        const SkPaint& paint;
+
+        template <typename T> void operator()(T* draw) {
+            if constexpr ((T::kTags & kHasPaint_Tag) != 0) {
+                this->set(&draw->paint);
+            }
+        }
+        void set(Optional<SkPaint>* dst) { **dst = paint; }
+        void set(Interned<SkPaint>* dst) { *dst = record->intern(paint); }
+    };
+
     static bool KillSaveLayerAndRestore(SkRecord* record, int saveLayerIndex) {
         record->replace<NoOp>(saveLayerIndex);    // SaveLayer
         record->replace<NoOp>(saveLayerIndex+2);  // Restore
@@ -286,3 +314,335 @@ void SkRecordOptimize(SkRecord* record) {
 
     record->defrag();
 }
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+// The passes below are not pattern-based.  They walk the whole record once, following the matrix
+// and clip that each op will be drawn with.
+
+namespace {
+
+// Tracks the matrix and clip of each op, relative to the canvas the record is played back into.
+class MatrixClipTracker {
+public:
+    struct State {
+        SkMatrix matrix;
+        // Contains the clip.  Unknown clips from the playback canvas are treated as unbounded.
+        SkRect   clipBounds = SkRectPriv::MakeLargest();
+        // The clip is exactly clipBounds (intersected with the playback canvas' clip).
+        bool     clipIsRect = true;
+        // An antialiased clip may be in effect.
+        bool     clipIsAA = false;
+        // Each SaveLayer starts a new layer.  Negative for layers that may not be drawn on the
+        // pixel grid of the canvas they're played back into, e.g. because of an image filter.
+        int      layer = 0;
+    };
+
+    MatrixClipTracker() { fStates.push_back({}); }
+
+    // The state op i of the record is drawn with, after calling update() for ops [0, i).
+    const State& state() const { return fStates.back(); }
+    int layerCount() const { return fLayerCount + 1; }
+
+    void update(const SkRecord& record, int i) { record.visit(i, *this); }
+
+    template <typename T> void operator()(const T&) {}
+
+    void operator()(const Save&)       { this->push(); }
+    void operator()(const SaveBehind&) { this->push(); }
+    void operator()(const SaveLayer& op) {
+        const bool hasFilters = (op.paint && op.paint->getImageFilter()) ||
+                                !op.filters.empty() || op.backdrop;
+        const int parent = fStates.back().layer;
+        this->push();
+        fStates.back().layer = (parent < 0 || hasFilters) ? -1 : ++fLayerCount;
+    }
+    void operator()(const Restore&) {
+        if (fStates.size() > 1) {
+            fStates.pop_back();
+        }
+    }
+
+    void operator()(const SetMatrix& op) { fStates.back().matrix = op.matrix; }
+    void operator()(const SetM44& op)    { fStates.back().matrix = op.matrix.asM33(); }
+    void operator()(const Concat& op)    { fStates.back().matrix.preConcat(op.matrix); }
+    void operator()(const Concat44& op)  { fStates.back().matrix.preConcat(op.matrix.asM33()); }
+    void operator()(const Translate& op) { fStates.back().matrix.preTranslate(op.dx, op.dy); }
+    void operator()(const Scale& op)     { fStates.back().matrix.preScale(op.sx, op.sy); }
+
+    void operator()(const ClipRect& op) { this->clip(op.rect, op.opAA, true); }
+    void operator()(const ClipRRect& op) {
+        this->clip(op.rrect.getBounds(), op.opAA, op.rrect.isRect());
+    }
+    void operator()(const ClipPath& op) {
+        if (op.path->isInverseFillType()) {
+            fStates.back().clipIsRect = false;
+            fStates.back().clipIsAA |= op.opAA.aa();
+        } else {
+            this->clip(op.path->getBounds(), op.opAA, false);
+        }
+    }
+    void operator()(const ClipRegion&) {
+        // Regions are in device space, which need not be our space if the playback canvas has a
+        // matrix, so we only know that the clip got more complicated.
+        fStates.back().clipIsRect = false;
+    }
+    void operator()(const ClipShader&) {
+        fStates.back().clipIsRect = false;
+        fStates.back().clipIsAA = true;
+    }
+    void operator()(const ResetClip&) {
+        State& state = fStates.back();
+        state.clipBounds = SkRectPriv::MakeLargest();
+        state.clipIsRect = true;
+        state.clipIsAA = false;
+    }
+
+private:
+    void push() { fStates.push_back(fStates.back()); }
+
+    void clip(const SkRect& rect, ClipOpAndAA opAA, bool isRect) {
+        State& state = fStates.back();
+        state.clipIsAA |= opAA.aa();
+        if (opAA.op() != SkClipOp::kIntersect || state.matrix.hasPerspective()) {
+            // A difference only shrinks the clip, so clipBounds still contains it.
+            state.clipIsRect = false;
+            return;
+        }
+        if (!state.clipBounds.intersect(state.matrix.mapRect(rect))) {
+            state.clipBounds.setEmpty();
+        }
+        state.clipIsRect &= isRect && state.matrix.rectStaysRect();
+    }
+
+    std::vector<State> fStates;
+    int fLayerCount = 0;
+};
+
+}  // namespace
+
+// A non-antialiased intersect ClipRect changes nothing if it contains the clip it intersects,
+// no matter what matrix the record is played back with.
+void SkRecordNoopRedundantClipRects(SkRecord* record) {
+    MatrixClipTracker tracker;
+    for (int i = 0; i < record->count(); i++) {
+        const MatrixClipTracker::State& state = tracker.state();
+        bool redundant = false;
+        record->visit(i, [&](const auto& op) {
+            using T = std::decay_t<decltype(op)>;
+            if constexpr (std::is_same_v<T, ClipRect>) {
+                redundant = !op.opAA.aa() && op.opAA.op() == SkClipOp::kIntersect &&
+                            !state.clipIsAA && state.matrix.rectStaysRect() &&
+                            state.matrix.mapRect(op.rect).contains(state.clipBounds);
+            }
+        });
+        tracker.update(*record, i);
+        if (redundant) {
+            record->replace<NoOp>(i);
+        }
+    }
+}
+
+// Can a draw with this paint be counted on to cover every pixel inside its geometry with an
+// opaque color, without reading what's under it?
+static bool is_opaque_fill(const SkPaint& paint) {
+    return paint.getAlphaf() == 1 && paint.getStyle() == SkPaint::kFill_Style &&
+           !paint.getShader() && !paint.getColorFilter() && !paint.getMaskFilter() &&
+           !paint.getPathEffect() && !paint.getImageFilter() &&
+           (paint.isSrcOver() || paint.asBlendMode() == SkBlendMode::kSrc);
+}
+
+namespace {
+
+// Finds the pixels an op is sure to cover with an opaque color.
+struct OcclusionFinder {
+    const MatrixClipTracker::State& state;
+    const SkRect& cullRect;
+
+    // The whole pixels inside both devRect and the clip, if the clip is exactly a rect.
+    SkIRect cover(const SkRect& devRect) const {
+        SkRect r = devRect;
+        if (!state.clipIsRect || !r.intersect(state.clipBounds) || !r.intersect(cullRect)) {
+            return SkIRect::MakeEmpty();
+        }
+        return r.roundIn();
+    }
+
+    template <typename T> SkIRect operator()(const T&) const { return SkIRect::MakeEmpty(); }
+
+    SkIRect operator()(const DrawRect& op) const {
+        if (!is_opaque_fill(op.paint) || !state.matrix.rectStaysRect()) {
+            return SkIRect::MakeEmpty();
+        }
+        return this->cover(state.matrix.mapRect(op.rect.makeSorted()));
+    }
+    SkIRect operator()(const DrawPaint& op) const {
+        return is_opaque_fill(op.paint) ? this->cover(cullRect) : SkIRect::MakeEmpty();
+    }
+};
+
+}  // namespace
+
+// Can earlier draws be culled by later ones, if this op comes between them?
+template <typename T>
+static bool is_occlusion_barrier(const T& op) {
+    // Backdrops and layers initialized from the previous layer read pixels that may be outside
+    // the later draw, as may the draws behind and nested pictures or drawables.
+    if constexpr (std::is_same_v<T, SaveLayer>) {
+        return op.backdrop || (op.saveLayerFlags & SkCanvas::kInitWithPrevious_SaveLayerFlag);
+    }
+    return std::is_same_v<T, SaveBehind> || std::is_same_v<T, DrawBehind> ||
+           std::is_same_v<T, DrawPicture> || std::is_same_v<T, DrawDrawable>;
+}
+
+// Can this op be turned into a NoOp when it's covered?
+template <typename T>
+static bool is_cullable(const T&) {
+    return (T::kTags & kDraw_Tag) && !std::is_same_v<T, DrawAnnotation> &&
+           !std::is_same_v<T, DrawBehind> && !std::is_same_v<T, DrawPicture> &&
+           !std::is_same_v<T, DrawDrawable>;
+}
+
+// Draws covered by later opaque rects or paints in the same layer are turned into NoOps.  Which
+// pixels are covered is worked out on the record's own pixel grid, so this is only exact when the
+// record is played back with an integer translate.
+void SkRecordNoopOccludedDraws(SkRecord* record, const SkRect& cullRect) {
+    const int count = record->count();
+    AutoTArray<SkRect> bounds(count);
+    AutoTMalloc<SkBBoxHierarchy::Metadata> meta(count);
+    SkRecordFillBounds(cullRect, *record, bounds.data(), meta);
+
+    struct OpInfo {
+        SkIRect cover;
+        int     layer;
+        bool    barrier;
+        bool    cullable;
+    };
+    AutoTArray<OpInfo> infos(count);
+    MatrixClipTracker tracker;
+    for (int i = 0; i < count; i++) {
+        const MatrixClipTracker::State& state = tracker.state();
+        OpInfo& info = infos[i];
+        info.layer = state.layer;
+        info.cover = state.layer < 0 ? SkIRect::MakeEmpty()
+                                     : record->visit(i, OcclusionFinder{state, cullRect});
+        record->visit(i, [&](const auto& op) {
+            info.barrier = is_occlusion_barrier(op);
+            info.cullable = is_cullable(op);
+        });
+        tracker.update(*record, i);
+    }
+
+    // Walk backwards, remembering the largest few opaque areas drawn later in each layer.
+    constexpr int kMaxOccluders = 8;
+    std::vector<std::vector<SkIRect>> occluders(tracker.layerCount());
+    for (int i = count - 1; i >= 0; i--) {
+        const OpInfo& info = infos[i];
+        if (info.cullable && info.layer >= 0) {
+            const SkIRect drawn = bounds[i].roundOut();
+            const std::vector<SkIRect>& layer = occluders[info.layer];
+            if (std::any_of(layer.begin(), layer.end(),
+                            [&](const SkIRect& occluder) { return occluder.contains(drawn); })) {
+                record->replace<NoOp>(i);
+                continue;
+            }
+        }
+        if (info.barrier) {
+            for (std::vector<SkIRect>& layer : occluders) {
+                layer.clear();
+            }
+        }
+        if (info.cover.isEmpty()) {
+            continue;
+        }
+        std::vector<SkIRect>& layer = occluders[info.layer];
+        if ((int)layer.size() < kMaxOccluders) {
+            layer.push_back(info.cover);
+        } else {
+            auto area = [](const SkIRect& r) { return r.width64() * r.height64(); };
+            auto smallest = std::min_element(layer.begin(), layer.end(),
+                                             [&](const SkIRect& a, const SkIRect& b) {
+                                                 return area(a) < area(b);
+                                             });
+            if (area(*smallest) < area(info.cover)) {
+                *smallest = info.cover;
+            }
+        }
+    }
+}
+
+// Can a run of DrawRects with this paint be drawn as one region?
+static bool is_mergeable_rect_paint(const SkPaint& paint) {
+    return !paint.isAntiAlias() && paint.getStyle() == SkPaint::kFill_Style &&
+           !paint.getPathEffect() && !paint.getMaskFilter() && !paint.getImageFilter();
+}
+
+// Runs of pixel-aligned, non-overlapping DrawRects with the same non-antialiased paint are merged
+// into a single DrawRegion.  The region is drawn one rect at a time, or as its boundary path
+// under matrices that aren't translates, either of which touches the same pixels as the rects.
+void SkRecordMergeDrawRects(SkRecord* record) {
+    int first = -1;                   // Where the current run starts, or -1.
+    const DrawRect* firstDraw = nullptr;
+    int merged = 0;                   // How many DrawRects are in the current run.
+    SkRegion region;                  // What the current run covers.
+
+    const SkIRect large = SkRectPriv::MakeILarge();
+    for (int i = 0; i <= record->count(); i++) {
+        const DrawRect* draw = nullptr;
+        bool isNoOp = false;
+        if (i < record->count()) {
+            record->visit(i, [&](const auto& op) {
+                using T = std::decay_t<decltype(op)>;
+                if constexpr (std::is_same_v<T, DrawRect>) {
+                    draw = &op;
+                }
+                isNoOp = std::is_same_v<T, NoOp>;
+            });
+        }
+        if (isNoOp) {
+            continue;
+        }
+
+        SkIRect irect = SkIRect::MakeEmpty();
+        bool mergeable = draw && is_mergeable_rect_paint(draw->paint) &&
+                         draw->rect.isFinite() && draw->rect.isSorted();
+        if (mergeable) {
+            irect = draw->rect.roundOut();
+            mergeable = !irect.isEmpty() && large.contains(irect) &&
+                        SkRect::Make(irect) == draw->rect;
+        }
+
+        if (first >= 0) {
+            // Paints are interned, so equal paints are the same paint.
+            if (mergeable && draw->paint.get() == firstDraw->paint.get() &&
+                !region.intersects(irect)) {
+                region.op(irect, SkRegion::kUnion_Op);
+                record->replace<NoOp>(i);
+                merged++;
+                continue;
+            }
+            if (merged > 1) {
+                const Interned<SkPaint> paint = firstDraw->paint;
+                new (record->replace<DrawRegion>(first)) DrawRegion{paint, region};
+            }
+            first = -1;
+        }
+
+        if (mergeable) {
+            first = i;
+            firstDraw = draw;
+            merged = 1;
+            region.setRect(irect);
+        }
+    }
+}
+
+void SkRecordOptimizeForPlayback(SkRecord* record, const SkRect& cullRect) {
+    SkRecordOptimize(record);
+
+    SkRecordNoopRedundantClipRects(record);
+    SkRecordNoopOccludedDraws(record, cullRect);
+    SkRecordMergeDrawRects(record);
+
+    record->defrag();
+}
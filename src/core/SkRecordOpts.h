@@ -9,6 +9,7 @@
 #define SkRecordOpts_DEFINED
 
 class SkRecord;
+struct SkRect;
 
 // Run all optimizations in recommended order.
 void SkRecordOptimize(SkRecord*);
@@ -26,4 +27,19 @@ void SkRecordNoopSaveLayerDrawRestores(SkRecord*);
 // the alpha of the first SaveLayer to the second SaveLayer.
 void SkRecordMergeSvgOpacityAndFilterLayers(SkRecord*);
 
+// Run SkRecordOptimize() and then the costlier passes below, which make playback cheaper.
+// SkRecordNoopOccludedDraws() makes the result exact only for integer translate playback.
+void SkRecordOptimizeForPlayback(SkRecord*, const SkRect& cullRect);
+
+// Turns non-antialiased intersect ClipRects that contain the clip they intersect into no-ops.
+void SkRecordNoopRedundantClipRects(SkRecord*);
+
+// Turns draws covered by a later opaque DrawRect or DrawPaint in the same layer into no-ops.
+// Coverage is judged on the record's own pixel grid.
+void SkRecordNoopOccludedDraws(SkRecord*, const SkRect& cullRect);
+
+// Merges runs of pixel-aligned, non-overlapping, non-antialiased DrawRects that share a paint
+// into one DrawRegion.
+void SkRecordMergeDrawRects(SkRecord*);
+
 #endif//SkRecordOpts_DEFINED
@@ -45,7 +45,7 @@ class IsDraw {
 public:
     IsDraw() : fPaint(nullptr) {}
 
-    SkPaint* get() { return fPaint; }
+    const SkPaint* get() { return fPaint; }
 
     template <typename T>
     std::enable_if_t<(T::kTags & kDrawWithPaint_Tag) == kDrawWithPaint_Tag, bool>
@@ -67,11 +67,11 @@ public:
     }
 
 private:
-    // Abstracts away whether the paint is always part of the command or optional.
-    template <typename T> static T* AsPtr(SkRecords::Optional<T>& x) { return x; }
-    template <typename T> static T* AsPtr(T& x) { return &x; }
+    // Abstracts away whether the paint is interned or optional.
+    template <typename T> static const T* AsPtr(SkRecords::Optional<T>& x) { return x; }
+    template <typename T> static const T* AsPtr(SkRecords::Interned<T>& x) { return x.get(); }
 
-    SkPaint* fPaint;
+    const SkPaint* fPaint;
 };
 
 // Matches any command that draws *once* (logically), and stores its paint.
@@ -79,7 +79,7 @@ class IsSingleDraw {
 public:
     IsSingleDraw() : fPaint(nullptr) {}
 
-    SkPaint* get() { return fPaint; }
+    const SkPaint* get() { return fPaint; }
 
     template <typename T>
     std::enable_if_t<(T::kTags & kDrawWithPaint_Tag) == kDrawWithPaint_Tag &&
@@ -107,11 +107,11 @@ public:
     }
 
 private:
-    // Abstracts away whether the paint is always part of the command or optional.
-    template <typename T> static T* AsPtr(SkRecords::Optional<T>& x) { return x; }
-    template <typename T> static T* AsPtr(T& x) { return &x; }
+    // Abstracts away whether the paint is interned or optional.
+    template <typename T> static const T* AsPtr(SkRecords::Optional<T>& x) { return x; }
+    template <typename T> static const T* AsPtr(SkRecords::Interned<T>& x) { return x.get(); }
 
-    SkPaint* fPaint;
+    const SkPaint* fPaint;
 };
 
 // Matches if Matcher doesn't.  Stores nothing.
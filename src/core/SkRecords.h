@@ -142,6 +142,24 @@ private:
 
 #undef ACT_AS_PTR
 
+// Interned points to a paint or path owned by the SkRecord, shared by every op that recorded an
+// identical one (see SkRecord::intern()).  It doesn't own or destroy what it points to, and can
+// be used wherever a const T& is expected.
+template <typename T>
+class Interned {
+public:
+    Interned() : fPtr(nullptr) {}
+    Interned(const T* ptr) : fPtr(ptr) {}
+    // Default copy and assign.
+
+    operator const T&() const { return *fPtr; }
+    const T* operator->() const { return fPtr; }
+    const T* get() const { return fPtr; }
+
+private:
+    const T* fPtr;
+};
+
 // Like SkPath::getBounds(), SkMatrix::getType() isn't thread safe unless we precache it.
 // This may not cover all SkMatrices used by the picture (e.g. some could be hiding in a shader).
 struct TypedMatrix : public SkMatrix {
@@ -222,7 +240,7 @@ private:
 static_assert(sizeof(ClipOpAndAA) == 4, "ClipOpAndAASize");
 
 RECORD(ClipPath, 0,
-        SkPath path;
+        Interned<SkPath> path;
         ClipOpAndAA opAA)
 RECORD(ClipRRect, 0,
         SkRRect rrect;
@@ -240,13 +258,13 @@ RECORD_TRIVIAL(ResetClip, 0)
 
 // While not strictly required, if you have an SkPaint, it's fastest to put it first.
 RECORD(DrawArc, kDraw_Tag|kHasPaint_Tag,
-       SkPaint paint;
+       Interned<SkPaint> paint;
        SkRect oval;
        SkScalar startAngle;
        SkScalar sweepAngle;
        unsigned useCenter)
 RECORD(DrawDRRect, kDraw_Tag|kHasPaint_Tag,
-        SkPaint paint;
+        Interned<SkPaint> paint;
         SkRRect outer;
         SkRRect inner)
 RECORD(DrawDrawable, kDraw_Tag,
@@ -280,43 +298,43 @@ RECORD(DrawImageRect, kDraw_Tag|kHasImage_Tag|kHasPaint_Tag,
         SkSamplingOptions sampling;
         SkCanvas::SrcRectConstraint constraint)
 RECORD(DrawOval, kDraw_Tag|kHasPaint_Tag,
-        SkPaint paint;
+        Interned<SkPaint> paint;
         SkRect oval)
 RECORD(DrawPaint, kDraw_Tag|kHasPaint_Tag,
-        SkPaint paint)
+        Interned<SkPaint> paint)
 RECORD(DrawBehind, kDraw_Tag|kHasPaint_Tag,
-       SkPaint paint)
+       Interned<SkPaint> paint)
 RECORD(DrawPath, kDraw_Tag|kHasPaint_Tag,
-        SkPaint paint;
-        SkPath path)
+        Interned<SkPaint> paint;
+        Interned<SkPath> path)
 RECORD(DrawPicture, kDraw_Tag|kHasPaint_Tag,
         Optional<SkPaint> paint;
         sk_sp<const SkPicture> picture;
         TypedMatrix matrix)
 RECORD(DrawPoints, kDraw_Tag|kHasPaint_Tag|kMultiDraw_Tag,
-        SkPaint paint;
+        Interned<SkPaint> paint;
         SkCanvas::PointMode mode;
         unsigned count;
         PODArray<SkPoint> pts)
 RECORD(DrawRRect, kDraw_Tag|kHasPaint_Tag,
-        SkPaint paint;
+        Interned<SkPaint> paint;
         SkRRect rrect)
 RECORD(DrawRect, kDraw_Tag|kHasPaint_Tag,
-        SkPaint paint;
+        Interned<SkPaint> paint;
         SkRect rect)
 RECORD(DrawRegion, kDraw_Tag|kHasPaint_Tag,
-        SkPaint paint;
+        Interned<SkPaint> paint;
         SkRegion region)
 RECORD(DrawTextBlob, kDraw_Tag|kHasText_Tag|kHasPaint_Tag,
-        SkPaint paint;
+        Interned<SkPaint> paint;
         sk_sp<const SkTextBlob> blob;
         SkScalar x;
         SkScalar y)
 RECORD(DrawSlug, kDraw_Tag|kHasText_Tag|kHasPaint_Tag,
-       SkPaint paint;
+       Interned<SkPaint> paint;
        sk_sp<const sktext::gpu::Slug> slug)
 RECORD(DrawPatch, kDraw_Tag|kHasPaint_Tag,
-        SkPaint paint;
+        Interned<SkPaint> paint;
         PODArray<SkPoint> cubics;
         PODArray<SkColor> colors;
         PODArray<SkPoint> texCoords;
@@ -332,15 +350,15 @@ RECORD(DrawAtlas, kDraw_Tag|kHasImage_Tag|kHasPaint_Tag|kMultiDraw_Tag,
         SkSamplingOptions sampling;
         Optional<SkRect> cull)
 RECORD(DrawVertices, kDraw_Tag|kHasPaint_Tag|kMultiDraw_Tag,
-        SkPaint paint;
+        Interned<SkPaint> paint;
         sk_sp<SkVertices> vertices;
         SkBlendMode bmode)
 RECORD(DrawMesh, kDraw_Tag|kHasPaint_Tag|kMultiDraw_Tag,
-       SkPaint paint;
+       Interned<SkPaint> paint;
        SkMesh mesh;
        sk_sp<SkBlender> blender)
 RECORD(DrawShadowRec, kDraw_Tag,
-       SkPath path;
+       Interned<SkPath> path;
        SkDrawShadowRec rec)
 RECORD(DrawAnnotation, 0,  // TODO: kDraw_Tag, skbug.com/40036727
        SkRect rect;
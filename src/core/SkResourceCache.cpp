@@ -33,10 +33,11 @@ using namespace skia_private;
 DECLARE_SKMESSAGEBUS_MESSAGE(SkResourceCache::PurgeSharedIDMessage, uint32_t, true)
 
 static inline bool SkShouldPostMessageToBus(
-        const SkResourceCache::PurgeSharedIDMessage&, uint32_t) {
-    // SkResourceCache is typically used as a singleton and we don't label Inboxes so all messages
-    // go to all inboxes.
-    return true;
+        const SkResourceCache::PurgeSharedIDMessage& msg, uint32_t inboxID) {
+    // Unlabeled inboxes get every message. The shards of an SkSynchronizedResourceCache only get
+    // the messages for shared IDs they may hold.
+    return inboxID == SK_InvalidUniqueID ||
+           inboxID == SkSynchronizedResourceCache::PurgeInboxIDForSharedID(msg.fSharedID);
 }
 
 // This can be defined by the caller's build system
@@ -93,6 +94,7 @@ void SkResourceCache::init() {
     fHash = new Hash;
     fTotalBytesUsed = 0;
     fCount = 0;
+    fDiscardableCountLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
     fSingleAllocationByteLimit = 0;
 
     // One of these should be explicit set by the caller after we return.
@@ -112,6 +114,15 @@ SkResourceCache::SkResourceCache(size_t byteLimit)
     fTotalByteLimit = byteLimit;
 }
 
+SkResourceCache::SkResourceCache(DiscardableFactory factory, size_t byteLimit,
+                                 uint32_t purgeInboxID, int shardCount)
+        : fPurgeSharedIDInbox(purgeInboxID) {
+    this->init();
+    fDiscardableFactory = factory;
+    fTotalByteLimit = byteLimit;
+    fDiscardableCountLimit = std::max(1, fDiscardableCountLimit / shardCount);
+}
+
 SkResourceCache::~SkResourceCache() {
     Rec* rec = fHead;
     while (rec) {
@@ -215,7 +226,7 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
     int    countLimit;
 
     if (fDiscardableFactory) {
-        countLimit = SK_DISCARDABLEMEMORY_SCALEDIMAGECACHE_COUNT_LIMIT;
+        countLimit = fDiscardableCountLimit;
         byteLimit = UINT32_MAX;  // no limit based on bytes
     } else {
         countLimit = SK_MaxS32; // no limit based on count
@@ -236,6 +247,20 @@ void SkResourceCache::purgeAsNeeded(bool forcePurge) {
     }
 }
 
+size_t SkResourceCache::purgeBytes(size_t bytesNeeded) {
+    size_t bytesFreed = 0;
+    Rec* rec = fTail;
+    while (rec && bytesFreed < bytesNeeded) {
+        Rec* prev = rec->fPrev;
+        if (rec->canBePurged()) {
+            bytesFreed += rec->bytesUsed();
+            this->remove(rec);
+        }
+        rec = prev;
+    }
+    return bytesFreed;
+}
+
 //#define SK_TRACK_PURGE_SHAREDID_HITRATE
 
 #ifdef SK_TRACK_PURGE_SHAREDID_HITRATE
@@ -27,6 +27,7 @@ class SkTraceMemoryDump;
  *
  *  As a convenience, a global instance is also defined, which can be safely
  *  access across threads via the static methods (e.g. FindAndLock, etc.).
+ *  See SkSynchronizedResourceCache.
  */
 class SkResourceCache {
 public:
@@ -260,6 +261,15 @@ public:
     virtual void dump() const;
 
 private:
+    friend class SkSynchronizedResourceCache;
+
+    /**
+     *  Used by SkSynchronizedResourceCache for itself and its shards. The inbox only receives
+     *  purge messages for shared IDs routed to purgeInboxID, and a discardable cache keeps
+     *  1/shardCount of the default count limit.
+     */
+    SkResourceCache(DiscardableFactory, size_t byteLimit, uint32_t purgeInboxID, int shardCount);
+
     Rec*    fHead;
     Rec*    fTail;
 
@@ -272,11 +282,15 @@ private:
     size_t  fTotalByteLimit;
     size_t  fSingleAllocationByteLimit;
     int     fCount;
+    int     fDiscardableCountLimit;
 
     SkMessageBus<PurgeSharedIDMessage, uint32_t>::Inbox fPurgeSharedIDInbox;
 
-    void checkMessages();
+    virtual void checkMessages();
     void purgeAsNeeded(bool forcePurge = false);
+    // Removes least recently used Recs until at least bytesNeeded are freed, or no more Recs can
+    // be purged. Returns the number of bytes freed.
+    size_t purgeBytes(size_t bytesNeeded);
 
     // linklist management
     void moveToHead(Rec*);
@@ -11,9 +11,11 @@
 
 #include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkSpan.h"
 #include "include/private/SkFixed.h"
 
 class SkBlitter;
+class SkExecutor;
 class SkPath;
 struct SkPathRaw;
 class SkRasterClip;
@@ -54,6 +56,17 @@ public:
     static void FillPath(const SkPathRaw&, const SkRegion& clip, SkBlitter*);
     static void AntiFillPath(const SkPathRaw&, const SkRasterClip&, SkBlitter*);
 
+    // Whether AntiFillPathInBands() can fill this path within a rectangular clip. It takes paths
+    // made of lines that are neither inverse filled nor known to be convex, and big enough to skip
+    // the coverage mask AntiFillPath() would use for small ones.
+    static bool CanAntiFillPathInBands(const SkPathRaw&, const SkIRect& clip);
+    // Fills the path as AntiFillPath() would, blitting the rows of band i, which starts at
+    // firstBandTop + i * bandHeight, into blitters[i] on the executor's threads. Each band's
+    // coverage matches the single fill's exactly. Returns once every band is filled.
+    static void AntiFillPathInBands(const SkPathRaw&, const SkIRect& clip, int firstBandTop,
+                                    int bandHeight, SkSpan<SkBlitter* const> blitters,
+                                    SkExecutor*);
+
     static void FrameRect(const SkRect&, const SkPoint& strokeSize,
                           const SkRasterClip&, SkBlitter*);
     static void AntiFrameRect(const SkRect&, const SkPoint& strokeSize,
@@ -89,6 +102,10 @@ private:
     static void AntiHairLineRgn(SkSpan<const SkPoint>, const SkRegion*, SkBlitter*);
     static void AAAFillPath(const SkPathRaw&, SkBlitter* blitter, const SkIRect& pathIR,
                             const SkIRect& clipBounds, bool forceRLE);
+    static bool AAACanFillPathInBands(const SkIRect& pathIR);
+    static void AAAFillPathInBands(const SkPathRaw&, const SkIRect& pathIR, const SkRegion& clip,
+                                   int firstBandTop, int bandHeight,
+                                   SkSpan<SkBlitter* const> blitters, SkExecutor*);
 };
 
 /** Assign an SkXRect from a SkIRect, by promoting the src rect's coordinates
@@ -9,6 +9,8 @@
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkRect.h"
+#include "include/core/SkRegion.h"
+#include "include/core/SkSpan.h"
 #include "include/private/SkAlign.h"
 #include "include/private/SkAssert.h"
 #include "include/private/SkDebug.h"
@@ -25,10 +27,13 @@
 #include "src/core/SkScan.h"
 #include "src/core/SkScanPriv.h"
 #include "src/core/SkTSort.h"
+#include "src/core/SkTaskGroup.h"
 
 #include <algorithm>
 #include <cstdint>
 #include <cstring>
+#include <functional>
+#include <vector>
 
 /*
 
@@ -1402,53 +1407,38 @@ static bool edges_too_close(int prevRite, SkFixed ul, SkFixed ll) {
     return prevRite > SkFixedFloorToInt(ul) || prevRite > SkFixedFloorToInt(ll);
 }
 
-static void aaa_walk_edges(SkAnalyticEdge*  prevHead,
-                           SkAnalyticEdge*  nextTail,
-                           SkPathFillType   fillType,
-                           AdditiveBlitter* blitter,
-                           int              start_y,
-                           int              stop_y,
-                           SkFixed          leftClip,
-                           SkFixed          rightClip,
-                           bool             isUsingMask,
-                           bool             forceRLE,
-                           bool             skipIntersect) {
-    prevHead->fX = prevHead->fUpperX = leftClip;
-    nextTail->fX = nextTail->fUpperX = rightClip;
-    SkFixed y                        = std::max(prevHead->fNext->fUpperY, SkIntToFixed(start_y));
-    SkFixed nextNextY                = SK_MaxS32;
-
-    {
-        SkAnalyticEdge* edge;
-        for (edge = prevHead->fNext; edge->fUpperY <= y; edge = edge->fNext) {
-            edge->goY(y);
-            update_next_next_y(edge->fLowerY, y, &nextNextY);
-        }
-        update_next_next_y(edge->fUpperY, y, &nextNextY);
-    }
+// Lets a walk of the edges stop at the top of its first step at or below fNextY. fSave() gets
+// the walk's state there, as aaa_walk_edges_from() takes it, and returns false to end the walk.
+struct WalkCheckpoints {
+    SkFixed fNextY;
+    std::function<bool(const SkAnalyticEdge* head, SkFixed y, SkFixed nextNextY)> fSave;
+};
 
+// Walks the edges from the top of a step at y, with the edge list in the state aaa_walk_edges()
+// leaves it in at the top of each step: every edge above y is at y and x-sorted, followed by the
+// edges below y in the order of sort_edges(). nextNextY is the next y the walk must stop at.
+// blitter may be null to move the edges without blitting anything.
+static void aaa_walk_edges_from(SkAnalyticEdge*  prevHead,
+                                SkPathFillType   fillType,
+                                AdditiveBlitter* blitter,
+                                SkFixed          y,
+                                SkFixed          nextNextY,
+                                int              stop_y,
+                                SkFixed          leftClip,
+                                SkFixed          rightClip,
+                                bool             isUsingMask,
+                                bool             forceRLE,
+                                bool             skipIntersect,
+                                WalkCheckpoints* checkpoints) {
     int windingMask = SkPathFillType_IsEvenOdd(fillType) ? 1 : -1;
     bool isInverse  = SkPathFillType_IsInverse(fillType);
 
-    if (isInverse && SkIntToFixed(start_y) != y) {
-        int width = SkFixedFloorToInt(rightClip - leftClip);
-        if (SkFixedFloorToInt(y) != start_y) {
-            blitter->getRealBlitter()->blitRect(
-                    SkFixedFloorToInt(leftClip), start_y, width, SkFixedFloorToInt(y) - start_y);
-            start_y = SkFixedFloorToInt(y);
+    while (true) {
+        if (checkpoints && y >= checkpoints->fNextY &&
+            !checkpoints->fSave(prevHead, y, nextNextY)) {
+            return;
         }
-        SkAlpha* maskRow =
-                isUsingMask ? static_cast<MaskAdditiveBlitter*>(blitter)->getRow(start_y) : nullptr;
-        blit_full_alpha(blitter,
-                        start_y,
-                        SkFixedFloorToInt(leftClip),
-                        width,
-                        fixed_to_alpha(y - SkIntToFixed(start_y)),
-                        maskRow,
-                        false);
-    }
 
-    while (true) {
         int             w               = 0;
         bool            in_interval     = isInverse;
         SkFixed         prevX           = prevHead->fX;
@@ -1504,20 +1494,22 @@ static void aaa_walk_edges(SkAnalyticEdge*  prevHead,
                 SkFixed nextLeft = std::max(leftClip, leftE->fX);
                 rite = std::min(rightClip, rite);
                 SkFixed nextRite = std::min(rightClip, currE->fX);
-                blit_trapezoid_row(
-                        blitter,
-                        y >> 16,
-                        left,
-                        rite,
-                        nextLeft,
-                        nextRite,
-                        leftDY,
-                        currE->fDY,
-                        fullAlpha,
-                        maskRow,
-                        noRealBlitter || (fullAlpha == 0xFF &&
-                                          (edges_too_close(prevRite, left, leftE->fX) ||
-                                           edges_too_close(currE, currE->fNext, nextY))));
+                if (blitter) {
+                    blit_trapezoid_row(
+                            blitter,
+                            y >> 16,
+                            left,
+                            rite,
+                            nextLeft,
+                            nextRite,
+                            leftDY,
+                            currE->fDY,
+                            fullAlpha,
+                            maskRow,
+                            noRealBlitter || (fullAlpha == 0xFF &&
+                                              (edges_too_close(prevRite, left, leftE->fX) ||
+                                               edges_too_close(currE, currE->fNext, nextY))));
+                }
                 prevRite = SkFixedCeilToInt(std::max(rite, currE->fX));
             } else {
                 if (isLeft) {
@@ -1572,7 +1564,7 @@ static void aaa_walk_edges(SkAnalyticEdge*  prevHead,
         }
 
         // was our right-edge culled away?
-        if (in_interval) {
+        if (in_interval && blitter) {
             blit_trapezoid_row(blitter,
                                y >> 16,
                                left,
@@ -1587,7 +1579,7 @@ static void aaa_walk_edges(SkAnalyticEdge*  prevHead,
                                                  edges_too_close(leftE->fPrev, leftE, nextY)));
         }
 
-        if (forceRLE) {
+        if (forceRLE && blitter) {
             ((RunBasedAdditiveBlitter*)blitter)->flush_if_y_changed(y, nextY);
         }
 
@@ -1601,6 +1593,90 @@ static void aaa_walk_edges(SkAnalyticEdge*  prevHead,
     }
 }
 
+static void aaa_walk_edges(SkAnalyticEdge*  prevHead,
+                           SkAnalyticEdge*  nextTail,
+                           SkPathFillType   fillType,
+                           AdditiveBlitter* blitter,
+                           int              start_y,
+                           int              stop_y,
+                           SkFixed          leftClip,
+                           SkFixed          rightClip,
+                           bool             isUsingMask,
+                           bool             forceRLE,
+                           bool             skipIntersect,
+                           WalkCheckpoints* checkpoints = nullptr) {
+    prevHead->fX = prevHead->fUpperX = leftClip;
+    nextTail->fX = nextTail->fUpperX = rightClip;
+    SkFixed y                        = std::max(prevHead->fNext->fUpperY, SkIntToFixed(start_y));
+    SkFixed nextNextY                = SK_MaxS32;
+
+    {
+        SkAnalyticEdge* edge;
+        for (edge = prevHead->fNext; edge->fUpperY <= y; edge = edge->fNext) {
+            edge->goY(y);
+            update_next_next_y(edge->fLowerY, y, &nextNextY);
+        }
+        update_next_next_y(edge->fUpperY, y, &nextNextY);
+    }
+
+    bool isInverse = SkPathFillType_IsInverse(fillType);
+
+    if (isInverse && SkIntToFixed(start_y) != y) {
+        int width = SkFixedFloorToInt(rightClip - leftClip);
+        if (SkFixedFloorToInt(y) != start_y) {
+            blitter->getRealBlitter()->blitRect(
+                    SkFixedFloorToInt(leftClip), start_y, width, SkFixedFloorToInt(y) - start_y);
+            start_y = SkFixedFloorToInt(y);
+        }
+        SkAlpha* maskRow =
+                isUsingMask ? static_cast<MaskAdditiveBlitter*>(blitter)->getRow(start_y) : nullptr;
+        blit_full_alpha(blitter,
+                        start_y,
+                        SkFixedFloorToInt(leftClip),
+                        width,
+                        fixed_to_alpha(y - SkIntToFixed(start_y)),
+                        maskRow,
+                        false);
+    }
+
+    aaa_walk_edges_from(prevHead,
+                        fillType,
+                        blitter,
+                        y,
+                        nextNextY,
+                        stop_y,
+                        leftClip,
+                        rightClip,
+                        isUsingMask,
+                        forceRLE,
+                        skipIntersect,
+                        checkpoints);
+}
+
+// Links the headEdge and tailEdge sentinels before first and after last.
+static void link_sentinels(SkAnalyticEdge* headEdge,
+                           SkAnalyticEdge* first,
+                           SkAnalyticEdge* last,
+                           SkAnalyticEdge* tailEdge) {
+    headEdge->fPrev   = nullptr;
+    headEdge->fNext   = first;
+    headEdge->fUpperY = headEdge->fLowerY = SK_MinS32;
+    headEdge->fX                          = SK_MinS32;
+    headEdge->fDX                         = 0;
+    headEdge->fDY                         = SK_MaxS32;
+    headEdge->fUpperX                     = SK_MinS32;
+    first->fPrev                          = headEdge;
+
+    tailEdge->fPrev   = last;
+    tailEdge->fNext   = nullptr;
+    tailEdge->fUpperY = tailEdge->fLowerY = SK_MaxS32;
+    tailEdge->fX                          = SK_MaxS32;
+    tailEdge->fDX                         = 0;
+    tailEdge->fDY                         = SK_MaxS32;
+    tailEdge->fUpperX                     = SK_MaxS32;
+    last->fNext                           = tailEdge;
+}
+
 static void aaa_fill_path(const SkPathRaw& path,
                           const SkIRect& clipRect,
                           AdditiveBlitter* blitter,
@@ -1641,24 +1717,7 @@ static void aaa_fill_path(const SkPathRaw& path,
     SkAnalyticEdge headEdge, tailEdge, *last;
     // this returns the first and last edge after they're sorted into a dlink list
     SkAnalyticEdge* edge = sort_edges(list, count, &last);
-
-    headEdge.fPrev   = nullptr;
-    headEdge.fNext   = edge;
-    headEdge.fUpperY = headEdge.fLowerY = SK_MinS32;
-    headEdge.fX                         = SK_MinS32;
-    headEdge.fDX                        = 0;
-    headEdge.fDY                        = SK_MaxS32;
-    headEdge.fUpperX                    = SK_MinS32;
-    edge->fPrev                         = &headEdge;
-
-    tailEdge.fPrev   = last;
-    tailEdge.fNext   = nullptr;
-    tailEdge.fUpperY = tailEdge.fLowerY = SK_MaxS32;
-    tailEdge.fX                         = SK_MaxS32;
-    tailEdge.fDX                        = 0;
-    tailEdge.fDY                        = SK_MaxS32;
-    tailEdge.fUpperX                    = SK_MaxS32;
-    last->fNext                         = &tailEdge;
+    link_sentinels(&headEdge, edge, last, &tailEdge);
 
     // now edge is the head of the sorted linklist
 
@@ -1779,3 +1838,157 @@ void SkScan::AAAFillPath(const SkPathRaw&  path,
                       forceRLE);
     }
 }
+
+bool SkScan::AAACanFillPathInBands(const SkIRect& pathIR) {
+    return !MaskAdditiveBlitter::CanHandleRect(pathIR);
+}
+
+void SkScan::AAAFillPathInBands(const SkPathRaw&         path,
+                                const SkIRect&           ir,
+                                const SkRegion&          clipRgn,
+                                int                      firstBandTop,
+                                int                      bandHeight,
+                                SkSpan<SkBlitter* const> blitters,
+                                SkExecutor*              executor) {
+    SkASSERT(!path.isInverseFillType() && !path.isKnownToBeConvex());
+    SkASSERT(AAACanFillPathInBands(ir));
+
+    // Set up the walk exactly as AAAFillPath() and aaa_fill_path() do for this path.
+    const SkIRect& clipRect        = clipRgn.getBounds();
+    const bool     containedInClip = clipRect.contains(ir);
+
+    SkAnalyticEdgeBuilder builder;
+    const int        count = builder.buildEdges(path, containedInClip ? nullptr : &clipRect);
+    SkAnalyticEdge** list  = builder.analyticEdgeList();
+    if (0 == count) {
+        return;
+    }
+
+    SkAnalyticEdge headEdge, tailEdge, *last;
+    SkAnalyticEdge* edge = sort_edges(list, count, &last);
+    link_sentinels(&headEdge, edge, last, &tailEdge);
+
+    // The bands copy the edges they start from here, before the walk below moves them.
+    std::vector<SkAnalyticEdge> sorted(count);
+    for (int i = 0; i < count; ++i) {
+        SkASSERT(list[i]->fEdgeType == SkAnalyticEdge::Type::kLine);
+        sorted[i] = *list[i];
+    }
+
+    int start_y = ir.fTop;
+    int stop_y  = ir.fBottom;
+    if (!containedInClip) {
+        start_y = std::max(start_y, clipRect.fTop);
+        stop_y  = std::min(stop_y, clipRect.fBottom);
+    }
+    const SkFixed leftBound     = SkIntToFixed(clipRect.fLeft);
+    const SkFixed rightBound    = SkIntToFixed(clipRect.fRight);
+    const bool    skipIntersect = path.points().size() > SkToSizeT((stop_y - start_y) * 2);
+
+    // Where the walk was at the top of its first step in each band.
+    struct Band {
+        SkFixed                     fY;
+        SkFixed                     fNextNextY;
+        std::vector<SkAnalyticEdge> fEdges;         // the edges above fY, in list order
+        size_t                      fFirstPending;  // the first edge of sorted below fY
+    };
+    const int         bandCount = SkToInt(blitters.size());
+    std::vector<Band> bands(bandCount);
+    auto bandTop    = [&](int i) { return firstBandTop + i * bandHeight; };
+    auto bandBottom = [&](int i) { return std::min(bandTop(i + 1), stop_y); };
+
+    // Each band resumes the walk from where it was at the band's top, with its own copies of the
+    // edges, and walks it to the band's bottom. Since the walk is the same one a single
+    // AAAFillPath() does, every row gets exactly the same coverage.
+    auto drawBand = [&](int i) {
+        Band&         band   = bands[i];
+        const SkFixed bottom = SkIntToFixed(bandBottom(i));
+
+        // Add the edges that start in the band, and the first one below it, which the walk reads
+        // for its next stop.
+        auto pending = sorted.begin() + band.fFirstPending;
+        auto end     = std::find_if(pending, sorted.end(), [bottom](const SkAnalyticEdge& e) {
+            return e.fUpperY >= bottom;
+        });
+        if (end != sorted.end()) {
+            ++end;
+        }
+        std::vector<SkAnalyticEdge>& edges = band.fEdges;
+        edges.insert(edges.end(), pending, end);
+        if (edges.empty()) {
+            return;
+        }
+        for (size_t k = 1; k < edges.size(); ++k) {
+            edges[k - 1].fNext = &edges[k];
+            edges[k].fPrev     = &edges[k - 1];
+        }
+        SkAnalyticEdge bandHead, bandTail;
+        link_sentinels(&bandHead, &edges.front(), &edges.back(), &bandTail);
+        bandHead.fX = bandHead.fUpperX = leftBound;
+        bandTail.fX = bandTail.fUpperX = rightBound;
+
+        SkScanClipper clipper(blitters[i], &clipRgn, ir);
+        if (!clipper.getBlitter()) {
+            return;
+        }
+        SafeRLEAdditiveBlitter additiveBlitter(clipper.getBlitter(), ir, clipRect, false);
+        aaa_walk_edges_from(&bandHead,
+                            path.fillType(),
+                            &additiveBlitter,
+                            band.fY,
+                            band.fNextNextY,
+                            bandBottom(i),
+                            leftBound,
+                            rightBound,
+                            false,
+                            false,
+                            skipIntersect,
+                            nullptr);
+    };
+
+    // Walk the edges without blitting, starting each band as soon as the walk reaches it.
+    SkTaskGroup     tasks(*executor);
+    int             nextBand = 0;
+    WalkCheckpoints checkpoints;
+    checkpoints.fNextY = SK_MinS32;
+    checkpoints.fSave  = [&](const SkAnalyticEdge* head, SkFixed y, SkFixed nextNextY) {
+        // Bands the walk skipped over have nothing to draw.
+        while (nextBand < bandCount && SkIntToFixed(bandBottom(nextBand)) <= y) {
+            ++nextBand;
+        }
+        if (nextBand == bandCount) {
+            return false;
+        }
+        Band& band      = bands[nextBand];
+        band.fY         = y;
+        band.fNextNextY = nextNextY;
+        for (const SkAnalyticEdge* e = head->fNext; e->fUpperY <= y; e = e->fNext) {
+            band.fEdges.push_back(*e);
+        }
+        // Every edge starting at or above y is in the list, and the rest follow in sorted order.
+        band.fFirstPending = std::upper_bound(sorted.begin(), sorted.end(), y,
+                                              [](SkFixed y, const SkAnalyticEdge& e) {
+                                                  return y < e.fUpperY;
+                                              }) - sorted.begin();
+        tasks.add([&drawBand, i = nextBand] { drawBand(i); });
+
+        if (++nextBand == bandCount) {
+            return false;
+        }
+        checkpoints.fNextY = SkIntToFixed(bandTop(nextBand));
+        return true;
+    };
+    aaa_walk_edges(&headEdge,
+                   &tailEdge,
+                   path.fillType(),
+                   nullptr,
+                   start_y,
+                   stop_y,
+                   leftBound,
+                   rightBound,
+                   false,
+                   false,
+                   skipIntersect,
+                   &checkpoints);
+    tasks.wait();
+}
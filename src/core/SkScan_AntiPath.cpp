@@ -6,9 +6,9 @@
  */
 
 #include "include/core/SkPath.h"
-
 #include "include/core/SkRect.h"
 #include "include/core/SkRegion.h"
+#include "include/core/SkSpan.h"
 #include "include/private/SkAssert.h"
 #include "include/private/SkMath.h"
 #include "src/core/SkAAClip.h"
@@ -134,6 +134,46 @@ void SkScan::AntiFillPath(const SkPathRaw& path, const SkRegion& origClip,
     }
 }
 
+bool SkScan::CanAntiFillPathInBands(const SkPathRaw& path, const SkIRect& clip) {
+    if (path.isInverseFillType() || path.isKnownToBeConvex()) {
+        return false;
+    }
+    for (SkPathVerb verb : path.verbs()) {
+        if (verb == SkPathVerb::kQuad || verb == SkPathVerb::kConic ||
+            verb == SkPathVerb::kCubic) {
+            return false;
+        }
+    }
+
+    // The same checks as AntiFillPath(), which draws nothing or draws without antialiasing when
+    // they fail.
+    const SkIRect ir = safeRoundOut(path.bounds());
+    SkIRect clippedIR;
+    if (ir.isEmpty() || !clippedIR.intersect(ir, clip) ||
+        rect_overflows_short_shift(clippedIR, SK_SUPERSAMPLE_SHIFT)) {
+        return false;
+    }
+    return AAACanFillPathInBands(ir);
+}
+
+void SkScan::AntiFillPathInBands(const SkPathRaw& path, const SkIRect& clip, int firstBandTop,
+                                 int bandHeight, SkSpan<SkBlitter* const> blitters,
+                                 SkExecutor* executor) {
+    SkASSERT(CanAntiFillPathInBands(path, clip));
+    SkASSERT(executor);
+
+    // Limit the clip as AntiFillPath() does.
+    static const int32_t kMaxClipCoord = 32767;
+    SkRegion clipRgn(clip);
+    if (clip.fRight > kMaxClipCoord || clip.fBottom > kMaxClipCoord) {
+        SkIRect limit = { 0, 0, kMaxClipCoord, kMaxClipCoord };
+        clipRgn.op(limit, SkRegion::kIntersect_Op);
+    }
+
+    SkScan::AAAFillPathInBands(path, safeRoundOut(path.bounds()), clipRgn, firstBandTop,
+                               bandHeight, blitters, executor);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 
 void SkScan::AntiFillPath(const SkPathRaw& raw, const SkRasterClip& clip, SkBlitter* blitter) {
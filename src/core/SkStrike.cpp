@@ -211,12 +211,35 @@ const SkDrawable* SkStrike::mergeDrawable(SkGlyph* glyph, sk_sp<SkDrawable> draw
 
 void SkStrike::findIntercepts(const SkScalar bounds[2], SkScalar scale, SkScalar xPos,
                               SkGlyph* glyph, SkScalar* array, int* count) {
-    SkAutoMutexExclusive lock{fStrikeLock};
+    SkAutoSharedMutexExclusive lock{fStrikeLock};
     glyph->ensureIntercepts(bounds, scale, xPos, array, count, &fAlloc);
 }
 
+template <typename ID, typename IsPrepared>
+bool SkStrike::findPreparedGlyphs(SkSpan<const ID> glyphIDs,
+                                  const SkGlyph* results[],
+                                  IsPrepared&& isPrepared) {
+    SkAutoSharedMutexShared lock{fStrikeLock};
+    const SkGlyph** cursor = results;
+    for (auto glyphID : glyphIDs) {
+        const SkGlyphDigest* digest = fDigestForPackedGlyphID.find(SkPackedGlyphID{glyphID});
+        if (digest == nullptr) {
+            return false;
+        }
+        const SkGlyph* glyph = fGlyphForIndex[digest->index()];
+        if (!isPrepared(*glyph)) {
+            return false;
+        }
+        *cursor++ = glyph;
+    }
+    return true;
+}
+
 SkSpan<const SkGlyph*> SkStrike::metrics(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
+    if (this->findPreparedGlyphs(glyphIDs, results, [](const SkGlyph&) { return true; })) {
+        return {results, glyphIDs.size()};
+    }
     Monitor m{this};
     return this->internalPrepare(glyphIDs, kMetricsOnly, results);
 }
@@ -241,12 +264,20 @@ void SkStrike::getWidthsStrided(unsigned count,
 
 SkSpan<const SkGlyph*> SkStrike::preparePaths(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
+    auto hasPath = [](const SkGlyph& glyph) { return glyph.setPathHasBeenCalled(); };
+    if (this->findPreparedGlyphs(glyphIDs, results, hasPath)) {
+        return {results, glyphIDs.size()};
+    }
     Monitor m{this};
     return this->internalPrepare(glyphIDs, kMetricsAndPath, results);
 }
 
 SkSpan<const SkGlyph*> SkStrike::prepareImages(
         SkSpan<const SkPackedGlyphID> glyphIDs, const SkGlyph* results[]) {
+    auto hasImage = [](const SkGlyph& glyph) { return glyph.setImageHasBeenCalled(); };
+    if (this->findPreparedGlyphs(glyphIDs, results, hasImage)) {
+        return {results, glyphIDs.size()};
+    }
     const SkGlyph** cursor = results;
     Monitor m{this};
     for (auto glyphID : glyphIDs) {
@@ -260,6 +291,10 @@ SkSpan<const SkGlyph*> SkStrike::prepareImages(
 
 SkSpan<const SkGlyph*> SkStrike::prepareDrawables(
         SkSpan<const SkGlyphID> glyphIDs, const SkGlyph* results[]) {
+    auto hasDrawable = [](const SkGlyph& glyph) { return glyph.setDrawableHasBeenCalled(); };
+    if (this->findPreparedGlyphs(glyphIDs, results, hasDrawable)) {
+        return {results, glyphIDs.size()};
+    }
     const SkGlyph** cursor = results;
     {
         Monitor m{this};
@@ -293,7 +328,7 @@ void SkStrike::glyphIDsToDrawables(SkSpan<sktext::IDOrDrawable> idsOrDrawables)
 }
 
 void SkStrike::dump() const {
-    SkAutoMutexExclusive lock{fStrikeLock};
+    SkAutoSharedMutexExclusive lock{fStrikeLock};
     const SkTypeface* face = fScalerContext->getTypeface();
     const SkScalerContextRec& rec = fScalerContext->getRec();
     SkString name;
@@ -308,7 +343,7 @@ void SkStrike::dump() const {
 }
 
 void SkStrike::dumpMemoryStatistics(SkTraceMemoryDump* dump) const {
-    SkAutoMutexExclusive lock{fStrikeLock};
+    SkAutoSharedMutexExclusive lock{fStrikeLock};
     const SkTypeface* face = fScalerContext->getTypeface();
     const SkScalerContextRec& rec = fScalerContext->getRec();
 
@@ -466,6 +501,7 @@ void SkStrike::updateMemoryUsage(size_t increase) {
         fMemoryUsed += increase;
         if (!fRemoved) {
             fStrikeCache->fTotalMemoryUsed += increase;
+            fStrikeCache->internalUpdateOverBudget();
         }
     }
 }
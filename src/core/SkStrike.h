@@ -17,10 +17,12 @@
 #include "src/core/SkArenaAlloc.h"
 #include "src/core/SkGlyph.h"
 #include "src/core/SkScalerContext.h"
+#include "src/core/SkSharedMutex.h"
 #include "src/core/SkStrikeSpec.h"
 #include "src/core/SkTHash.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <atomic>
 #include <cstddef>
 #include <memory>
 #include <vector>
@@ -157,6 +159,14 @@ private:
     bool mergeGlyphAndPathFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
     bool mergeGlyphAndDrawableFromBuffer(SkReadBuffer& buffer) SK_REQUIRES(fStrikeLock);
 
+    // If every glyph in glyphIDs is already in the strike and passes isPrepared, fill results
+    // and return true. Only a shared lock is held, so threads drawing glyphs which are already
+    // cached do not serialize. Returns false if any glyph needs the exclusive path.
+    template <typename ID, typename IsPrepared>
+    bool findPreparedGlyphs(SkSpan<const ID> glyphIDs,
+                            const SkGlyph* results[],
+                            IsPrepared&& isPrepared) SK_EXCLUDES(fStrikeLock);
+
     // Maintain memory use statistics.
     void updateMemoryUsage(size_t increase) SK_EXCLUDES(fStrikeLock);
 
@@ -177,8 +187,9 @@ private:
     const SkStrikeSpec                fStrikeSpec;
     SkStrikeCache* const              fStrikeCache;
 
-    // This mutex provides protection for this specific SkStrike.
-    mutable SkMutex fStrikeLock;
+    // This mutex provides protection for this specific SkStrike. It is only held shared while
+    // looking up glyphs which are already prepared.
+    mutable SkSharedMutex fStrikeLock;
 
     // Maps from a combined GlyphID and sub-pixel position to a SkGlyphDigest. The actual glyph is
     // stored in the fAlloc. The pointer to the glyph is stored fGlyphForIndex. The
@@ -210,6 +221,10 @@ private:
     std::unique_ptr<SkStrikePinner> fPinner;
     size_t                          fMemoryUsed{sizeof(SkStrike)};
     bool                            fRemoved{false};
+
+    // Set without the SkStrikeCache's mutex when the strike is found, and cleared when a purge
+    // gives the strike a second chance.
+    std::atomic<bool>               fRecentlyUsed{false};
 };
 
 #endif  // SkStrike_DEFINED
@@ -47,10 +47,27 @@ SkStrikeCache* SkStrikeCache::GlobalStrikeCache() {
 }
 
 auto SkStrikeCache::findOrCreateStrike(const SkStrikeSpec& strikeSpec) -> sk_sp<SkStrike> {
+    if (sk_sp<SkStrike> strike = this->findStrike(strikeSpec.descriptor())) {
+        return strike;
+    }
+
+    // Make the scaler context without holding any lock. If another thread adds the same strike
+    // first, use that one and drop this one.
+    sk_sp<SkStrike> strike = this->makeStrike(strikeSpec, nullptr, nullptr);
+
     SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> strike = this->internalFindStrikeOrNull(strikeSpec.descriptor());
-    if (strike == nullptr) {
-        strike = this->internalCreateStrike(strikeSpec);
+    sk_sp<SkStrike> existing;
+    {
+        Shard& shard = this->shardFor(strikeSpec.descriptor());
+        SkAutoMutexExclusive sl(shard.fLock);
+        if (sk_sp<SkStrike>* strikeHandle = shard.fStrikeLookup.find(strikeSpec.descriptor())) {
+            existing = *strikeHandle;
+        }
+    }
+    if (existing != nullptr) {
+        strike = std::move(existing);
+    } else {
+        this->internalAttachToHead(strike);
     }
     this->internalPurge();
     return strike;
@@ -100,55 +117,59 @@ void SkStrikeCache::DumpMemoryStatistics(SkTraceMemoryDump* dump) {
 }
 
 sk_sp<SkStrike> SkStrikeCache::findStrike(const SkDescriptor& desc) {
-    SkAutoMutexExclusive ac(fLock);
-    sk_sp<SkStrike> result = this->internalFindStrikeOrNull(desc);
-    this->internalPurge();
+    sk_sp<SkStrike> result = this->findStrikeInShard(desc);
+    this->purgeIfOverBudget();
     return result;
 }
 
-auto SkStrikeCache::internalFindStrikeOrNull(const SkDescriptor& desc) -> sk_sp<SkStrike> {
-
-    // Check head because it is likely the strike we are looking for.
-    if (fHead != nullptr && fHead->getDescriptor() == desc) { return sk_ref_sp(fHead); }
-
-    // Do the heavy search looking for the strike.
-    sk_sp<SkStrike>* strikeHandle = fStrikeLookup.find(desc);
+auto SkStrikeCache::findStrikeInShard(const SkDescriptor& desc) -> sk_sp<SkStrike> {
+    const Shard& shard = this->shardFor(desc);
+    SkAutoMutexExclusive sl(shard.fLock);
+    const sk_sp<SkStrike>* strikeHandle = shard.fStrikeLookup.find(desc);
     if (strikeHandle == nullptr) { return nullptr; }
     SkStrike* strikePtr = strikeHandle->get();
     SkASSERT(strikePtr != nullptr);
-    if (fHead != strikePtr) {
-        // Make most recently used
-        strikePtr->fPrev->fNext = strikePtr->fNext;
-        if (strikePtr->fNext != nullptr) {
-            strikePtr->fNext->fPrev = strikePtr->fPrev;
-        } else {
-            fTail = strikePtr->fPrev;
-        }
-        fHead->fPrev = strikePtr;
-        strikePtr->fNext = fHead;
-        strikePtr->fPrev = nullptr;
-        fHead = strikePtr;
+
+    // Moving the strike to the head of the list needs fLock. Instead, note the use, and let
+    // the next purge move it.
+    if (!strikePtr->fRecentlyUsed.load(std::memory_order_relaxed)) {
+        strikePtr->fRecentlyUsed.store(true, std::memory_order_relaxed);
     }
     return sk_ref_sp(strikePtr);
 }
 
+void SkStrikeCache::purgeIfOverBudget() {
+    if (fOverBudget.load(std::memory_order_relaxed)) {
+        SkAutoMutexExclusive ac(fLock);
+        this->internalPurge();
+    }
+}
+
+auto SkStrikeCache::shardFor(const SkDescriptor& desc) -> Shard& {
+    return fShards[desc.getChecksum() % kShardCount];
+}
+
+auto SkStrikeCache::shardFor(const SkDescriptor& desc) const -> const Shard& {
+    return fShards[desc.getChecksum() % kShardCount];
+}
+
 sk_sp<SkStrike> SkStrikeCache::createStrike(
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) {
+    sk_sp<SkStrike> strike = this->makeStrike(strikeSpec, maybeMetrics, std::move(pinner));
     SkAutoMutexExclusive ac(fLock);
-    return this->internalCreateStrike(strikeSpec, maybeMetrics, std::move(pinner));
+    this->internalAttachToHead(strike);
+    return strike;
 }
 
-auto SkStrikeCache::internalCreateStrike(
+auto SkStrikeCache::makeStrike(
         const SkStrikeSpec& strikeSpec,
         SkFontMetrics* maybeMetrics,
         std::unique_ptr<SkStrikePinner> pinner) -> sk_sp<SkStrike> {
     std::unique_ptr<SkScalerContext> scaler = strikeSpec.createScalerContext();
-    auto strike =
-        sk_make_sp<SkStrike>(this, strikeSpec, std::move(scaler), maybeMetrics, std::move(pinner));
-    this->internalAttachToHead(strike);
-    return strike;
+    return sk_make_sp<SkStrike>(
+            this, strikeSpec, std::move(scaler), maybeMetrics, std::move(pinner));
 }
 
 void SkStrikeCache::purgePinned(size_t minBytesNeeded) {
@@ -219,8 +240,10 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
     checkPinners = true;
 #endif
 
-    if (fPinnerCount == fCacheCount && !checkPinners)
+    if (fPinnerCount == fCacheCount && !checkPinners) {
+        this->internalUpdateOverBudget();
         return 0;
+    }
 
     size_t bytesNeeded = 0;
     if (fTotalMemoryUsed > fCacheSizeLimit) {
@@ -241,6 +264,7 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
 
     // early exit
     if (!countNeeded && !bytesNeeded) {
+        this->internalUpdateOverBudget();
         return 0;
     }
 
@@ -248,11 +272,22 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
     int     countFreed = 0;
 
     // Start at the tail and proceed backwards deleting; the list is in LRU
-    // order, with unimportant entries at the tail.
+    // order, with unimportant entries at the tail. Strikes found since the last purge are moved
+    // to the head instead, where the walk reaches them again after every other strike.
+    int secondChances = fCacheCount;
     SkStrike* strike = fTail;
     while (strike != nullptr && (bytesFreed < bytesNeeded || countFreed < countNeeded)) {
         SkStrike* prev = strike->fPrev;
 
+        if (secondChances > 0) {
+            secondChances -= 1;
+            if (strike->fRecentlyUsed.exchange(false, std::memory_order_relaxed)) {
+                this->internalMoveToHead(strike);
+                strike = prev;
+                continue;
+            }
+        }
+
         // Only delete if the strike is not pinned.
         if (strike->fPinner == nullptr || (checkPinners && strike->fPinner->canDelete())) {
             bytesFreed += strike->fMemoryUsed;
@@ -262,6 +297,7 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
         strike = prev;
     }
 
+    this->internalUpdateOverBudget();
     this->validate();
 
 #ifdef SPEW_PURGE_STATUS
@@ -275,9 +311,13 @@ size_t SkStrikeCache::internalPurge(size_t minBytesNeeded, bool checkPinners) {
 }
 
 void SkStrikeCache::internalAttachToHead(sk_sp<SkStrike> strike) {
-    SkASSERT(fStrikeLookup.find(strike->getDescriptor()) == nullptr);
     SkStrike* strikePtr = strike.get();
-    fStrikeLookup.set(std::move(strike));
+    {
+        Shard& shard = this->shardFor(strikePtr->getDescriptor());
+        SkAutoMutexExclusive sl(shard.fLock);
+        SkASSERT(shard.fStrikeLookup.find(strikePtr->getDescriptor()) == nullptr);
+        shard.fStrikeLookup.set(std::move(strike));
+    }
     SkASSERT(nullptr == strikePtr->fPrev && nullptr == strikePtr->fNext);
 
     fCacheCount += 1;
@@ -294,6 +334,28 @@ void SkStrikeCache::internalAttachToHead(sk_sp<SkStrike> strike) {
     }
 
     fHead = strikePtr; // Transfer ownership of strike to the cache list.
+    this->internalUpdateOverBudget();
+}
+
+void SkStrikeCache::internalMoveToHead(SkStrike* strike) {
+    if (fHead == strike) {
+        return;
+    }
+    strike->fPrev->fNext = strike->fNext;
+    if (strike->fNext != nullptr) {
+        strike->fNext->fPrev = strike->fPrev;
+    } else {
+        fTail = strike->fPrev;
+    }
+    fHead->fPrev = strike;
+    strike->fNext = fHead;
+    strike->fPrev = nullptr;
+    fHead = strike;
+}
+
+void SkStrikeCache::internalUpdateOverBudget() {
+    fOverBudget.store(fTotalMemoryUsed > fCacheSizeLimit || fCacheCount > fCacheCountLimit,
+                      std::memory_order_relaxed);
 }
 
 void SkStrikeCache::internalRemoveStrike(SkStrike* strike) {
@@ -315,7 +377,10 @@ void SkStrikeCache::internalRemoveStrike(SkStrike* strike) {
 
     strike->fPrev = strike->fNext = nullptr;
     strike->fRemoved = true;
-    fStrikeLookup.remove(strike->getDescriptor());
+
+    Shard& shard = this->shardFor(strike->getDescriptor());
+    SkAutoMutexExclusive sl(shard.fLock);
+    shard.fStrikeLookup.remove(strike->getDescriptor());
 }
 
 void SkStrikeCache::validate() const {
@@ -327,7 +392,9 @@ void SkStrikeCache::validate() const {
     while (strike != nullptr) {
         computedBytes += strike->fMemoryUsed;
         computedCount += 1;
-        SkASSERT(fStrikeLookup.findOrNull(strike->getDescriptor()) != nullptr);
+        const Shard& shard = this->shardFor(strike->getDescriptor());
+        SkAutoMutexExclusive sl(shard.fLock);
+        SkASSERT(shard.fStrikeLookup.findOrNull(strike->getDescriptor()) != nullptr);
         strike = strike->fNext;
     }
 
@@ -16,6 +16,8 @@
 #include "src/core/SkTHash.h"
 #include "src/text/StrikeForGPU.h"
 
+#include <array>
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
@@ -77,18 +79,44 @@ public:
 private:
     friend class SkStrike;  // for SkStrike::updateDelta
     static constexpr char kGlyphCacheDumpName[] = "skia/sk_glyph_cache";
-    sk_sp<SkStrike> internalFindStrikeOrNull(const SkDescriptor& desc) SK_REQUIRES(fLock);
-    sk_sp<SkStrike> internalCreateStrike(
+
+    // The strike lookup is split into shards by descriptor checksum, so that finding a strike
+    // which is already cached only takes the lock of its shard. The LRU list and the budgets are
+    // guarded by fLock. Adding or removing a strike requires fLock and then the shard's lock;
+    // a thread holding a shard lock never acquires fLock.
+    static constexpr int kShardCount = 16;
+    struct StrikeTraits {
+        static const SkDescriptor& GetKey(const sk_sp<SkStrike>& strike);
+        static uint32_t Hash(const SkDescriptor& descriptor);
+    };
+    struct Shard {
+        mutable SkMutex fLock;
+        skia_private::THashTable<sk_sp<SkStrike>, SkDescriptor, StrikeTraits> fStrikeLookup
+                SK_GUARDED_BY(fLock);
+    };
+    Shard& shardFor(const SkDescriptor& desc);
+    const Shard& shardFor(const SkDescriptor& desc) const;
+
+    // Looks up desc holding only the lock of its shard, and marks the strike as recently used.
+    sk_sp<SkStrike> findStrikeInShard(const SkDescriptor& desc);
+
+    // Purges if a previous change left the cache over one of its budgets.
+    void purgeIfOverBudget() SK_EXCLUDES(fLock);
+
+    sk_sp<SkStrike> makeStrike(
             const SkStrikeSpec& strikeSpec,
-            SkFontMetrics* maybeMetrics = nullptr,
-            std::unique_ptr<SkStrikePinner> = nullptr) SK_REQUIRES(fLock);
+            SkFontMetrics* maybeMetrics,
+            std::unique_ptr<SkStrikePinner> pinner);
 
     // The following methods can only be called when mutex is already held.
     void internalRemoveStrike(SkStrike* strike) SK_REQUIRES(fLock);
     void internalAttachToHead(sk_sp<SkStrike> strike) SK_REQUIRES(fLock);
+    void internalMoveToHead(SkStrike* strike) SK_REQUIRES(fLock);
+    void internalUpdateOverBudget() SK_REQUIRES(fLock);
 
     // Checkout budgets, modulated by the specified min-bytes-needed-to-purge,
-    // and attempt to purge caches to match.
+    // and attempt to purge caches to match. Strikes found since the last purge get a second
+    // chance and are moved to the head of the list instead of being removed.
     // Returns number of bytes freed.
     size_t internalPurge(size_t minBytesNeeded = 0, bool checkPinners = false) SK_REQUIRES(fLock);
 
@@ -100,12 +128,11 @@ private:
     mutable SkMutex fLock;
     SkStrike* fHead SK_GUARDED_BY(fLock) {nullptr};
     SkStrike* fTail SK_GUARDED_BY(fLock) {nullptr};
-    struct StrikeTraits {
-        static const SkDescriptor& GetKey(const sk_sp<SkStrike>& strike);
-        static uint32_t Hash(const SkDescriptor& descriptor);
-    };
-    skia_private::THashTable<sk_sp<SkStrike>, SkDescriptor, StrikeTraits> fStrikeLookup
-            SK_GUARDED_BY(fLock);
+    std::array<Shard, kShardCount> fShards;
+
+    // Set under fLock whenever the cache is over either budget, so that lookups which hit can
+    // skip fLock entirely.
+    std::atomic<bool> fOverBudget{false};
 
     size_t  fCacheSizeLimit{SK_DEFAULT_FONT_CACHE_LIMIT};
     size_t  fTotalMemoryUsed SK_GUARDED_BY(fLock) {0};
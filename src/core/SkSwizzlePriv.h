@@ -29,7 +29,11 @@ namespace SkOpts {
                            RGB_to_BGR1,     // i.e. swap RB and insert an opaque alpha
                            gray_to_RGB1,    // i.e. expand to color channels + an opaque alpha
                            grayA_to_RGBA,   // i.e. expand to color channels
-                           grayA_to_rgbA;   // i.e. expand to color channels and premultiply
+                           grayA_to_rgbA,   // i.e. expand to color channels and premultiply
+                           RGB16_to_RGB1,   // i.e. narrow big-endian 16-bit to 8-bit, insert alpha
+                           RGB16_to_BGR1,   // i.e. narrow, swap RB and insert an opaque alpha
+                           RGBA16_to_RGBA,  // i.e. narrow big-endian 16-bit to 8-bit
+                           RGBA16_to_BGRA;  // i.e. narrow and swap RB
 
     void Init_Swizzler();
 }  // namespace SkOpts
@@ -28,11 +28,16 @@ namespace SkOpts {
     DEFINE_DEFAULT(gray_to_RGB1);
     DEFINE_DEFAULT(grayA_to_RGBA);
     DEFINE_DEFAULT(grayA_to_rgbA);
+    DEFINE_DEFAULT(RGB16_to_RGB1);
+    DEFINE_DEFAULT(RGB16_to_BGR1);
+    DEFINE_DEFAULT(RGBA16_to_RGBA);
+    DEFINE_DEFAULT(RGBA16_to_BGRA);
     DEFINE_DEFAULT(inverted_CMYK_to_RGB1);
     DEFINE_DEFAULT(inverted_CMYK_to_BGR1);
 
     void Init_Swizzler_ssse3();
     void Init_Swizzler_ml3();
+    void Init_Swizzler_ml4();
     void Init_Swizzler_lasx();
 
     static bool init() {
@@ -46,6 +51,10 @@ namespace SkOpts {
         #if SK_CPU_X64_LEVEL < SK_CPU_X64_LEVEL_AVX2
             if (SkCpu::Supports(SkX64::ML3)) { Init_Swizzler_ml3(); }
         #endif
+
+        #if SK_CPU_X64_LEVEL < SK_CPU_X64_LEVEL_ML4 && !defined(SK_DISABLE_AVX512_OPTS)
+            if (SkCpu::Supports(SkX64::ML4)) { Init_Swizzler_ml4(); }
+        #endif
     #elif defined(SK_CPU_LOONGARCH)
         #if SK_CPU_LSX_LEVEL < SK_CPU_LSX_LEVEL_LASX
             if (SkCpu::Supports(SkLoongArch::ASX)) { Init_Swizzler_lasx(); }
@@ -0,0 +1,38 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/private/SkFeatures.h"
+#include "src/core/SkOptsTargets.h"
+#include "src/core/SkSwizzlePriv.h"
+
+#if defined(SK_CPU_X86) && \
+    !defined(SK_ENABLE_OPTIMIZE_SIZE) && \
+    SK_CPU_X64_LEVEL < SK_CPU_X64_LEVEL_ML4
+
+// The order of these includes is important:
+// 1) Select the target CPU architecture by defining SK_OPTS_TARGET and including SkOpts_SetTarget
+// 2) Include the code to compile, typically in a _opts.inc file.
+// 3) Include SkOpts_RestoreTarget to switch back to the default CPU architecture
+
+#define SK_OPTS_TARGET SK_OPTS_TARGET_ML4
+#include "src/opts/SkOpts_SetTarget.h"
+
+#include "src/opts/SkSwizzler_opts.inc"
+
+#include "src/opts/SkOpts_RestoreTarget.h"
+
+namespace SkOpts {
+    // Only the RGBA swaps and premuls have 512-bit specializations; everything else in
+    // SkSwizzler_opts.inc would compile to the same code as ml3.
+    void Init_Swizzler_ml4() {
+        RGBA_to_BGRA          = ml4::RGBA_to_BGRA;
+        RGBA_to_rgbA          = ml4::RGBA_to_rgbA;
+        RGBA_to_bgrA          = ml4::RGBA_to_bgrA;
+    }
+}  // namespace SkOpts
+
+#endif // SK_CPU_X86 && !SK_ENABLE_OPTIMIZE_SIZE
@@ -7,75 +7,204 @@
 
 #include "src/core/SkSynchronizedResourceCache.h"
 
+#include "include/private/SkMalloc.h"
+#include "src/core/SkCachedData.h"
+#include "src/core/SkChecksum.h"
+
+#include <algorithm>
+
+// The shards' inbox IDs are 1..kShardCount. The cache's own (unused) base inbox must not match
+// any of them, or it would collect messages that are never polled.
+static constexpr uint32_t kUnusedInboxID = UINT32_MAX;
+
+// The shards never purge by bytes themselves; the budget is enforced across all of them.
+static constexpr size_t kUnlimitedShardBytes = SIZE_MAX;
+
 SkSynchronizedResourceCache::SkSynchronizedResourceCache(DiscardableFactory fact)
- : SkResourceCache(fact) {}
+        : SkResourceCache(fact, 0, kUnusedInboxID, 1)
+        , fTotalByteLimit(0) {
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        fShards[i].fCache.reset(
+                new SkResourceCache(fact, kUnlimitedShardBytes, i + 1, kShardCount));
+    }
+}
 
 SkSynchronizedResourceCache::SkSynchronizedResourceCache(size_t byteLimit)
- : SkResourceCache(byteLimit) {}
+        : SkResourceCache(nullptr, byteLimit, kUnusedInboxID, 1)
+        , fTotalByteLimit(byteLimit) {
+    for (int i = 0; i < kShardCount; ++i) {
+        SkAutoMutexExclusive am(fShards[i].fMutex);
+        fShards[i].fCache.reset(
+                new SkResourceCache(nullptr, kUnlimitedShardBytes, i + 1, kShardCount));
+    }
+}
 
 SkSynchronizedResourceCache::~SkSynchronizedResourceCache() = default;
 
+int SkSynchronizedResourceCache::ShardIndexForSharedID(uint64_t sharedID) {
+    return SkChecksum::Mix((uint32_t)sharedID ^ (uint32_t)(sharedID >> 32)) % kShardCount;
+}
+
+uint32_t SkSynchronizedResourceCache::PurgeInboxIDForSharedID(uint64_t sharedID) {
+    return ShardIndexForSharedID(sharedID) + 1;
+}
+
+SkSynchronizedResourceCache::Shard& SkSynchronizedResourceCache::shardFor(const Key& key) {
+    uint64_t sharedID = key.getSharedID();
+    return fShards[sharedID ? ShardIndexForSharedID(sharedID) : key.hash() % kShardCount];
+}
+
+void SkSynchronizedResourceCache::updateTotalBytesUsed(const Shard& shard, size_t bytesBefore) {
+    size_t bytesAfter = shard.fCache->fTotalBytesUsed;
+    if (bytesAfter >= bytesBefore) {
+        fTotalBytesUsed.fetch_add(bytesAfter - bytesBefore, std::memory_order_relaxed);
+    } else {
+        fTotalBytesUsed.fetch_sub(bytesBefore - bytesAfter, std::memory_order_relaxed);
+    }
+}
+
+void SkSynchronizedResourceCache::purgeAsNeeded() {
+    // A discardable cache has no byte budget; each shard enforces its part of the count limit.
+    if (this->SkResourceCache::discardableFactory()) {
+        return;
+    }
+
+    for (int i = 0; i < kShardCount; ++i) {
+        size_t used = fTotalBytesUsed.load(std::memory_order_relaxed);
+        size_t limit = fTotalByteLimit.load(std::memory_order_relaxed);
+        if (used <= limit) {
+            return;
+        }
+        Shard& shard = fShards[fNextPurgeShard.fetch_add(1, std::memory_order_relaxed) %
+                               kShardCount];
+        SkAutoMutexExclusive am(shard.fMutex);
+        size_t bytesBefore = shard.fCache->fTotalBytesUsed;
+        shard.fCache->purgeBytes(used - limit);
+        this->updateTotalBytesUsed(shard, bytesBefore);
+    }
+}
+
 size_t SkSynchronizedResourceCache::getTotalBytesUsed() const {
-    SkAutoMutexExclusive am(fMutex);
-    return SkResourceCache::getTotalBytesUsed();
+    return fTotalBytesUsed.load(std::memory_order_relaxed);
 }
 
 size_t SkSynchronizedResourceCache::getTotalByteLimit() const {
-    SkAutoMutexExclusive am(fMutex);
-    return SkResourceCache::getTotalByteLimit();
+    return fTotalByteLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkSynchronizedResourceCache::setTotalByteLimit(size_t newLimit) {
-    SkAutoMutexExclusive am(fMutex);
-    return SkResourceCache::setTotalByteLimit(newLimit);
+    size_t prevLimit = fTotalByteLimit.exchange(newLimit, std::memory_order_relaxed);
+    if (newLimit < prevLimit) {
+        this->purgeAsNeeded();
+    }
+    return prevLimit;
 }
 
 SkResourceCache::DiscardableFactory SkSynchronizedResourceCache::discardableFactory() const {
-    SkAutoMutexExclusive am(fMutex);
+    // Set at construction and never changed.
     return SkResourceCache::discardableFactory();
 }
 
 SkCachedData* SkSynchronizedResourceCache::newCachedData(size_t bytes) {
-    SkAutoMutexExclusive am(fMutex);
-    return SkResourceCache::newCachedData(bytes);
+    // Unlike SkResourceCache::newCachedData(), this does not check for purge messages first:
+    // that would lock every shard. Each shard handles its messages on its next find or add.
+    if (DiscardableFactory factory = this->discardableFactory()) {
+        SkDiscardableMemory* dm = factory(bytes);
+        return dm ? new SkCachedData(bytes, dm) : nullptr;
+    } else {
+        return new SkCachedData(sk_malloc_throw(bytes), bytes);
+    }
 }
 
 void SkSynchronizedResourceCache::dump() const {
-    SkAutoMutexExclusive am(fMutex);
-    SkResourceCache::dump();
+    int count = 0;
+    for (const Shard& shard : fShards) {
+        SkAutoMutexExclusive am(shard.fMutex);
+        count += shard.fCache->fCount;
+    }
+    SkDebugf("SkResourceCache: count=%d bytes=%zu %s\n",
+             count, this->getTotalBytesUsed(),
+             this->discardableFactory() ? "discardable" : "malloc");
 }
 
 size_t SkSynchronizedResourceCache::setSingleAllocationByteLimit(size_t size) {
-    SkAutoMutexExclusive am(fMutex);
-    return SkResourceCache::setSingleAllocationByteLimit(size);
+    return fSingleAllocationByteLimit.exchange(size, std::memory_order_relaxed);
 }
 
 size_t SkSynchronizedResourceCache::getSingleAllocationByteLimit() const {
-    SkAutoMutexExclusive am(fMutex);
-    return SkResourceCache::getSingleAllocationByteLimit();
+    return fSingleAllocationByteLimit.load(std::memory_order_relaxed);
 }
 
 size_t SkSynchronizedResourceCache::getEffectiveSingleAllocationByteLimit() const {
-    SkAutoMutexExclusive am(fMutex);
-    return SkResourceCache::getEffectiveSingleAllocationByteLimit();
+    // fSingleAllocationByteLimit == 0 means the caller is asking for our default
+    size_t limit = this->getSingleAllocationByteLimit();
+
+    // if we're not discardable (i.e. we are fixed-budget) then cap the single-limit
+    // to our budget.
+    if (nullptr == this->discardableFactory()) {
+        size_t totalLimit = this->getTotalByteLimit();
+        if (0 == limit) {
+            limit = totalLimit;
+        } else {
+            limit = std::min(limit, totalLimit);
+        }
+    }
+    return limit;
 }
 
 void SkSynchronizedResourceCache::purgeAll() {
-    SkAutoMutexExclusive am(fMutex);
-    return SkResourceCache::purgeAll();
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive am(shard.fMutex);
+        size_t bytesBefore = shard.fCache->fTotalBytesUsed;
+        shard.fCache->purgeAll();
+        this->updateTotalBytesUsed(shard, bytesBefore);
+    }
+}
+
+void SkSynchronizedResourceCache::purgeSharedID(uint64_t sharedID) {
+    if (0 == sharedID) {
+        return;
+    }
+    Shard& shard = fShards[ShardIndexForSharedID(sharedID)];
+    SkAutoMutexExclusive am(shard.fMutex);
+    size_t bytesBefore = shard.fCache->fTotalBytesUsed;
+    shard.fCache->purgeSharedID(sharedID);
+    this->updateTotalBytesUsed(shard, bytesBefore);
+}
+
+void SkSynchronizedResourceCache::checkMessages() {
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive am(shard.fMutex);
+        size_t bytesBefore = shard.fCache->fTotalBytesUsed;
+        shard.fCache->checkMessages();
+        this->updateTotalBytesUsed(shard, bytesBefore);
+    }
 }
 
 bool SkSynchronizedResourceCache::find(const Key& key, FindVisitor visitor, void* context) {
-    SkAutoMutexExclusive am(fMutex);
-    return SkResourceCache::find(key, visitor, context);
+    Shard& shard = this->shardFor(key);
+    SkAutoMutexExclusive am(shard.fMutex);
+    size_t bytesBefore = shard.fCache->fTotalBytesUsed;
+    bool found = shard.fCache->find(key, visitor, context);
+    this->updateTotalBytesUsed(shard, bytesBefore);
+    return found;
 }
 
 void SkSynchronizedResourceCache::add(Rec* rec, void* payload) {
-    SkAutoMutexExclusive am(fMutex);
-    SkResourceCache::add(rec, payload);
+    {
+        Shard& shard = this->shardFor(rec->getKey());
+        SkAutoMutexExclusive am(shard.fMutex);
+        size_t bytesBefore = shard.fCache->fTotalBytesUsed;
+        shard.fCache->add(rec, payload);
+        this->updateTotalBytesUsed(shard, bytesBefore);
+    }
+    this->purgeAsNeeded();
 }
 
 void SkSynchronizedResourceCache::visitAll(Visitor visitor, void* context) {
-    SkAutoMutexExclusive am(fMutex);
-    SkResourceCache::visitAll(visitor, context);
+    for (Shard& shard : fShards) {
+        SkAutoMutexExclusive am(shard.fMutex);
+        shard.fCache->visitAll(visitor, context);
+    }
 }
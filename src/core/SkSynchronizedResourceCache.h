@@ -10,12 +10,26 @@
 
 #include "include/private/SkDebug.h"
 #include "include/private/SkMutex.h"
+#include "include/private/SkThreadAnnotations.h"
 #include "src/core/SkResourceCache.h"
 
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 
 class SkCachedData;
 
+/**
+ *  A SkResourceCache which may be used from many threads at once.
+ *
+ *  Recs are split into shards, each an SkResourceCache with its own mutex, so lookups from
+ *  different threads rarely wait on each other. Recs with a shared ID are placed by that ID, so a
+ *  purge message only goes to one shard; the rest are placed by key hash. Each shard keeps its
+ *  own LRU order. The byte budget is global: when it is exceeded, shards are purged from their
+ *  LRU tails in round-robin order, which approximates a global LRU.
+ */
 class SkSynchronizedResourceCache : public SkResourceCache {
 public:
     bool find(const Key& key, FindVisitor, void* context) override;
@@ -32,6 +46,8 @@ public:
     size_t getEffectiveSingleAllocationByteLimit() const override;
 
     void purgeAll() override;
+    void purgeSharedID(uint64_t sharedID) override;
+    void checkMessages() override;
 
     DiscardableFactory discardableFactory() const override;
 
@@ -43,7 +59,30 @@ public:
     explicit SkSynchronizedResourceCache(size_t byteLimit);
     ~SkSynchronizedResourceCache() override;
 
+    // The inbox ID of the shard which holds Recs with this shared ID.
+    static uint32_t PurgeInboxIDForSharedID(uint64_t sharedID);
+
 private:
-    mutable SkMutex fMutex;
+    static constexpr int kShardCount = 16;
+
+    struct Shard {
+        mutable SkMutex fMutex;
+        std::unique_ptr<SkResourceCache> fCache SK_GUARDED_BY(fMutex);
+    };
+
+    static int ShardIndexForSharedID(uint64_t sharedID);
+    Shard& shardFor(const Key& key);
+
+    // Adds the change in the shard's byte count since bytesBefore to fTotalBytesUsed.
+    void updateTotalBytesUsed(const Shard& shard, size_t bytesBefore) SK_REQUIRES(shard.fMutex);
+
+    // Purges shards in round-robin order until the cache is within its byte budget.
+    void purgeAsNeeded();
+
+    std::array<Shard, kShardCount> fShards;
+    std::atomic<size_t> fTotalBytesUsed{0};
+    std::atomic<size_t> fTotalByteLimit;
+    std::atomic<size_t> fSingleAllocationByteLimit{0};
+    std::atomic<int>    fNextPurgeShard{0};
 };
 #endif
@@ -28,6 +28,7 @@
 #include "src/core/SkConvertPixels.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkMSAN.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/encode/SkImageEncoderFns.h"
 #include "src/encode/SkImageEncoderPriv.h"
 #include "src/encode/SkJPEGWriteUtility.h"
@@ -35,12 +36,15 @@
 
 #include <setjmp.h>
 #include <cstdint>
+#include <algorithm>
 #include <cstring>
 #include <memory>
 #include <utility>
+#include <vector>
 
 class GrDirectContext;
 class SkColorSpace;
+class SkExecutor;
 class SkImage;
 
 extern "C" {
@@ -64,6 +68,17 @@ public:
                        const SkJpegEncoder::Options&,
                        const SkJpegMetadataEncoder::SegmentList&);
 
+    // Set up to encode |height| rows of |image|, which was initialized for encoding in bands,
+    // as a standalone JPEG. Only the first band needs |image|'s metadata.
+    void initializeBand(const SkJpegEncoderMgr& image, int height, bool writeMetadata);
+
+    // Non-null if the image will be encoded in bands on this executor rather than row by row.
+    SkExecutor* executor() const { return fExecutor; }
+    int rowsPerBand() const { return fRowsPerBand; }
+    int mcuHeight() const;
+
+    SkWStream* stream() const { return fDstMgr.fStream; }
+
     jpeg_compress_struct* cinfo() { return &fCInfo; }
 
     skjpeg_error_mgr* errorMgr() { return &fErrMgr; }
@@ -81,6 +96,7 @@ private:
         fCInfo.dest = &fDstMgr;
     }
     void initializeCommon(const SkJpegEncoder::Options&, const SkJpegMetadataEncoder::SegmentList&);
+    bool initializeBands(SkExecutor*);
 
     jpeg_compress_struct fCInfo;
     skjpeg_error_mgr fErrMgr;
@@ -89,8 +105,16 @@ private:
     std::optional<SkImageInfo> fSrcInfo;
     std::optional<SkImageInfo> fDstInfo;
     bool fUseColorXform = false;
+
+    int fQuality = 100;
+    SkExecutor* fExecutor = nullptr;
+    int fRowsPerBand = 0;
+    SkJpegMetadataEncoder::SegmentList fMetadataSegments;
 };
 
+// Bands are sized to hold roughly this many pixels.
+static constexpr int kParallelBandPixels = 256 * 1024;
+
 // This function should only be called if fUseColorXform is true and thus fSrcInfo
 // and fDstInfo have value. fSrcInfo, fDstInfo, and width must all have the same width.
 bool SkJpegEncoderMgr::colorTransformProc(void* dst, const void* src, const int width) {
@@ -285,7 +309,16 @@ void SkJpegEncoderMgr::initializeCommon(
     // slower encode performance.
     fCInfo.optimize_coding = TRUE;
 
+    fQuality = options.fQuality;
     jpeg_set_quality(&fCInfo, options.fQuality, TRUE);
+
+    if (options.fExecutor && this->initializeBands(options.fExecutor)) {
+        // Each band starts its own compression once all rows are available. Nothing is written
+        // to the stream until they are done.
+        fMetadataSegments = metadataSegments;
+        return;
+    }
+
     jpeg_start_compress(&fCInfo, TRUE);
 
     for (const auto& segment : metadataSegments) {
@@ -296,6 +329,59 @@ void SkJpegEncoderMgr::initializeCommon(
     }
 }
 
+int SkJpegEncoderMgr::mcuHeight() const {
+    int maxVSampFactor = 1;
+    for (int i = 0; i < fCInfo.num_components; i++) {
+        maxVSampFactor = std::max(maxVSampFactor, fCInfo.comp_info[i].v_samp_factor);
+    }
+    return maxVSampFactor * DCTSIZE;
+}
+
+bool SkJpegEncoderMgr::initializeBands(SkExecutor* executor) {
+    // Every band restarts its restart marker numbering at RST0, and the numbers cycle through
+    // RST0-RST7, so bands must span a multiple of 8 MCU rows for them to line up.
+    const int bandAlignment = 8 * this->mcuHeight();
+    const int rows = std::max<int>(1, kParallelBandPixels / fCInfo.image_width);
+    const int rowsPerBand = (rows + bandAlignment - 1) / bandAlignment * bandAlignment;
+    if (rowsPerBand >= (int)fCInfo.image_height) {
+        return false;
+    }
+    fExecutor = executor;
+    fRowsPerBand = rowsPerBand;
+    return true;
+}
+
+void SkJpegEncoderMgr::initializeBand(const SkJpegEncoderMgr& image,
+                                      int height,
+                                      bool writeMetadata) {
+    const jpeg_compress_struct& imageInfo = image.fCInfo;
+    fCInfo.image_width = imageInfo.image_width;
+    fCInfo.image_height = height;
+    fCInfo.in_color_space = imageInfo.in_color_space;
+    fCInfo.input_components = imageInfo.input_components;
+    jpeg_set_defaults(&fCInfo);
+    for (int i = 0; i < imageInfo.num_components; i++) {
+        fCInfo.comp_info[i].h_samp_factor = imageInfo.comp_info[i].h_samp_factor;
+        fCInfo.comp_info[i].v_samp_factor = imageInfo.comp_info[i].v_samp_factor;
+    }
+    jpeg_set_quality(&fCInfo, image.fQuality, TRUE);
+
+    // The bands are stitched into one scan, so they must share Huffman tables. Optimized tables
+    // would differ from band to band, so use the standard ones.
+    fCInfo.optimize_coding = FALSE;
+    fCInfo.restart_in_rows = 1;
+    jpeg_start_compress(&fCInfo, TRUE);
+
+    if (writeMetadata) {
+        for (const auto& segment : image.fMetadataSegments) {
+            jpeg_write_marker(&fCInfo,
+                              segment.fMarker,
+                              segment.fParameters->bytes(),
+                              segment.fParameters->size());
+        }
+    }
+}
+
 std::unique_ptr<SkEncoder> SkJpegEncoderImpl::MakeYUV(
         SkWStream* dst,
         const SkYUVAPixmaps& srcYUVA,
@@ -352,43 +438,60 @@ SkJpegEncoderImpl::SkJpegEncoderImpl(std::unique_ptr<SkJpegEncoderMgr> encoderMg
 
 SkJpegEncoderImpl::~SkJpegEncoderImpl() {}
 
-bool SkJpegEncoderImpl::onEncodeRows(int numRows) {
-    skjpeg_error_mgr::AutoPushJmpBuf jmp(fEncoderMgr->errorMgr());
-    if (setjmp(jmp)) {
-        return false;
-    }
-
+bool SkJpegEncoderImpl::writeRows(SkJpegEncoderMgr* mgr,
+                                  int startRow,
+                                  int numRows,
+                                  uint8_t* storage) {
     if (fSrcYUVA) {
         // TODO(ccameron): Consider using jpeg_write_raw_data, to avoid having to re-pack the data.
         for (int i = 0; i < numRows; i++) {
-            yuva_copy_row(*fSrcYUVA, fCurrRow + i, fStorage.get());
-            JSAMPLE* jpegSrcRow = fStorage.get();
-            jpeg_write_scanlines(fEncoderMgr->cinfo(), &jpegSrcRow, 1);
+            yuva_copy_row(*fSrcYUVA, startRow + i, storage);
+            JSAMPLE* jpegSrcRow = storage;
+            jpeg_write_scanlines(mgr->cinfo(), &jpegSrcRow, 1);
         }
-    } else {
-        const size_t srcBytes = SkColorTypeBytesPerPixel(fSrc.colorType()) * fSrc.width();
-        const size_t jpegSrcBytes = fEncoderMgr->cinfo()->input_components * fSrc.width();
-        const void* srcRow = fSrc.addr(0, fCurrRow);
-        for (int i = 0; i < numRows; i++) {
-            JSAMPLE* jpegSrcRow = (JSAMPLE*)(const_cast<void*>(srcRow));
-            if (fEncoderMgr->shouldUseColorXform()) {
-                sk_msan_assert_initialized(srcRow, SkTAddOffset<const void>(srcRow, srcBytes));
-                if (!fEncoderMgr->colorTransformProc((void*)fStorage.get(), srcRow, fSrc.width())) {
-                    return false;
-                }
-                jpegSrcRow = fStorage.get();
-                sk_msan_assert_initialized(jpegSrcRow,
-                                           SkTAddOffset<const void>(jpegSrcRow, jpegSrcBytes));
-            } else {
-                // Same as above, but this repetition allows determining whether a
-                // proc was used when msan asserts.
-                sk_msan_assert_initialized(jpegSrcRow,
-                                           SkTAddOffset<const void>(jpegSrcRow, jpegSrcBytes));
-            }
+        return true;
+    }
 
-            jpeg_write_scanlines(fEncoderMgr->cinfo(), &jpegSrcRow, 1);
-            srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
+    const size_t srcBytes = SkColorTypeBytesPerPixel(fSrc.colorType()) * fSrc.width();
+    const size_t jpegSrcBytes = fEncoderMgr->cinfo()->input_components * fSrc.width();
+    const void* srcRow = fSrc.addr(0, startRow);
+    for (int i = 0; i < numRows; i++) {
+        JSAMPLE* jpegSrcRow = (JSAMPLE*)(const_cast<void*>(srcRow));
+        if (fEncoderMgr->shouldUseColorXform()) {
+            sk_msan_assert_initialized(srcRow, SkTAddOffset<const void>(srcRow, srcBytes));
+            if (!fEncoderMgr->colorTransformProc((void*)storage, srcRow, fSrc.width())) {
+                return false;
+            }
+            jpegSrcRow = storage;
+            sk_msan_assert_initialized(jpegSrcRow,
+                                       SkTAddOffset<const void>(jpegSrcRow, jpegSrcBytes));
+        } else {
+            // Same as above, but this repetition allows determining whether a
+            // proc was used when msan asserts.
+            sk_msan_assert_initialized(jpegSrcRow,
+                                       SkTAddOffset<const void>(jpegSrcRow, jpegSrcBytes));
         }
+
+        jpeg_write_scanlines(mgr->cinfo(), &jpegSrcRow, 1);
+        srcRow = SkTAddOffset<const void>(srcRow, fSrc.rowBytes());
+    }
+    return true;
+}
+
+bool SkJpegEncoderImpl::onEncodeRows(int numRows) {
+    if (fEncoderMgr->executor()) {
+        // The bands read their rows straight from the source once all of them are available.
+        fCurrRow += numRows;
+        return fCurrRow < fSrc.height() || this->encodeBandsInParallel();
+    }
+
+    skjpeg_error_mgr::AutoPushJmpBuf jmp(fEncoderMgr->errorMgr());
+    if (setjmp(jmp)) {
+        return false;
+    }
+
+    if (!this->writeRows(fEncoderMgr.get(), fCurrRow, numRows, fStorage.get())) {
+        return false;
     }
 
     fCurrRow += numRows;
@@ -399,6 +502,116 @@ bool SkJpegEncoderImpl::onEncodeRows(int numRows) {
     return true;
 }
 
+sk_sp<SkData> SkJpegEncoderImpl::encodeBand(int startRow, int endRow, bool writeMetadata) {
+    SkDynamicMemoryWStream stream;
+    std::unique_ptr<SkJpegEncoderMgr> band = SkJpegEncoderMgr::Make(&stream);
+    skia_private::AutoTMalloc<uint8_t> storage(fEncoderMgr->cinfo()->input_components *
+                                               fSrc.width());
+    {
+        skjpeg_error_mgr::AutoPushJmpBuf jmp(band->errorMgr());
+        if (setjmp(jmp)) {
+            return nullptr;
+        }
+
+        band->initializeBand(*fEncoderMgr, endRow - startRow, writeMetadata);
+        if (!this->writeRows(band.get(), startRow, endRow - startRow, storage.get())) {
+            return nullptr;
+        }
+        jpeg_finish_compress(band->cinfo());
+    }
+    return stream.detachAsData();
+}
+
+// Returns the offset of the entropy-coded data of a JPEG written by libjpeg, which follows its
+// only SOS segment, or 0 if it is malformed. |frameHeightOffset| is set to the offset of the
+// image height in the SOF segment.
+static size_t find_scan_data(const SkData* jpeg, size_t* frameHeightOffset) {
+    const uint8_t* data = jpeg->bytes();
+    const size_t size = jpeg->size();
+    *frameHeightOffset = 0;
+    size_t offset = kJpegMarkerCodeSize;  // Skip SOI.
+    while (offset + kJpegMarkerCodeSize + kJpegSegmentParameterLengthSize <= size) {
+        if (data[offset] != 0xFF) {
+            return 0;
+        }
+        const uint8_t marker = data[offset + 1];
+        const size_t length = (data[offset + 2] << 8) | data[offset + 3];
+        const size_t next = offset + kJpegMarkerCodeSize + length;
+        if (next > size) {
+            return 0;
+        }
+        if (marker == 0xC0 || marker == 0xC1) {
+            // Baseline or extended sequential SOF. The length and sample precision precede the
+            // height.
+            *frameHeightOffset = offset + kJpegMarkerCodeSize + kJpegSegmentParameterLengthSize + 1;
+        } else if (marker == kJpegMarkerStartOfScan) {
+            return *frameHeightOffset ? next : 0;
+        }
+        offset = next;
+    }
+    return 0;
+}
+
+bool SkJpegEncoderImpl::encodeBandsInParallel() {
+    const int height = fSrc.height();
+    const int rowsPerBand = fEncoderMgr->rowsPerBand();
+    const int bandCount = (height + rowsPerBand - 1) / rowsPerBand;
+
+    std::vector<sk_sp<SkData>> bands(bandCount);
+    SkTaskGroup taskGroup(*fEncoderMgr->executor());
+    taskGroup.batch(bandCount, [&](int i) {
+        bands[i] = this->encodeBand(
+                i * rowsPerBand, std::min(height, (i + 1) * rowsPerBand), i == 0);
+    });
+    taskGroup.wait();
+
+    // Each band is a complete JPEG. Write the headers of the first one, with the height of the
+    // whole image, then the entropy-coded data of every band without its EOI.
+    std::vector<size_t> dataOffsets(bandCount);
+    for (int i = 0; i < bandCount; i++) {
+        if (!bands[i]) {
+            return false;
+        }
+        size_t frameHeightOffset;
+        dataOffsets[i] = find_scan_data(bands[i].get(), &frameHeightOffset);
+        if (!dataOffsets[i]) {
+            return false;
+        }
+        const uint8_t* data = bands[i]->bytes();
+        const size_t size = bands[i]->size();
+        if (size < dataOffsets[i] + kJpegMarkerCodeSize || data[size - 2] != 0xFF ||
+            data[size - 1] != kJpegMarkerEndOfImage) {
+            return false;
+        }
+        if (i == 0) {
+            std::vector<uint8_t> header(data, data + dataOffsets[0]);
+            header[frameHeightOffset + 0] = static_cast<uint8_t>(height >> 8);
+            header[frameHeightOffset + 1] = static_cast<uint8_t>(height & 0xFF);
+            if (!fEncoderMgr->stream()->write(header.data(), header.size())) {
+                return false;
+            }
+        }
+    }
+
+    // Band i > 0 starts after i * rowsPerBand / mcuHeight restart intervals. That is a multiple
+    // of 8, so the marker that separates the bands is always RST7.
+    SkASSERT(rowsPerBand / fEncoderMgr->mcuHeight() % 8 == 0);
+    static constexpr uint8_t kRestartMarker[] = {0xFF, 0xD7};
+    static constexpr uint8_t kEndOfImage[] = {0xFF, kJpegMarkerEndOfImage};
+    SkWStream* dst = fEncoderMgr->stream();
+    for (int i = 0; i < bandCount; i++) {
+        if (i > 0 && !dst->write(kRestartMarker, sizeof(kRestartMarker))) {
+            return false;
+        }
+        const size_t dataSize = bands[i]->size() - kJpegMarkerCodeSize - dataOffsets[i];
+        if (!dst->write(bands[i]->bytes() + dataOffsets[i], dataSize)) {
+            return false;
+        }
+        bands[i] = nullptr;
+    }
+    return dst->write(kEndOfImage, sizeof(kEndOfImage));
+}
+
 namespace SkJpegEncoder {
 
 bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
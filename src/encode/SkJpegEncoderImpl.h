@@ -82,6 +82,17 @@ private:
     SkJpegEncoderImpl(std::unique_ptr<SkJpegEncoderMgr>, const SkPixmap& src);
     SkJpegEncoderImpl(std::unique_ptr<SkJpegEncoderMgr>, const SkYUVAPixmaps& srcYUVA);
 
+    // Converts rows [startRow, startRow + numRows) of the source as needed and passes them to
+    // |mgr|'s compressor. |storage| must hold one converted row. The caller must have set a
+    // jump buffer on |mgr|'s error manager.
+    bool writeRows(SkJpegEncoderMgr* mgr, int startRow, int numRows, uint8_t* storage);
+
+    // Encodes rows [startRow, endRow) as a standalone JPEG.
+    sk_sp<SkData> encodeBand(int startRow, int endRow, bool writeMetadata);
+
+    // Encodes the bands concurrently and writes them to the stream as one JPEG.
+    bool encodeBandsInParallel();
+
     std::unique_ptr<SkJpegEncoderMgr> fEncoderMgr;
     std::optional<SkYUVAPixmaps> fSrcYUVA;
 };
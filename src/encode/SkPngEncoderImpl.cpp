@@ -14,6 +14,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
@@ -27,8 +28,11 @@
 #include "include/private/SkEncodedInfo.h"
 #include "include/private/SkGainmapInfo.h"
 #include "include/private/SkNoncopyable.h"
+#include "include/private/SkTFitsIn.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkPngPriv.h"
+#include "src/core/SkSafeMath.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/encode/SkImageEncoderFns.h"
 #include "src/encode/SkImageEncoderPriv.h"
 #include "src/encode/SkPngEncoderBase.h"
@@ -38,6 +42,7 @@
 #include <array>
 #include <setjmp.h>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <memory>
 #include <utility>
@@ -45,6 +50,7 @@
 
 #include <png.h>
 #include <pngconf.h>
+#include <zlib.h>
 
 class GrDirectContext;
 class SkImage;
@@ -90,6 +96,8 @@ public:
     png_structp pngPtr() { return fPngPtr; }
     png_infop infoPtr() { return fInfoPtr; }
     transform_scanline_proc proc() const { return fProc; }
+    int filters() const { return fFilters; }
+    int zlibLevel() const { return fZLibLevel; }
 
     ~SkPngEncoderMgr() { png_destroy_write_struct(&fPngPtr, &fInfoPtr); }
 
@@ -99,6 +107,8 @@ private:
     png_structp fPngPtr;
     png_infop fInfoPtr;
     transform_scanline_proc fProc = nullptr;
+    int fFilters = PNG_ALL_FILTERS;
+    int fZLibLevel = Z_DEFAULT_COMPRESSION;
 };
 
 std::unique_ptr<SkPngEncoderMgr> SkPngEncoderMgr::Make(SkWStream* stream) {
@@ -236,10 +246,12 @@ bool SkPngEncoderMgr::setHeader(const SkPngEncoderBase::TargetInfo& targetInfo,
     int filters = (int)options.fFilterFlags & (int)SkPngEncoder::FilterFlag::kAll;
     SkASSERT(filters == (int)options.fFilterFlags);
     png_set_filter(fPngPtr, PNG_FILTER_TYPE_BASE, filters);
+    fFilters = filters;
 
     int zlibLevel = std::min(std::max(0, options.fZLibLevel), 9);
     SkASSERT(zlibLevel == options.fZLibLevel);
     png_set_compression_level(fPngPtr, zlibLevel);
+    fZLibLevel = zlibLevel;
 
     // Set comments in tEXt chunk
     const sk_sp<SkDataTable>& comments = options.fComments;
@@ -434,14 +446,246 @@ bool SkPngEncoderMgr::writeInfo(const SkImageInfo& srcInfo, const SkPngEncoderBa
   return true;
 }
 
+// Parallel encoding splits the filtered image into bands of roughly this many bytes, each of
+// which is deflated independently (the same scheme pigz uses for gzip).
+static constexpr size_t kParallelBandBytes = 256 * 1024;
+
+// Each band is primed with this much of the preceding data so matches can reach back across
+// the band boundary, which keeps the output close to the size of a serial encode.
+static constexpr size_t kDeflateWindowBytes = 32 * 1024;
+
+static constexpr size_t kMaxIDATBytes = 64 * 1024;
+
+static int paeth_predictor(int a, int b, int c) {
+    int p = a + b - c;
+    int pa = std::abs(p - a);
+    int pb = std::abs(p - b);
+    int pc = std::abs(p - c);
+    if (pa <= pb && pa <= pc) {
+        return a;
+    }
+    return pb <= pc ? b : c;
+}
+
+// Applies PNG filter `kFilter` to `row`, whose predecessor is `prev` (all zeros for the first
+// row), writing `rowBytes` filtered bytes to `dst`.
+template <int kFilter>
+static void filter_row(const uint8_t* row, const uint8_t* prev, size_t rowBytes, size_t bpp,
+                       uint8_t* dst) {
+    for (size_t i = 0; i < rowBytes; ++i) {
+        int a = i >= bpp ? row[i - bpp] : 0;
+        int b = prev[i];
+        int c = i >= bpp ? prev[i - bpp] : 0;
+        int predictor;
+        if constexpr (kFilter == PNG_FILTER_VALUE_NONE) {
+            predictor = 0;
+        } else if constexpr (kFilter == PNG_FILTER_VALUE_SUB) {
+            predictor = a;
+        } else if constexpr (kFilter == PNG_FILTER_VALUE_UP) {
+            predictor = b;
+        } else if constexpr (kFilter == PNG_FILTER_VALUE_AVG) {
+            predictor = (a + b) >> 1;
+        } else {
+            predictor = paeth_predictor(a, b, c);
+        }
+        dst[i] = static_cast<uint8_t>(row[i] - predictor);
+    }
+}
+
+static void filter_row(int filter, const uint8_t* row, const uint8_t* prev, size_t rowBytes,
+                       size_t bpp, uint8_t* dst) {
+    switch (filter) {
+        case PNG_FILTER_VALUE_NONE:
+            filter_row<PNG_FILTER_VALUE_NONE>(row, prev, rowBytes, bpp, dst);
+            break;
+        case PNG_FILTER_VALUE_SUB:
+            filter_row<PNG_FILTER_VALUE_SUB>(row, prev, rowBytes, bpp, dst);
+            break;
+        case PNG_FILTER_VALUE_UP:
+            filter_row<PNG_FILTER_VALUE_UP>(row, prev, rowBytes, bpp, dst);
+            break;
+        case PNG_FILTER_VALUE_AVG:
+            filter_row<PNG_FILTER_VALUE_AVG>(row, prev, rowBytes, bpp, dst);
+            break;
+        default:
+            filter_row<PNG_FILTER_VALUE_PAETH>(row, prev, rowBytes, bpp, dst);
+            break;
+    }
+}
+
+// libpng's heuristic: treat filtered bytes as signed and prefer the smallest sum of magnitudes.
+static size_t filter_cost(const uint8_t* filtered, size_t rowBytes) {
+    size_t sum = 0;
+    for (size_t i = 0; i < rowBytes; ++i) {
+        sum += filtered[i] < 128 ? filtered[i] : 256 - filtered[i];
+    }
+    return sum;
+}
+
+// Filters rows [startRow, endRow) of `rows` into `dst`, where each output row is prefixed by
+// its filter type byte.  `filters` is a mask of PNG_FILTER_* flags.
+static void filter_rows(const uint8_t* rows, int startRow, int endRow, size_t rowBytes,
+                        size_t bpp, int filters, uint8_t* dst) {
+    std::vector<uint8_t> zeroRow(rowBytes, 0);
+    std::vector<uint8_t> candidate;
+    int filterCount = 0;
+    int onlyFilter = PNG_FILTER_VALUE_NONE;
+    for (int f = PNG_FILTER_VALUE_NONE; f <= PNG_FILTER_VALUE_PAETH; ++f) {
+        if (filters & (PNG_FILTER_NONE << f)) {
+            filterCount++;
+            onlyFilter = f;
+        }
+    }
+    if (filterCount > 1) {
+        candidate.resize(rowBytes);
+    }
+
+    for (int y = startRow; y < endRow; ++y) {
+        const uint8_t* row = rows + y * rowBytes;
+        const uint8_t* prev = y > 0 ? row - rowBytes : zeroRow.data();
+        uint8_t* out = dst + y * (rowBytes + 1);
+        if (filterCount <= 1) {
+            out[0] = static_cast<uint8_t>(onlyFilter);
+            filter_row(onlyFilter, row, prev, rowBytes, bpp, out + 1);
+            continue;
+        }
+
+        size_t bestCost = SIZE_MAX;
+        for (int f = PNG_FILTER_VALUE_NONE; f <= PNG_FILTER_VALUE_PAETH; ++f) {
+            if (!(filters & (PNG_FILTER_NONE << f))) {
+                continue;
+            }
+            filter_row(f, row, prev, rowBytes, bpp, candidate.data());
+            size_t cost = filter_cost(candidate.data(), rowBytes);
+            if (cost < bestCost) {
+                bestCost = cost;
+                out[0] = static_cast<uint8_t>(f);
+                memcpy(out + 1, candidate.data(), rowBytes);
+            }
+        }
+    }
+}
+
+struct DeflatedBand {
+    std::vector<uint8_t> fBytes;
+    uLong fAdler = 0;
+    bool fSuccess = false;
+};
+
+// Raw-deflates data[offset, offset + length).  Every band but the last ends with a sync flush
+// so that it stops on a byte boundary without setting BFINAL, and the bands can be concatenated.
+static void deflate_band(const uint8_t* data, size_t offset, size_t length, bool last, int level,
+                         DeflatedBand* band) {
+    if (!SkTFitsIn<uInt>(length)) {
+        return;
+    }
+
+    z_stream zs = {};
+    if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+        return;
+    }
+    if (offset > 0) {
+        size_t dictLength = std::min(offset, kDeflateWindowBytes);
+        deflateSetDictionary(&zs, data + offset - dictLength, static_cast<uInt>(dictLength));
+    }
+
+    std::vector<uint8_t>& out = band->fBytes;
+    // Leave room for the empty stored block written by Z_SYNC_FLUSH.
+    out.resize(deflateBound(&zs, length) + 16);
+    zs.next_in = const_cast<Bytef*>(data + offset);
+    zs.avail_in = static_cast<uInt>(length);
+    zs.next_out = out.data();
+    zs.avail_out = static_cast<uInt>(out.size());
+
+    const int flush = last ? Z_FINISH : Z_SYNC_FLUSH;
+    bool success = false;
+    while (true) {
+        int ret = deflate(&zs, flush);
+        if (ret == Z_STREAM_ERROR) {
+            break;
+        }
+        if (last ? ret == Z_STREAM_END : zs.avail_out != 0) {
+            success = true;
+            break;
+        }
+        size_t used = out.size() - zs.avail_out;
+        out.resize(out.size() * 2);
+        zs.next_out = out.data() + used;
+        zs.avail_out = static_cast<uInt>(out.size() - used);
+    }
+    out.resize(out.size() - zs.avail_out);
+    deflateEnd(&zs);
+
+    band->fAdler = adler32(adler32(0L, Z_NULL, 0), data + offset, static_cast<uInt>(length));
+    band->fSuccess = success;
+}
+
+// The RFC 1950 header zlib itself would write for a 32K window at `level`.
+static std::array<uint8_t, 2> zlib_header(int level) {
+    int levelFlags = level < 2 ? 0 : level < 6 ? 1 : level == 6 ? 2 : 3;
+    unsigned header = (Z_DEFLATED + ((MAX_WBITS - 8) << 4)) << 8;
+    header |= levelFlags << 6;
+    header += 31 - (header % 31);
+    return {static_cast<uint8_t>(header >> 8), static_cast<uint8_t>(header & 0xff)};
+}
+
+static bool write_idat_and_iend(png_structp pngPtr, const std::vector<uint8_t>& zlibStream) {
+    if (setjmp(png_jmpbuf(pngPtr))) {
+        return false;
+    }
+
+    static constexpr png_byte kIDAT[5] = {'I', 'D', 'A', 'T', '\0'};
+    static constexpr png_byte kIEND[5] = {'I', 'E', 'N', 'D', '\0'};
+    for (size_t offset = 0; offset < zlibStream.size(); offset += kMaxIDATBytes) {
+        size_t length = std::min(kMaxIDATBytes, zlibStream.size() - offset);
+        png_write_chunk(pngPtr, kIDAT, zlibStream.data() + offset, length);
+    }
+    // png_write_end() refuses to run when libpng did not write the IDATs itself.  Everything
+    // it would otherwise emit was already written by png_write_info(), so only IEND remains.
+    png_write_chunk(pngPtr, kIEND, nullptr, 0);
+    return true;
+}
+
 SkPngEncoderImpl::SkPngEncoderImpl(TargetInfo targetInfo,
                                    std::unique_ptr<SkPngEncoderMgr> encoderMgr,
-                                   const SkPixmap& src)
-        : SkPngEncoderBase(std::move(targetInfo), src), fEncoderMgr(std::move(encoderMgr)) {}
+                                   const SkPixmap& src,
+                                   SkExecutor* executor)
+        : SkPngEncoderBase(std::move(targetInfo), src)
+        , fEncoderMgr(std::move(encoderMgr))
+        , fExecutor(executor) {}
 
 SkPngEncoderImpl::~SkPngEncoderImpl() {}
 
 bool SkPngEncoderImpl::onEncodeRow(SkSpan<const uint8_t> row) {
+    if (fExecutor) {
+        png_structp pngPtr = fEncoderMgr->pngPtr();
+        png_infop infoPtr = fEncoderMgr->infoPtr();
+        const size_t rowBytes = png_get_rowbytes(pngPtr, infoPtr);
+        const size_t bytesPerChannel = png_get_bit_depth(pngPtr, infoPtr) / 8;
+        const size_t dstPixelBytes = png_get_channels(pngPtr, infoPtr) * bytesPerChannel;
+        const size_t srcPixelBytes = row.size() / fSrc.width();
+
+        // Apply the transforms writeInfo() and the serial path ask libpng to do: drop the
+        // filler channel of opaque RGBA, and store 16-bit channels big endian.
+        size_t start = fRows.size();
+        fRows.resize(start + rowBytes);
+        uint8_t* dst = fRows.data() + start;
+        if (srcPixelBytes == dstPixelBytes) {
+            memcpy(dst, row.data(), rowBytes);
+        } else {
+            SkASSERT(srcPixelBytes > dstPixelBytes);
+            for (int x = 0; x < fSrc.width(); ++x) {
+                memcpy(dst + x * dstPixelBytes, row.data() + x * srcPixelBytes, dstPixelBytes);
+            }
+        }
+        if (bytesPerChannel == 2) {
+            for (size_t i = 0; i < rowBytes; i += 2) {
+                std::swap(dst[i], dst[i + 1]);
+            }
+        }
+        return true;
+    }
+
     if (setjmp(png_jmpbuf(fEncoderMgr->pngPtr()))) {
         return false;
     }
@@ -461,6 +705,10 @@ bool SkPngEncoderImpl::onEncodeRow(SkSpan<const uint8_t> row) {
 }
 
 bool SkPngEncoderImpl::onFinishEncoding() {
+    if (fExecutor) {
+        return this->encodeRowsInParallel();
+    }
+
     if (setjmp(png_jmpbuf(fEncoderMgr->pngPtr()))) {
         return false;
     }
@@ -469,6 +717,66 @@ bool SkPngEncoderImpl::onFinishEncoding() {
     return true;
 }
 
+bool SkPngEncoderImpl::encodeRowsInParallel() {
+    png_structp pngPtr = fEncoderMgr->pngPtr();
+    png_infop infoPtr = fEncoderMgr->infoPtr();
+    const int height = fSrc.height();
+    const size_t rowBytes = png_get_rowbytes(pngPtr, infoPtr);
+    const size_t bpp = std::max<size_t>(
+            1, png_get_channels(pngPtr, infoPtr) * png_get_bit_depth(pngPtr, infoPtr) / 8);
+    SkASSERT(fRows.size() == rowBytes * height);
+
+    SkSafeMath safe;
+    const size_t filteredRowBytes = safe.add(rowBytes, 1);
+    const size_t filteredBytes = safe.mul(filteredRowBytes, height);
+    if (!safe.ok()) {
+        return false;
+    }
+    const int rowsPerBand = static_cast<int>(std::min<size_t>(
+            height, std::max<size_t>(1, kParallelBandBytes / filteredRowBytes)));
+    const int bandCount = (height + rowsPerBand - 1) / rowsPerBand;
+
+    std::vector<uint8_t> filtered(filteredBytes);
+    const int filters = fEncoderMgr->filters();
+    const int level = fEncoderMgr->zlibLevel();
+    SkTaskGroup taskGroup(*fExecutor);
+    taskGroup.batch(bandCount, [&](int i) {
+        filter_rows(fRows.data(), i * rowsPerBand, std::min(height, (i + 1) * rowsPerBand),
+                    rowBytes, bpp, filters, filtered.data());
+    });
+    taskGroup.wait();
+    fRows = {};
+
+    // Deflating needs the filtered bytes before each band as its dictionary, so it can only
+    // start once every band has been filtered.
+    std::vector<DeflatedBand> bands(bandCount);
+    taskGroup.batch(bandCount, [&](int i) {
+        size_t offset = i * rowsPerBand * filteredRowBytes;
+        size_t end = std::min(height, (i + 1) * rowsPerBand) * filteredRowBytes;
+        deflate_band(filtered.data(), offset, end - offset, i == bandCount - 1, level, &bands[i]);
+    });
+    taskGroup.wait();
+
+    std::array<uint8_t, 2> header = zlib_header(level);
+    std::vector<uint8_t> zlibStream(header.begin(), header.end());
+    uLong adler = adler32(0L, Z_NULL, 0);
+    for (int i = 0; i < bandCount; ++i) {
+        if (!bands[i].fSuccess) {
+            return false;
+        }
+        size_t offset = i * rowsPerBand * filteredRowBytes;
+        size_t end = std::min(height, (i + 1) * rowsPerBand) * filteredRowBytes;
+        adler = adler32_combine(adler, bands[i].fAdler, end - offset);
+        zlibStream.insert(zlibStream.end(), bands[i].fBytes.begin(), bands[i].fBytes.end());
+        bands[i].fBytes = {};
+    }
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        zlibStream.push_back(static_cast<uint8_t>(adler >> shift));
+    }
+
+    return write_idat_and_iend(pngPtr, zlibStream);
+}
+
 namespace SkPngEncoder {
 std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Options& options) {
     if (!SkPixmapIsValid(src)) {
@@ -501,7 +809,8 @@ std::unique_ptr<SkEncoder> Make(SkWStream* dst, const SkPixmap& src, const Optio
     if (!encoderMgr->writeInfo(src.info(), targetInfo.value())) {
         return nullptr;
     }
-    return std::make_unique<SkPngEncoderImpl>(std::move(*targetInfo), std::move(encoderMgr), src);
+    return std::make_unique<SkPngEncoderImpl>(
+            std::move(*targetInfo), std::move(encoderMgr), src, options.fExecutor);
 }
 
 bool Encode(SkWStream* dst, const SkPixmap& src, const Options& options) {
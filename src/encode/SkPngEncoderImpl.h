@@ -14,7 +14,9 @@
 #include "src/encode/SkPngEncoderBase.h"
 
 #include <memory>
+#include <vector>
 
+class SkExecutor;
 class SkPixmap;
 class SkPngEncoderMgr;
 
@@ -22,7 +24,10 @@ class SkPngEncoderImpl final : public SkPngEncoderBase {
 public:
     // public so it can be called from SkPngEncoder namespace. It should only be made
     // via SkPngEncoder::Make
-    SkPngEncoderImpl(TargetInfo targetInfo, std::unique_ptr<SkPngEncoderMgr>, const SkPixmap& src);
+    SkPngEncoderImpl(TargetInfo targetInfo,
+                     std::unique_ptr<SkPngEncoderMgr>,
+                     const SkPixmap& src,
+                     SkExecutor* executor = nullptr);
     ~SkPngEncoderImpl() override;
 
 protected:
@@ -30,5 +35,13 @@ protected:
     bool onFinishEncoding() override;
 
     std::unique_ptr<SkPngEncoderMgr> fEncoderMgr;
+
+private:
+    bool encodeRowsInParallel();
+
+    // When non-null, rows are collected in fRows (already in PNG byte order) and compressed
+    // in bands by encodeRowsInParallel() instead of being streamed through libpng.
+    SkExecutor* fExecutor;
+    std::vector<uint8_t> fRows;
 };
 #endif
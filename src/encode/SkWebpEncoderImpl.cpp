@@ -87,6 +87,7 @@ static bool preprocess_webp_picture(WebPPicture* pic,
         webp_config->method = 0;
         pic->use_argb = 1;
     }
+    webp_config->thread_level = opts.fUseThreads ? 1 : 0;
 
     {
         const SkColorType ct = pixmap.colorType();
@@ -0,0 +1,114 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkTiledRaster.h"
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
+#include "src/core/SkBigPicture.h"
+#include "src/core/SkPicturePriv.h"
+#include "src/core/SkSurfacePriv.h"
+#include "src/image/SkSurface_Base.h"
+
+#include <algorithm>
+
+namespace SkTiledRaster {
+
+bool DrawPicture(SkSurface* surface, const SkPicture* picture, const Options& options) {
+    if (!surface || !asSB(surface)->isRasterBacked()) {
+        return false;
+    }
+    if (!picture) {
+        return true;
+    }
+
+    // Fork the pixels away from any outstanding snapshot before we write to them directly.
+    surface->notifyContentWillChange(SkSurface::kRetain_ContentChangeMode);
+    SkPixmap pm;
+    if (!surface->peekPixels(&pm)) {
+        return false;
+    }
+
+    if (const SkBigPicture* bp = SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture))) {
+        bp->playbackTiled(pm, surface->props(), options.fTileSize, options.fExecutor);
+    } else {
+        SkBitmap bitmap;
+        bitmap.installPixels(pm);
+        SkCanvas(bitmap, surface->props()).drawPicture(picture);
+    }
+    return true;
+}
+
+std::vector<sk_sp<SkImage>> DrawPictureTiles(const SkPicture* picture,
+                                             const SkImageInfo& info,
+                                             const Options& options,
+                                             const SkSurfaceProps* props) {
+    const SkISize tileSize = options.fTileSize;
+    if (!picture || info.isEmpty() || tileSize.isEmpty() ||
+        !SkSurfaceValidateRasterInfo(info.makeDimensions(
+                {std::min(tileSize.width(), info.width()),
+                 std::min(tileSize.height(), info.height())}))) {
+        return {};
+    }
+    const int tilesX = (info.width()  + tileSize.width()  - 1) / tileSize.width(),
+              tilesY = (info.height() + tileSize.height() - 1) / tileSize.height();
+
+    std::vector<SkBitmap> bitmaps(tilesX * tilesY);
+    std::vector<SkPixmap> pixmaps(bitmaps.size());
+    for (int y = 0; y < tilesY; y++) {
+        for (int x = 0; x < tilesX; x++) {
+            const SkIRect tile = SkIRect::MakeXYWH(x * tileSize.width(), y * tileSize.height(),
+                                                   tileSize.width(), tileSize.height());
+            const int i = y * tilesX + x;
+            if (!bitmaps[i].tryAllocPixels(info.makeDimensions(
+                        {std::min(tile.fRight, info.width()) - tile.fLeft,
+                         std::min(tile.fBottom, info.height()) - tile.fTop}))) {
+                return {};
+            }
+            bitmaps[i].peekPixels(&pixmaps[i]);
+        }
+    }
+
+    const SkSurfaceProps surfaceProps = props ? *props : SkSurfaceProps();
+    if (const SkBigPicture* bp = SkPicturePriv::AsSkBigPicture(sk_ref_sp(picture))) {
+        if (!bp->playbackTiles(info.dimensions(), tileSize, pixmaps, surfaceProps,
+                               options.fExecutor)) {
+            return {};
+        }
+    } else {
+        SkBitmap whole;
+        if (!whole.tryAllocPixels(info)) {
+            return {};
+        }
+        whole.eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas(whole, surfaceProps).drawPicture(picture);
+        for (size_t i = 0; i < pixmaps.size(); i++) {
+            whole.readPixels(pixmaps[i],
+                             (int)(i % tilesX) * tileSize.width(),
+                             (int)(i / tilesX) * tileSize.height());
+        }
+    }
+
+    std::vector<sk_sp<SkImage>> images;
+    images.reserve(bitmaps.size());
+    for (SkBitmap& bitmap : bitmaps) {
+        bitmap.setImmutable();
+        images.push_back(bitmap.asImage());
+    }
+    return images;
+}
+
+}  // namespace SkTiledRaster
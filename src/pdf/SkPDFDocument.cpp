@@ -9,6 +9,7 @@
 
 #include "include/core/SkCanvas.h"
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPoint.h"
@@ -24,6 +25,7 @@
 #include "include/private/SkThreadAnnotations.h"
 #include "include/private/SkTo.h"
 #include "src/core/SkAdvancedTypefaceMetrics.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTHash.h"
 #include "src/core/SkUTF.h"
 #include "src/pdf/SkBitmapKey.h"
@@ -130,12 +132,16 @@ static void serializeHeader(SkPDFOffsetMap* offsetMap, SkWStream* wStream) {
 }
 #undef SKPDF_MAGIC
 
+static void write_indirect_object_header(SkPDFIndirectReference ref, SkWStream* s) {
+    s->writeDecAsText(ref.fValue);
+    s->writeText(" 0 obj\n");  // Generation number is always 0.
+}
+
 static void begin_indirect_object(SkPDFOffsetMap* offsetMap,
                                   SkPDFIndirectReference ref,
                                   SkWStream* s) {
     offsetMap->markStartOfObject(ref.fValue, s);
-    s->writeDecAsText(ref.fValue);
-    s->writeText(" 0 obj\n");  // Generation number is always 0.
+    write_indirect_object_header(ref, s);
 }
 
 static void end_indirect_object(SkWStream* s) { s->writeText("\nendobj\n"); }
@@ -256,21 +262,89 @@ SkPDFIndirectReference SkPDFDocument::emit(const SkPDFObject& object, SkPDFIndir
     return ref;
 }
 
+namespace {
+// Identifies the addJob() job running on this thread, if any.
+struct CurrentJob {
+    const SkPDFDocument* fDocument = nullptr;
+    SkPDFPendingOutput* fOutput = nullptr;
+};
+thread_local CurrentJob gCurrentJob;
+}  // namespace
+
 SkWStream* SkPDFDocument::beginObject(SkPDFIndirectReference ref) SK_REQUIRES(fMutex) {
+    SkPDFPendingOutput* output = gCurrentJob.fDocument == this ? gCurrentJob.fOutput : nullptr;
+    if (!output && !fPendingOutput.empty()) {
+        // Jobs added earlier have not been written yet, so this object has to wait for them.
+        if (!fPendingOutput.back()->fFinished) {
+            fPendingOutput.push_back(std::make_unique<SkPDFPendingOutput>());
+            fPendingOutput.back()->fFinished = true;
+        }
+        output = fPendingOutput.back().get();
+    }
+    // Output at the front of the queue with nothing buffered yet can go straight to the stream.
+    if (output && !(output == fPendingOutput.front().get() && output->fObjects.empty())) {
+        SkASSERT(!fBufferedObjectOutput);
+        fBufferedObjectOutput = output;
+        fBufferedObjectRef = ref;
+        write_indirect_object_header(ref, &fBufferedObject);
+        return &fBufferedObject;
+    }
     begin_indirect_object(&fOffsetMap, ref, this->getStream());
     return this->getStream();
 }
 
 void SkPDFDocument::endObject() SK_REQUIRES(fMutex) {
+    if (SkPDFPendingOutput* output = std::exchange(fBufferedObjectOutput, nullptr)) {
+        end_indirect_object(&fBufferedObject);
+        output->fObjects.emplace_back(fBufferedObjectRef, fBufferedObject.detachAsData());
+        this->writePendingOutput();
+        return;
+    }
     end_indirect_object(this->getStream());
 }
 
+void SkPDFDocument::writePendingOutput() SK_REQUIRES(fMutex) {
+    while (!fPendingOutput.empty() && fPendingOutput.front()->fFinished) {
+        for (const auto& [ref, data] : fPendingOutput.front()->fObjects) {
+            fOffsetMap.markStartOfObject(ref.fValue, this->getStream());
+            this->getStream()->write(data->data(), data->size());
+        }
+        fPendingOutput.pop_front();
+    }
+}
+
+SkExecutor* SkPDFDocument::executor() const {
+    return gCurrentJob.fDocument == this ? nullptr : fExecutor;
+}
+
+void SkPDFDocument::addJob(std::function<void()> job) {
+    SkASSERT(fExecutor);
+    SkPDFPendingOutput* output;
+    {
+        SkAutoMutexExclusive lock(fMutex);
+        fPendingOutput.push_back(std::make_unique<SkPDFPendingOutput>());
+        output = fPendingOutput.back().get();
+    }
+    fJobCount++;
+    fExecutor->add([this, output, job = std::move(job)]() {
+        CurrentJob previous = std::exchange(gCurrentJob, CurrentJob{this, output});
+        job();
+        gCurrentJob = previous;
+        {
+            SkAutoMutexExclusive lock(fMutex);
+            output->fFinished = true;
+            this->writePendingOutput();
+        }
+        fSemaphore.signal();
+    });
+}
+
 static SkSize operator*(SkISize u, SkScalar s) { return SkSize{u.width() * s, u.height() * s}; }
 static SkSize operator*(SkSize u, SkScalar s) { return SkSize{u.width() * s, u.height() * s}; }
 
 SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         // if this is the first page if the document.
         {
             SkAutoMutexExclusive autoMutexAcquire(fMutex);
@@ -288,6 +362,9 @@ SkCanvas* SkPDFDocument::onBeginPage(SkScalar width, SkScalar height) {
             // works best with reproducible outputs.
             fXMP = SkPDFMetadata::MakeXMPObject(fMetadata, fUUID, fUUID, this);
         }
+        if (fMetadata.fStreamPages) {
+            fPageTreeRoot = this->reserveRef();
+        }
     }
     // By scaling the page at the device level, we will create bitmap layer
     // devices at the rasterized scale, not the 72dpi scale.  Bitmap layer
@@ -402,7 +479,15 @@ void SkPDFDocument::onEndPage() {
     // Tabs is PDF 1.5, but setting it checks an accessibility box.
     page->insertName("Tabs", "S");
 
-    fPages.emplace_back(std::move(page));
+    if (fMetadata.fStreamPages) {
+        page->insertRef("Parent", fPageTreeRoot);
+        this->emit(*page, this->currentPage());
+        // Pattern keys can be large, so only share patterns within a page.
+        fGradientPatternMap.reset();
+        fImageShaderMap.reset();
+    } else {
+        fPages.emplace_back(std::move(page));
+    }
     fPageDevice = nullptr;
 }
 
@@ -627,7 +712,7 @@ SkString SkPDFDocument::nextFontSubsetTag() {
 
 void SkPDFDocument::onClose(SkWStream* stream) {
     SkASSERT(fCanvas.imageInfo().dimensions().isZero());
-    if (fPages.empty()) {
+    if (fPageRefs.empty()) {
         this->waitForJobs();
         return;
     }
@@ -640,7 +725,20 @@ void SkPDFDocument::onClose(SkWStream* stream) {
         docCatalog->insertObject("OutputIntents", make_srgb_output_intents(this));
     }
 
-    docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+    if (fMetadata.fStreamPages) {
+        // The pages were written as they ended, all pointing at one Pages node.
+        SkPDFDict pageTreeRoot("Pages");
+        auto kids = SkPDFMakeArray();
+        kids->reserve(fPageRefs.size());
+        for (SkPDFIndirectReference pageRef : fPageRefs) {
+            kids->appendRef(pageRef);
+        }
+        pageTreeRoot.insertInt("Count", SkToInt(fPageRefs.size()));
+        pageTreeRoot.insertObject("Kids", std::move(kids));
+        docCatalog->insertRef("Pages", this->emit(pageTreeRoot, fPageTreeRoot));
+    } else {
+        docCatalog->insertRef("Pages", generate_page_tree(this, std::move(fPages), fPageRefs));
+    }
 
     if (!fNamedDestinations.empty()) {
         docCatalog->insertRef("Dests", append_destinations(this, fNamedDestinations));
@@ -677,21 +775,37 @@ void SkPDFDocument::onClose(SkWStream* stream) {
 
     auto docCatalogRef = this->emit(*docCatalog);
 
-    for (const SkPDFFont* f : get_fonts(*this)) {
-        f->emitSubset(this);
+    std::vector<const SkPDFFont*> fonts = get_fonts(*this);
+    if (fExecutor) {
+        // Subsetting font programs and building ToUnicode CMaps dominate closing text-heavy
+        // documents.  Do that concurrently, then emit the fonts in order on this thread so
+        // object numbers and output match a single-threaded run.
+        std::vector<SkPDFFont::PreparedSubset> prepared(fonts.size());
+        for (const SkPDFFont* f : fonts) {
+            f->primeSubsetCaches(this);
+        }
+        SkTaskGroup taskGroup(*fExecutor);
+        taskGroup.batch(SkToInt(fonts.size()), [&](int i) {
+            prepared[i] = fonts[i]->prepareSubset(*this);
+        });
+        taskGroup.wait();
+        for (size_t i = 0; i < fonts.size(); ++i) {
+            fonts[i]->emitSubset(this, &prepared[i]);
+        }
+    } else {
+        for (const SkPDFFont* f : fonts) {
+            f->emitSubset(this);
+        }
     }
 
     this->waitForJobs();
     {
         SkAutoMutexExclusive autoMutexAcquire(fMutex);
+        SkASSERT(fPendingOutput.empty());
         serialize_footer(fOffsetMap, this->getStream(), fInfoDict, docCatalogRef, fUUID);
     }
 }
 
-void SkPDFDocument::incrementJobCount() { fJobCount++; }
-
-void SkPDFDocument::signalJobComplete() { fSemaphore.signal(); }
-
 void SkPDFDocument::waitForJobs() {
      // fJobCount can increase while we wait.
      while (fJobCount > 0) {
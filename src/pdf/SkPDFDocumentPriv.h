@@ -35,6 +35,9 @@
 #include <cstddef>
 #include <cstdint>
 #include <atomic>
+#include <deque>
+#include <functional>
+#include <utility>
 #include <vector>
 #include <memory>
 
@@ -65,6 +68,14 @@ private:
 };
 
 
+// Objects that must be written at a fixed position in the document, held until everything
+// before that position has been written.  See SkPDFDocument::addJob().
+struct SkPDFPendingOutput {
+    std::vector<std::pair<SkPDFIndirectReference, sk_sp<SkData>>> fObjects;
+    bool fFinished = false;
+};
+
+
 struct SkPDFNamedDestination {
     sk_sp<SkData> fName;
     SkPoint fPoint;
@@ -162,10 +173,17 @@ public:
     // Returns a tag to prepend to a PostScript name of a subset font. Includes the '+'.
     SkString nextFontSubsetTag();
 
-    SkExecutor* executor() const { return fExecutor; }
-    void incrementJobCount();
-    void signalJobComplete();
-    size_t currentPageIndex() { return fPages.size(); }
+    /** Returns the executor to offload work to, or nullptr if work should be done inline.
+        This is always nullptr inside a job started by addJob(), so nested work is written
+        with the job that caused it. */
+    SkExecutor* executor() const;
+
+    /** Runs the job on the executor.  Objects emitted by the job are written to the document
+        as though it ran synchronously at this point, so object order, and therefore the
+        output bytes, do not depend on thread timing. */
+    void addJob(std::function<void()> job);
+
+    size_t currentPageIndex() { return SkASSERT(!fPageRefs.empty()), fPageRefs.size() - 1; }
     size_t pageCount() { return fPageRefs.size(); }
 
     const SkMatrix& currentPageTransform() const;
@@ -204,6 +222,8 @@ private:
     SkCanvas fCanvas;
     std::vector<std::unique_ptr<SkPDFDict>> fPages;
     std::vector<SkPDFIndirectReference> fPageRefs;
+    // With SkPDF::Metadata::fStreamPages, the single Pages node every page points at.
+    SkPDFIndirectReference fPageTreeRoot;
 
     sk_sp<SkPDFDevice> fPageDevice;
     std::atomic<int> fNextObjectNumber = {1};
@@ -223,7 +243,15 @@ private:
     SkMutex fMutex;
     SkSemaphore fSemaphore;
 
+    // Output of jobs (and of objects emitted after them) that has not been written yet, in
+    // document order.  fBufferedObject* describe the object being emitted into it, if any.
+    std::deque<std::unique_ptr<SkPDFPendingOutput>> fPendingOutput SK_GUARDED_BY(fMutex);
+    SkPDFPendingOutput* fBufferedObjectOutput SK_GUARDED_BY(fMutex) = nullptr;
+    SkPDFIndirectReference fBufferedObjectRef SK_GUARDED_BY(fMutex);
+    SkDynamicMemoryWStream fBufferedObject SK_GUARDED_BY(fMutex);
+
     void waitForJobs();
+    void writePendingOutput() SK_REQUIRES(fMutex);
     SkWStream* beginObject(SkPDFIndirectReference);
     void endObject();
 };
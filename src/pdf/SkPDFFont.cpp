@@ -442,7 +442,62 @@ void SkPDFFont::PopulateCommonFontDescriptor(SkPDFDict* descriptor,
 //  Type0Font
 ///////////////////////////////////////////////////////////////////////////////
 
-static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
+static bool is_type0(SkAdvancedTypefaceMetrics::FontType type) {
+    return type == SkAdvancedTypefaceMetrics::kType1CID_Font ||
+           type == SkAdvancedTypefaceMetrics::kTrueType_Font;
+}
+
+static std::unique_ptr<SkStreamAsset> make_type0_to_unicode(
+        const SkPDFFont& font,
+        const std::vector<SkUnichar>& glyphToUnicode,
+        const THashMap<SkGlyphID, SkString>& glyphToUnicodeEx) {
+    SkASSERT(SkToSizeT(font.strike().fPath.fStrikeSpec.typeface().countGlyphs()) ==
+             glyphToUnicode.size());
+    return SkPDFMakeToUnicodeCmap(glyphToUnicode.data(),
+                                  glyphToUnicodeEx,
+                                  &font.glyphUsage(),
+                                  font.multiByteGlyphs(),
+                                  font.firstGlyphID(),
+                                  font.lastGlyphID());
+}
+
+void SkPDFFont::primeSubsetCaches(SkPDFDocument* doc) const {
+    if (!is_type0(fFontType)) {
+        return;
+    }
+    const SkTypeface& typeface = this->strike().fPath.fStrikeSpec.typeface();
+    SkPDFFont::GetMetrics(typeface, doc);
+    SkPDFFont::GetUnicodeMap(typeface, doc);
+    SkPDFFont::GetUnicodeMapEx(typeface, doc);
+}
+
+SkPDFFont::PreparedSubset SkPDFFont::prepareSubset(const SkPDFDocument& doc) const {
+    PreparedSubset prepared;
+    if (!is_type0(fFontType)) {
+        return prepared;
+    }
+    const SkTypeface& typeface = this->strike().fPath.fStrikeSpec.typeface();
+    SkTypefaceID id = typeface.uniqueID();
+    std::unique_ptr<SkAdvancedTypefaceMetrics>* metrics = doc.fTypefaceMetrics.find(id);
+    const std::vector<SkUnichar>* glyphToUnicode = doc.fToUnicodeMap.find(id);
+    const THashMap<SkGlyphID, SkString>* glyphToUnicodeEx = doc.fToUnicodeMapEx.find(id);
+    if (!metrics || !*metrics || !glyphToUnicode || !glyphToUnicodeEx) {
+        SkDEBUGFAIL("primeSubsetCaches() was not called.");
+        return prepared;
+    }
+
+    if (fFontType == SkAdvancedTypefaceMetrics::kTrueType_Font && can_subset(**metrics)) {
+        SkASSERT(this->firstGlyphID() == 1);
+        prepared.fFontData = SkPDFSubsetFont(typeface, this->glyphUsage());
+    }
+    prepared.fToUnicode = make_type0_to_unicode(*this, *glyphToUnicode, *glyphToUnicodeEx);
+    prepared.fPrepared = true;
+    return prepared;
+}
+
+static void emit_subset_type0(const SkPDFFont& font,
+                              SkPDFDocument* doc,
+                              SkPDFFont::PreparedSubset* prepared) {
     const SkTypeface& typeface = font.strike().fPath.fStrikeSpec.typeface();
     const SkAdvancedTypefaceMetrics* metricsPtr = SkPDFFont::GetMetrics(typeface, doc);
     SkASSERT(metricsPtr);
@@ -466,7 +521,9 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
                  "or kTrueType_Font.\n", &typeface, fontAsset.get());
     } else if (type == SkAdvancedTypefaceMetrics::kTrueType_Font) {
         sk_sp<SkData> subsetFontData;
-        if (can_subset(metrics)) {
+        if (prepared) {
+            subsetFontData = std::move(prepared->fFontData);
+        } else if (can_subset(metrics)) {
             SkASSERT(font.firstGlyphID() == 1);
             subsetFontData = SkPDFSubsetFont(typeface, font.glyphUsage());
         }
@@ -535,16 +592,11 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
     descendantFonts->appendRef(doc->emit(*newCIDFont));
     fontDict.insertObject("DescendantFonts", std::move(descendantFonts));
 
-    const std::vector<SkUnichar>& glyphToUnicode =
-        SkPDFFont::GetUnicodeMap(typeface, doc);
-    SkASSERT(SkToSizeT(typeface.countGlyphs()) == glyphToUnicode.size());
     std::unique_ptr<SkStreamAsset> toUnicode =
-            SkPDFMakeToUnicodeCmap(glyphToUnicode.data(),
-                                   SkPDFFont::GetUnicodeMapEx(typeface, doc),
-                                   &font.glyphUsage(),
-                                   font.multiByteGlyphs(),
-                                   font.firstGlyphID(),
-                                   font.lastGlyphID());
+            prepared ? std::move(prepared->fToUnicode)
+                     : make_type0_to_unicode(font,
+                                             SkPDFFont::GetUnicodeMap(typeface, doc),
+                                             SkPDFFont::GetUnicodeMapEx(typeface, doc));
     fontDict.insertRef("ToUnicode", SkPDFStreamOut(nullptr, std::move(toUnicode), doc));
 
     doc->emit(fontDict, font.indirectReference());
@@ -931,11 +983,14 @@ static void emit_subset_type3(const SkPDFFont& pdfFont, SkPDFDocument* doc) {
     doc->emit(font, pdfFont.indirectReference());
 }
 
-void SkPDFFont::emitSubset(SkPDFDocument* doc) const {
+void SkPDFFont::emitSubset(SkPDFDocument* doc, PreparedSubset* prepared) const {
+    if (prepared && !prepared->fPrepared) {
+        prepared = nullptr;
+    }
     switch (fFontType) {
         case SkAdvancedTypefaceMetrics::kType1CID_Font:
         case SkAdvancedTypefaceMetrics::kTrueType_Font:
-            return emit_subset_type0(*this, doc);
+            return emit_subset_type0(*this, doc, prepared);
 #ifndef SK_PDF_DO_NOT_SUPPORT_TYPE_1_FONTS
         case SkAdvancedTypefaceMetrics::kType1_Font:
             return SkPDFEmitType1Font(*this, doc);
@@ -18,14 +18,17 @@
 #include "src/pdf/SkPDFTypes.h"
 
 #include <cstdint>
+#include <memory>
 #include <vector>
 
+class SkData;
 class SkDescriptor;
 class SkFont;
 class SkGlyph;
 class SkPaint;
 class SkPDFDocument;
 class SkPDFFont;
+class SkStreamAsset;
 class SkString;
 class SkTypeface;
 
@@ -132,7 +135,26 @@ public:
                                              uint16_t emSize,
                                              int16_t defaultWidth);
 
-    void emitSubset(SkPDFDocument*) const;
+    /** The expensive parts of emitSubset() that do not touch the document: the subset font
+     *  program and the ToUnicode CMap.  Only Type0 fonts have anything to prepare.
+     */
+    struct PreparedSubset {
+        bool fPrepared = false;
+        sk_sp<SkData> fFontData;
+        std::unique_ptr<SkStreamAsset> fToUnicode;
+    };
+
+    /** Fills the document caches read by prepareSubset().  Must be called on the thread that
+     *  owns the document.
+     */
+    void primeSubsetCaches(SkPDFDocument*) const;
+
+    /** Only reads the document, so different fonts may be prepared concurrently once their
+     *  caches are primed.
+     */
+    PreparedSubset prepareSubset(const SkPDFDocument&) const;
+
+    void emitSubset(SkPDFDocument*, PreparedSubset* = nullptr) const;
 
     /** Return false iff the typeface has its NotEmbeddable flag set. */
     static bool CanEmbedTypeface(const SkTypeface&, SkPDFDocument*);
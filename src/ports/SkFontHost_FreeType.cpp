@@ -217,6 +217,10 @@ private:
     // RHEL 8             2.9.1
 };
 
+// Guards gFTLibrary and the creation and destruction of faces in it. Since FreeType 2.6 an
+// FT_Library may be shared between threads as long as faces are only opened and closed under a
+// lock, and each FT_Face is only used by one thread at a time. Each FaceRec has its own mutex
+// for the latter, so scalers for different faces run concurrently.
 static SkMutex& f_t_mutex() {
     static SkMutex& mutex = *(new SkMutex);
     return mutex;
@@ -234,6 +238,9 @@ public:
     FT_UShort fFTPaletteEntryCount = 0;
     std::unique_ptr<SkColor[]> fSkPalette;
 
+    // Must be held while using fFace, including its sizes and glyph slot.
+    SkMutex fFaceMutex;
+
     static std::unique_ptr<FaceRec> Make(const SkTypeface_FreeType* typeface);
     ~FaceRec();
 
@@ -445,13 +452,16 @@ SkTypeface_FreeType::FaceRec::Make(const SkTypeface_FreeType* typeface) {
 
 class AutoFTAccess {
 public:
-    AutoFTAccess(const SkTypeface_FreeType* tf) : fFaceRec(nullptr) {
-        f_t_mutex().acquire();
-        fFaceRec = tf->getFaceRec();
+    AutoFTAccess(const SkTypeface_FreeType* tf) : fFaceRec(tf->getFaceRec()) {
+        if (fFaceRec) {
+            fFaceRec->fFaceMutex.acquire();
+        }
     }
 
     ~AutoFTAccess() {
-        f_t_mutex().release();
+        if (fFaceRec) {
+            fFaceRec->fFaceMutex.release();
+        }
     }
 
     FT_Face face() { return fFaceRec ? fFaceRec->fFace.get() : nullptr; }
@@ -514,13 +524,13 @@ private:
     bool      fLCDIsVert;
 
     FT_Error setupSize();
-    // Caller must lock f_t_mutex() before calling this function.
+    // Caller must lock fFaceRec->fFaceMutex before calling this function.
     static bool getBoundsOfCurrentOutlineGlyph(FT_GlyphSlot glyph, SkRect* bounds);
-    // Caller must lock f_t_mutex() before calling this function.
+    // Caller must lock fFaceRec->fFaceMutex before calling this function.
     bool getCBoxForLetter(char letter, FT_BBox* bbox);
     static void updateGlyphBoundsIfSubpixel(const SkGlyph&, SkRect* bounds, bool subpixel);
     void updateGlyphBoundsIfLCD(GlyphMetrics* mx);
-    // Caller must lock f_t_mutex() before calling this function.
+    // Caller must lock fFaceRec->fFaceMutex before calling this function.
     // update FreeType2 glyph slot with glyph emboldened
     bool emboldenIfNeeded(FT_Face face, FT_GlyphSlot glyph, SkGlyphID gid);
     bool shouldSubpixelBitmap(const SkGlyph&, const SkMatrix&);
@@ -936,7 +946,6 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(const SkTypeface_FreeType& re
     , fFTSize(nullptr)
     , fStrikeIndex(-1)
 {
-    SkAutoMutexExclusive  ac(f_t_mutex());
     fFaceRec = realTypeface.getFaceRec();  // The proxyTypeface owns the realTypeface.
 
     // load the font file
@@ -944,6 +953,7 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(const SkTypeface_FreeType& re
         LOG_INFO("Could not create FT_Face.\n");
         return;
     }
+    SkAutoMutexExclusive  ac(fFaceRec->fFaceMutex);
 
     fLCDIsVert = SkToBool(fRec.fFlags & SkScalerContext::kLCD_Vertical_Flag);
 
@@ -1114,9 +1124,8 @@ SkScalerContext_FreeType::SkScalerContext_FreeType(const SkTypeface_FreeType& re
 }
 
 SkScalerContext_FreeType::~SkScalerContext_FreeType() {
-    SkAutoMutexExclusive  ac(f_t_mutex());
-
     if (fFTSize != nullptr) {
+        SkAutoMutexExclusive  ac(fFaceRec->fFaceMutex);
         FT_Done_Size(fFTSize);
     }
 
@@ -1127,7 +1136,7 @@ SkScalerContext_FreeType::~SkScalerContext_FreeType() {
     this face with other context (at different sizes).
 */
 FT_Error SkScalerContext_FreeType::setupSize() {
-    f_t_mutex().assertHeld();
+    fFaceRec->fFaceMutex.assertHeld();
     FT_Error err = FT_Activate_Size(fFTSize);
     if (err != 0) {
         return err;
@@ -1217,7 +1226,7 @@ bool SkScalerContext_FreeType::shouldSubpixelBitmap(const SkGlyph& glyph, const
 
 SkScalerContext::GlyphMetrics SkScalerContext_FreeType::generateMetrics(const SkGlyph& glyph,
                                                                         SkArenaAlloc* alloc) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fFaceMutex);
 
     GlyphMetrics mx(glyph.maskFormat());
 
@@ -1396,7 +1405,7 @@ SkScalerContext::GlyphMetrics SkScalerContext_FreeType::generateMetrics(const Sk
 }
 
 void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph, void* imageBuffer) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fFaceMutex);
 
     if (this->setupSize()) {
         sk_bzero(imageBuffer, glyph.imageSize());
@@ -1465,11 +1474,11 @@ void SkScalerContext_FreeType::generateImage(const SkGlyph& glyph, void* imageBu
 sk_sp<SkDrawable> SkScalerContext_FreeType::generateDrawable(const SkGlyph& glyph) {
     // Because FreeType's FT_Face is stateful (not thread safe) and the current design of this
     // SkTypeface and SkScalerContext does not work around this, it is necessary lock at least the
-    // FT_Face when using it (this implementation currently locks the whole FT_Library).
+    // FT_Face when using it.
     // It should be possible to draw the drawable straight out of the FT_Face. However, this would
     // mean locking each time any such drawable is drawn. To avoid locking, this implementation
     // creates drawables backed as pictures so that they can be played back later without locking.
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fFaceMutex);
 
     if (this->setupSize()) {
         return nullptr;
@@ -1519,7 +1528,7 @@ sk_sp<SkDrawable> SkScalerContext_FreeType::generateDrawable(const SkGlyph& glyp
 
 std::optional<SkScalerContext::GeneratedPath>
 SkScalerContext_FreeType::generatePath(const SkGlyph& glyph) {
-    SkAutoMutexExclusive  ac(f_t_mutex());
+    SkAutoMutexExclusive  ac(fFaceRec->fFaceMutex);
 
     SkGlyphID glyphID = glyph.getGlyphID();
     // FT_IS_SCALABLE is documented to mean the face contains outline glyphs.
@@ -1561,7 +1570,7 @@ void SkScalerContext_FreeType::generateFontMetrics(SkFontMetrics* metrics) {
         return;
     }
 
-    SkAutoMutexExclusive ac(f_t_mutex());
+    SkAutoMutexExclusive ac(fFaceRec->fFaceMutex);
 
     if (this->setupSize()) {
         sk_bzero(metrics, sizeof(*metrics));
@@ -1977,8 +1986,10 @@ sk_sp<SkData> SkTypeface_FreeType::onCopyTableData(SkFontTableTag tag) const {
 }
 
 SkTypeface_FreeType::FaceRec* SkTypeface_FreeType::getFaceRec() const {
-    f_t_mutex().assertHeld();
-    fFTFaceOnce([this]{ fFaceRec = SkTypeface_FreeType::FaceRec::Make(this); });
+    fFTFaceOnce([this]{
+        SkAutoMutexExclusive ac(f_t_mutex());
+        fFaceRec = SkTypeface_FreeType::FaceRec::Make(this);
+    });
     return fFaceRec.get();
 }
 
@@ -8,9 +8,12 @@
 #include "include/codec/SkAndroidCodec.h"
 #include "include/codec/SkCodec.h"
 #include "include/codec/SkEncodedImageFormat.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkString.h"
@@ -272,3 +275,73 @@ DEF_TEST(AndroidCodec_PQ, r) {
     static constexpr skcms_Matrix3x3 kExpected = SkNamedGamut::kRec2020;
     REPORTER_ASSERT(r, 0 == memcmp(&matrix, &kExpected, sizeof(skcms_Matrix3x3)));
 }
+
+// Progressive JPEGs decode incrementally when previews are requested. Sampled and subset decodes
+// must still write only the rows dst has, and match the same decode without previews.
+DEF_TEST(AndroidCodec_progressiveJpeg, r) {
+    if (GetResourcePath().isEmpty()) {
+        return;
+    }
+
+    const char* path = "images/brickwork-texture.jpg";
+    sk_sp<SkData> data = GetResourceAsData(path);
+    if (!data) {
+        ERRORF(r, "Missing file %s", path);
+        return;
+    }
+
+    constexpr SkColor kGuard = SK_ColorMAGENTA;
+    for (int sampleSize : {1, 2, 3, 5}) {
+        for (bool useSubset : {false, true}) {
+            SkBitmap decodes[2];
+            for (bool previews : {false, true}) {
+                auto codec = SkAndroidCodec::MakeFromCodec(SkCodec::MakeFromData(data));
+                if (!codec) {
+                    ERRORF(r, "Failed to create codec from %s", path);
+                    return;
+                }
+
+                SkAndroidCodec::AndroidOptions options;
+                options.fSampleSize = sampleSize;
+                options.fProgressivePreviews = previews;
+                SkIRect subset = SkIRect::MakeLTRB(64, 96, 320, 200);
+                SkISize dims = codec->getSampledDimensions(sampleSize);
+                if (useSubset) {
+                    REPORTER_ASSERT(r, codec->getSupportedSubset(&subset));
+                    options.fSubset = &subset;
+                    dims = codec->getSampledSubsetDimensions(sampleSize, subset);
+                }
+
+                // One extra row below dst catches decodes that write too many rows.
+                const SkImageInfo info = codec->getInfo().makeDimensions(dims)
+                                                         .makeColorType(kN32_SkColorType)
+                                                         .makeAlphaType(kPremul_SkAlphaType);
+                SkBitmap& bm = decodes[previews];
+                bm.allocPixels(info.makeWH(dims.width(), dims.height() + 1));
+                bm.eraseColor(kGuard);
+                const SkCodec::Result result =
+                        codec->getAndroidPixels(info, bm.getPixels(), bm.rowBytes(), &options);
+                REPORTER_ASSERT(r, result == SkCodec::kSuccess,
+                                "sampleSize %d subset %d previews %d: %s", sampleSize, useSubset,
+                                previews, SkCodec::ResultToString(result));
+                for (int x = 0; x < dims.width(); x++) {
+                    if (bm.getColor(x, dims.height()) != kGuard) {
+                        ERRORF(r, "sampleSize %d subset %d previews %d wrote past dst",
+                               sampleSize, useSubset, previews);
+                        break;
+                    }
+                }
+            }
+
+            const SkBitmap& a = decodes[0];
+            const SkBitmap& b = decodes[1];
+            for (int y = 0; y < a.height(); y++) {
+                if (0 != memcmp(a.getAddr(0, y), b.getAddr(0, y), a.info().minRowBytes())) {
+                    ERRORF(r, "sampleSize %d subset %d: previews changed row %d", sampleSize,
+                           useSubset, y);
+                    break;
+                }
+            }
+        }
+    }
+}
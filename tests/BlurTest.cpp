@@ -11,6 +11,7 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkPaint.h"
@@ -24,17 +25,21 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkSize.h"
 #include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/core/SkTileMode.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkImageFilters.h"
 #include "include/effects/SkPerlinNoiseShader.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/private/SkTPin.h"
+#include "src/core/SkBlurEngine.h"
 #include "src/core/SkBlurMask.h"
 #include "src/core/SkColorPriv.h"
 #include "src/core/SkFloatBits.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkMaskFilterBase.h"
 #include "src/core/SkMathPriv.h"
+#include "src/core/SkSpecialImage.h"
 #include "src/effects/SkEmbossMaskFilter.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
@@ -705,3 +710,46 @@ DEF_TEST(blur_b508075339, reporter) {
     // completes without triggering an SkASSERT in SkBitmap::getAddr.
     canvas->drawRect(SkRect::MakeWH(kCanvasSize, kCanvasSize), paint);
 }
+
+// Splitting the raster blur passes across an executor must produce exactly the same pixels as
+// running them serially, for both the Gaussian and box-approximation passes and for 1D blurs.
+DEF_TEST(RasterBlurEngine_Threaded, reporter) {
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    auto serialEngine = SkBlurEngine::MakeRasterBlurEngine(nullptr);
+    auto threadedEngine = SkBlurEngine::MakeRasterBlurEngine(executor.get());
+
+    for (SkColorType colorType : {kAlpha_8_SkColorType, kN32_SkColorType}) {
+        SkBitmap bitmap;
+        bitmap.allocPixels(SkImageInfo::Make(600, 500, colorType, kPremul_SkAlphaType));
+        SkCanvas canvas(bitmap);
+        canvas.clear(SK_ColorTRANSPARENT);
+        SkPaint paint;
+        for (int i = 0; i < 20; ++i) {
+            paint.setColor(SkColorSetARGB(255 - 10 * i, 13 * i, 255 - 7 * i, 9 * i));
+            canvas.drawCircle(31.f * i, 23.f * i, 10.f + 3 * i, paint);
+        }
+        sk_sp<SkSpecialImage> src = SkSpecialImages::MakeFromRaster(
+                SkIRect::MakeSize(bitmap.dimensions()), bitmap, SkSurfaceProps{});
+
+        const SkIRect srcRect = SkIRect::MakeLTRB(10, 20, 590, 480);
+        const SkIRect dstRect = SkIRect::MakeLTRB(-30, -10, 620, 530);
+        for (SkSize sigma : {SkSize{1.5f, 1.5f}, SkSize{8.f, 8.f}, SkSize{20.f, 0.f},
+                             SkSize{0.f, 20.f}, SkSize{3.f, 40.f}}) {
+            const SkBlurEngine::Algorithm* serial =
+                    serialEngine->findAlgorithm(sigma, colorType);
+            const SkBlurEngine::Algorithm* threaded =
+                    threadedEngine->findAlgorithm(sigma, colorType);
+
+            SkBitmap expected, actual;
+            REPORTER_ASSERT(reporter, SkSpecialImages::AsBitmap(
+                    serial->blur(sigma, src, srcRect, SkTileMode::kDecal, dstRect).get(),
+                    &expected));
+            REPORTER_ASSERT(reporter, SkSpecialImages::AsBitmap(
+                    threaded->blur(sigma, src, srcRect, SkTileMode::kDecal, dstRect).get(),
+                    &actual));
+            REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(expected, actual),
+                            "colorType %d sigma (%g, %g)", colorType,
+                            sigma.width(), sigma.height());
+        }
+    }
+}
@@ -12,16 +12,23 @@
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMaskFilter.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPathBuilder.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkSurface.h"
+#include "include/effects/SkImageFilters.h"
 #include "src/core/SkCPUContextImpl.h"
+#include "src/core/SkRandom.h"
 #include "src/core/SkResourceCache.h"
 
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
 
+#include <atomic>
+#include <functional>
 #include <memory>
 
 DEF_TEST(CPUSurface_UsesCPUContextAndRecorderToDraw_DrawsPixels, reporter) {
@@ -93,3 +100,122 @@ DEF_TEST(ImageMakeScaled_UsesCPURecorderToMakeImage_Success, reporter) {
     REPORTER_ASSERT(reporter, legacyAPI->width() == 70);
     REPORTER_ASSERT(reporter, !legacyAPI->isTextureBacked());
 }
+
+DEF_TEST(CPUContext_ExecutorFillsLargePathsInBands, reporter) {
+    // Self-intersecting polygons with enough points to be split into bands, whose anti-aliased
+    // edges cross every band boundary, filled with each rule.
+    SkRandom rand;
+    SkPath paths[2];
+    const SkPathFillType fillTypes[] = {SkPathFillType::kEvenOdd, SkPathFillType::kWinding};
+    for (int p = 0; p < 2; ++p) {
+        SkPathBuilder builder(fillTypes[p]);
+        builder.moveTo(128, 128);
+        for (int i = 0; i < 5000; ++i) {
+            builder.lineTo(rand.nextRangeF(-10, 266), rand.nextRangeF(-10, 266));
+        }
+        paths[p] = builder.detach();
+    }
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    paint.setColor(0x80336699);
+    const SkImageInfo imageInfo = SkImageInfo::MakeN32Premul(256, 256);
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    skcpu::Context::Options opts;
+    opts.fExecutor = executor.get();
+    auto ctx = skcpu::Context::Make(opts);
+    std::unique_ptr<skcpu::Recorder> recorder = ctx->makeRecorder();
+
+    // With and without a clip that cuts through the path and the bands.
+    const SkRect clips[] = {SkRect::MakeWH(256, 256), SkRect::MakeLTRB(7, 30, 250, 201)};
+    for (const SkPath& path : paths) {
+        for (const SkRect& clip : clips) {
+            auto banded = recorder->makeBitmapSurface(imageInfo);
+            banded->getCanvas()->clear(SK_ColorWHITE);
+            banded->getCanvas()->clipRect(clip);
+            banded->getCanvas()->drawPath(path, paint);
+
+            // The same fill, scan converted once on the calling thread, must produce exactly the
+            // same pixels.
+            auto expected = skcpu::Recorder::TODO()->makeBitmapSurface(imageInfo);
+            expected->getCanvas()->clear(SK_ColorWHITE);
+            expected->getCanvas()->clipRect(clip);
+            expected->getCanvas()->drawPath(path, paint);
+
+            SkPixmap bandedPixels, expectedPixels;
+            REPORTER_ASSERT(reporter, banded->peekPixels(&bandedPixels));
+            REPORTER_ASSERT(reporter, expected->peekPixels(&expectedPixels));
+            REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(bandedPixels, expectedPixels));
+        }
+    }
+}
+
+namespace {
+// Runs work inline on the calling thread, counting the tasks it is given.
+class CountingExecutor final : public SkExecutor {
+public:
+    void add(std::function<void(void)> work) override {
+        fTaskCount++;
+        work();
+    }
+
+    int taskCount() const { return fTaskCount.load(); }
+
+private:
+    std::atomic<int> fTaskCount{0};
+};
+}  // namespace
+
+DEF_TEST(CPUContext_ExecutorBlursImageFilters, reporter) {
+    CountingExecutor executor;
+    skcpu::Context::Options opts;
+    opts.fExecutor = &executor;
+    auto ctx = skcpu::Context::Make(opts);
+    std::unique_ptr<skcpu::Recorder> recorder = ctx->makeRecorder();
+
+    const SkImageInfo imageInfo = SkImageInfo::MakeN32Premul(512, 400);
+    auto draw = [](SkCanvas* canvas) {
+        canvas->clear(SK_ColorWHITE);
+        SkPaint paint;
+        for (int i = 0; i < 20; ++i) {
+            paint.setColor(SkColorSetARGB(255 - 10 * i, 13 * i, 255 - 7 * i, 9 * i));
+            canvas->drawCircle(27.f * i, 19.f * i, 10.f + 3 * i, paint);
+        }
+    };
+    // Large enough for the box-approximation and Gaussian passes to be split into spans, both
+    // drawn directly and through a nested layer. Each draw gets its own filter so that the image
+    // filter cache cannot hand the serial result to the threaded draw.
+    for (float sigma : {3.f, 12.f}) {
+        for (bool nested : {false, true}) {
+            auto blur = [&](SkCanvas* canvas) {
+                if (nested) {
+                    canvas->saveLayer(nullptr, nullptr);
+                }
+                SkPaint layerPaint;
+                layerPaint.setImageFilter(SkImageFilters::Blur(sigma, sigma, nullptr));
+                canvas->saveLayer(nullptr, &layerPaint);
+                draw(canvas);
+                canvas->restore();
+                if (nested) {
+                    canvas->restore();
+                }
+            };
+
+            const int tasksBefore = executor.taskCount();
+            auto threaded = recorder->makeBitmapSurface(imageInfo);
+            blur(threaded->getCanvas());
+            REPORTER_ASSERT(reporter, executor.taskCount() > tasksBefore,
+                            "sigma %g nested %d", sigma, nested);
+
+            auto expected = skcpu::Recorder::TODO()->makeBitmapSurface(imageInfo);
+            blur(expected->getCanvas());
+
+            SkPixmap threadedPixels, expectedPixels;
+            REPORTER_ASSERT(reporter, threaded->peekPixels(&threadedPixels));
+            REPORTER_ASSERT(reporter, expected->peekPixels(&expectedPixels));
+            REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(threadedPixels, expectedPixels),
+                            "sigma %g nested %d", sigma, nested);
+        }
+    }
+}
@@ -21,6 +21,8 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTypes.h"
+#include "src/codec/SkCodecFrameCache.h"
+#include "src/core/SkResourceCache.h"
 #include "tests/CodecPriv.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
@@ -599,6 +601,62 @@ DEF_TEST(EncodedOriginToMatrixTest, r) {
     }
 }
 
+// Seeking through an SkCodecFrameCache in any order must match a from-scratch decode.
+DEF_TEST(Codec_frameCache, r) {
+    for (const char* file : { "images/required.gif",
+                              "images/alphabetAnim.gif",
+                              "images/colorTables.gif",
+                              "images/randPixelsAnim.gif",
+                              "images/blendBG.webp",
+                              "images/required.webp",
+                              "images/stoplight.webp" }) {
+        auto codec = SkCodec::MakeFromData(GetResourceAsData(file));
+        if (!codec) {
+            ERRORF(r, "Could not create codec from %s", file);
+            continue;
+        }
+        const int frameCount = codec->getFrameCount();
+        const SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType)
+                                                 .makeAlphaType(kPremul_SkAlphaType);
+
+        std::vector<int> seeks;
+        for (int i = frameCount - 1; i >= 0; --i) {
+            seeks.push_back(i);
+        }
+        for (int i = 0; i < frameCount; i += 2) {
+            seeks.push_back(i);
+        }
+        seeks.push_back(frameCount - 1);
+
+        SkResourceCache localCache(64 * 1024 * 1024);
+        {
+            SkCodecFrameCache frameCache(codec.get(), /*keyframeInterval=*/2, &localCache);
+            for (int index : seeks) {
+                SkBitmap expected;
+                expected.allocPixels(info);
+                SkCodec::Options options;
+                options.fFrameIndex = index;
+                REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                                codec->getPixels(info, expected.getPixels(), expected.rowBytes(),
+                                                 &options));
+
+                SkBitmap actual;
+                actual.allocPixels(info);
+                // Start from garbage, since the cache must not depend on the destination.
+                actual.eraseColor(SK_ColorMAGENTA);
+                REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                                frameCache.getFrame(info, actual.getPixels(), actual.rowBytes(),
+                                                    index));
+                REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual),
+                                "%s frame %i differs from a direct decode", file, index);
+            }
+            REPORTER_ASSERT(r, localCache.getTotalBytesUsed() > 0);
+        }
+        // Destroying the frame cache drops its snapshots.
+        REPORTER_ASSERT(r, localCache.getTotalBytesUsed() == 0);
+    }
+}
+
 #if defined(SK_ENABLE_SKOTTIE)
 
 #include "modules/skresources/src/SkAnimCodecPlayer.h"
@@ -6,6 +6,7 @@
  */
 
 #include "include/codec/SkCodec.h"
+#include "include/codec/SkEncodedImageFormat.h"
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImageInfo.h"
@@ -156,6 +157,77 @@ DEF_TEST(Codec_partial, r) {
     test_partial(r, "images/color_wheel.gif");
 }
 
+// Decodes name as its data arrives. With previews requested, a preview covering the whole image
+// must show up before the decode finishes. Either way the result must match a full decode.
+static void test_progressive_previews(skiatest::Reporter* r, const char* name, size_t minBytes) {
+    sk_sp<SkData> file = GetResourceAsData(name);
+    if (!file) {
+        SkDebugf("missing resource %s\n", name);
+        return;
+    }
+    SkBitmap truth;
+    if (!create_truth(file, &truth)) {
+        ERRORF(r, "Failed to decode %s\n", name);
+        return;
+    }
+
+    constexpr size_t kIncrement = 1000;
+    for (bool previews : {false, true}) {
+        HaltingStream* stream = new HaltingStream(file, minBytes);
+        auto codec = SkCodec::MakeFromStream(std::unique_ptr<SkStream>(stream));
+        if (!codec) {
+            ERRORF(r, "Failed to create codec for %s with %zu bytes", name, minBytes);
+            return;
+        }
+
+        const SkImageInfo info = standardize_info(codec.get());
+        SkBitmap incremental;
+        incremental.allocPixels(info);
+        SkCodec::Options options;
+        options.fProgressivePreviews = previews;
+        const SkCodec::Result startResult = codec->startIncrementalDecode(
+                info, incremental.getPixels(), incremental.rowBytes(), &options);
+        if (!previews && codec->getEncodedFormat() == SkEncodedImageFormat::kJPEG) {
+            // Progressive JPEGs only decode incrementally when asked for previews.
+            REPORTER_ASSERT(r, startResult == SkCodec::kUnimplemented, "%s", name);
+            continue;
+        }
+        if (startResult != SkCodec::kSuccess) {
+            ERRORF(r, "Failed to start incremental decode of %s", name);
+            return;
+        }
+
+        int previewCount = 0;
+        while (true) {
+            int rowsDecoded = 0;
+            const SkCodec::Result result = codec->incrementalDecode(&rowsDecoded);
+            if (result == SkCodec::kSuccess) {
+                break;
+            }
+            REPORTER_ASSERT(r, result == SkCodec::kIncompleteInput);
+            if (rowsDecoded == info.height()) {
+                previewCount++;
+            }
+            if (stream->isAllDataReceived()) {
+                ERRORF(r, "Failed to completely decode %s", name);
+                return;
+            }
+            stream->addNewData(kIncrement);
+        }
+
+        if (previews) {
+            REPORTER_ASSERT(r, previewCount > 0, "%s", name);
+        }
+        compare_bitmaps(r, truth, incremental);
+    }
+}
+
+DEF_TEST(Codec_partialProgressivePreviews, r) {
+    test_progressive_previews(r, "images/brickwork-texture.jpg", 1000);
+    test_progressive_previews(r, "images/flutter_logo.jpg", 1000);
+    test_progressive_previews(r, "images/plane_interlaced.png", 200);
+}
+
 DEF_TEST(Codec_partialWuffs, r) {
     const char* path = "images/alphabetAnim.gif";
     auto file = GetResourceAsData(path);
@@ -7,6 +7,7 @@
 
 #include "include/codec/SkAndroidCodec.h"
 #include "include/codec/SkCodec.h"
+#include "include/codec/SkCodecDownscale.h"
 #include "include/codec/SkEncodedImageFormat.h"
 #include "include/codec/SkGifDecoder.h"
 #include "include/codec/SkJpegDecoder.h"
@@ -20,6 +21,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageGenerator.h"
 #include "include/core/SkImageInfo.h"
@@ -41,6 +43,8 @@
 #include "include/private/SkTemplates.h"
 #include "modules/skcms/skcms.h"
 #include "src/codec/SkCodecImageGenerator.h"
+#include "src/codec/SkPngCodec.h"
+#include "src/codec/SkPngRowIndex.h"
 #include "src/core/SkAutoMalloc.h"
 #include "src/core/SkAutoPixmapStorage.h"
 #include "src/core/SkColorSpacePriv.h"
@@ -725,6 +729,132 @@ DEF_TEST(Codec_png_plte_trns_gama, r) {
     t(r, "plte_trns_gama.png", kBGRA_8888_SkColorType, kPremul_SkAlphaType, {57, 49, 40, 64});
 }
 
+// Row subsets of a tall PNG may be decoded by resuming from checkpoints in a row index, rather
+// than by inflating every row above them. Either way they must match a full decode.
+DEF_TEST(Codec_png_rowSubsets, r) {
+    constexpr int kWidth = 256;
+    constexpr int kHeight = 8192;
+    for (SkAlphaType alphaType : {kOpaque_SkAlphaType, kUnpremul_SkAlphaType}) {
+        SkBitmap src;
+        src.allocPixels(SkImageInfo::Make(kWidth, kHeight, kRGBA_8888_SkColorType, alphaType));
+        SkRandom rand;
+        for (int y = 0; y < kHeight; ++y) {
+            for (int x = 0; x < kWidth; ++x) {
+                const uint8_t a = alphaType == kOpaque_SkAlphaType ? 0xFF : (x + y) & 0xFF;
+                const uint8_t noisyX = (x + rand.nextULessThan(8)) & 0xFF;
+                *src.getAddr32(x, y) = SkColorSetARGB(a, noisyX, y / 32, (x ^ y) & 0xFF);
+            }
+        }
+        sk_sp<SkData> data = SkPngEncoder::Encode(src.pixmap(), {});
+        REPORTER_ASSERT(r, data);
+
+        std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+        if (!codec) {
+            ERRORF(r, "Could not create codec.");
+            return;
+        }
+        const SkImageInfo info = codec->getInfo().makeColorType(kN32_SkColorType)
+                                                 .makeAlphaType(kUnpremul_SkAlphaType);
+        SkBitmap full;
+        full.allocPixels(info);
+        REPORTER_ASSERT(r, SkCodec::kSuccess ==
+                           codec->getPixels(info, full.getPixels(), full.rowBytes()));
+
+        // Both kinds of image are encoded with rows libpng needs no transforms for, so the codec
+        // can decode their subsets from a row index.
+        const SkPngRowIndex* rowIndex =
+                static_cast<const SkPngCodec*>(codec.get())->rowIndexForTesting();
+        if (!rowIndex) {
+            ERRORF(r, "No row index for %s rows.",
+                   alphaType == kOpaque_SkAlphaType ? "opaque" : "unpremul");
+            return;
+        }
+
+        // Decode out of order, so that later subsets can start from checkpoints recorded by
+        // earlier ones.
+        bool first = true;
+        for (int top : {6000, 100, kHeight - 1, 3000, 0, 7000, 4096}) {
+            const SkIRect subset = SkIRect::MakeLTRB(0, top, kWidth, std::min(top + 300, kHeight));
+            SkBitmap dst;
+            dst.allocPixels(info.makeWH(kWidth, subset.height()));
+            SkCodec::Options options;
+            options.fSubset = &subset;
+            if (SkCodec::kSuccess != codec->startIncrementalDecode(info, dst.getPixels(),
+                                                                   dst.rowBytes(), &options)) {
+                ERRORF(r, "Could not start decoding rows %d to %d.", top, subset.bottom());
+                continue;
+            }
+            REPORTER_ASSERT(r, SkCodec::kSuccess == codec->incrementalDecode());
+            for (int y = 0; y < subset.height(); ++y) {
+                REPORTER_ASSERT(r, !memcmp(dst.getAddr(0, y), full.getAddr(0, top + y),
+                                           info.minRowBytes()),
+                                "row %d differs", top + y);
+            }
+
+            // Checkpoints are a couple thousand rows apart here, and the first decode records
+            // them down to row 6300. Every later decode far enough down must resume from one
+            // rather than inflate from the top.
+            if (top > 0) {
+                REPORTER_ASSERT(r, rowIndex->lastStartRow() <= top);
+            }
+            if (!first && top >= 4096) {
+                REPORTER_ASSERT(r, rowIndex->lastStartRow() > 0,
+                                "rows %d to %d were inflated from the top", top, subset.bottom());
+            }
+            first = false;
+        }
+        REPORTER_ASSERT(r, rowIndex->checkpointCount() > 0);
+
+        // Rows past the end of truncated data are reported as incomplete.
+        codec = SkCodec::MakeFromData(SkData::MakeSubset(data.get(), 0, data->size() / 2));
+        if (!codec) {
+            ERRORF(r, "Could not create codec for truncated data.");
+            return;
+        }
+        const SkIRect subset = SkIRect::MakeLTRB(0, kHeight - 10, kWidth, kHeight);
+        SkBitmap dst;
+        dst.allocPixels(info.makeWH(kWidth, subset.height()));
+        SkCodec::Options options;
+        options.fSubset = &subset;
+        REPORTER_ASSERT(r, SkCodec::kSuccess == codec->startIncrementalDecode(
+                                                        info, dst.getPixels(), dst.rowBytes(),
+                                                        &options));
+        int rowsDecoded = -1;
+        REPORTER_ASSERT(r, SkCodec::kIncompleteInput == codec->incrementalDecode(&rowsDecoded));
+        REPORTER_ASSERT(r, rowsDecoded == 0);
+    }
+}
+
+// Streams in memory are decoded without copying them, so check that they decode the same as
+// streams that have to be read.
+DEF_TEST(Codec_memoryStreamMatchesReadStream, r) {
+    for (const char* path : {"images/mandrill_512.png", "images/plane_interlaced.png",
+                             "images/color_wheel.jpg", "images/brickwork-texture.jpg",
+                             "images/color_wheel.webp"}) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        std::unique_ptr<SkCodec> memoryCodec = SkCodec::MakeFromStream(
+                std::make_unique<SkMemoryStream>(data));
+        std::unique_ptr<SkCodec> readCodec = SkCodec::MakeFromStream(
+                std::make_unique<NotAssetMemStream>(data));
+        if (!memoryCodec || !readCodec) {
+            ERRORF(r, "Could not create codecs for %s.", path);
+            continue;
+        }
+        const SkImageInfo info = memoryCodec->getInfo().makeColorType(kN32_SkColorType);
+        SkBitmap expected, actual;
+        expected.allocPixels(info);
+        actual.allocPixels(info);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == readCodec->getPixels(expected.pixmap()), "%s",
+                        path);
+        REPORTER_ASSERT(r, SkCodec::kSuccess == memoryCodec->getPixels(actual.pixmap()), "%s",
+                        path);
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual), "%s", path);
+    }
+}
+
 // Disable RAW tests for Win32.
 #if defined(SK_CODEC_DECODES_RAW) && !defined(_WIN32)
 DEF_TEST(Codec_raw, r) {
@@ -2679,3 +2809,141 @@ DEF_TEST(Codec_Bmp_b511820841, r) {
         codec->getPixels(info, &unusedPixels, info.minRowBytes(), &opts) != SkCodec::kSuccess);
 }
 
+
+// JPEGs whose restart intervals are whole MCU rows may be decoded strip by strip on an executor.
+// That must produce exactly the pixels of the serial decode, including chroma upsampling and
+// color conversion across strip boundaries.
+DEF_TEST(Codec_jpeg_restartIntervalsDecodeInParallel, r) {
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (const char* path : {"images/icc-v2-gbr.jpg",        // 4:2:0, ICC profile
+                             "images/mandrill_cmyk.jpg",     // CMYK
+                             "images/crbug1465627.jpeg"}) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        for (SkColorType colorType : {kN32_SkColorType, kRGBA_F16_SkColorType}) {
+            SkBitmap serial, parallel;
+            for (SkBitmap* bitmap : {&serial, &parallel}) {
+                std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+                REPORTER_ASSERT(r, codec);
+                if (!codec) {
+                    return;
+                }
+                SkImageInfo info = codec->getInfo().makeColorType(colorType)
+                                                   .makeColorSpace(SkColorSpace::MakeSRGB());
+                bitmap->allocPixels(info);
+                SkCodec::Options options;
+                options.fExecutor = bitmap == &parallel ? executor.get() : nullptr;
+                REPORTER_ASSERT(r, codec->getPixels(bitmap->pixmap(), &options) ==
+                                   SkCodec::kSuccess, "%s", path);
+            }
+            REPORTER_ASSERT(r, ToolUtils::equal_pixels(serial, parallel), "%s", path);
+        }
+    }
+}
+
+// libwebp's worker thread only filters rows, so the decode must not change.
+DEF_TEST(Codec_webp_decoderThreads, r) {
+    for (const char* path : {"images/webp-color-profile-lossy.webp", "images/yellow_rose.webp"}) {
+        sk_sp<SkData> data = GetResourceAsData(path);
+        if (!data) {
+            continue;
+        }
+        SkBitmap serial, threaded;
+        for (SkBitmap* bitmap : {&serial, &threaded}) {
+            std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(data);
+            REPORTER_ASSERT(r, codec);
+            if (!codec) {
+                return;
+            }
+            bitmap->allocPixels(codec->getInfo());
+            SkCodec::Options options;
+            options.fUseDecoderThreads = bitmap == &threaded;
+            REPORTER_ASSERT(r, codec->getPixels(bitmap->pixmap(), &options) == SkCodec::kSuccess,
+                            "%s", path);
+        }
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(serial, threaded), "%s", path);
+    }
+}
+
+// DecodeAndDownscale() streams scanlines through its filter, or decodes at a native scale.
+DEF_TEST(Codec_decodeAndDownscale, r) {
+    sk_sp<SkData> png = GetResourceAsData("images/mandrill_256.png");
+    sk_sp<SkData> jpeg = GetResourceAsData("images/mandrill_512_q075.jpg");
+    if (!png || !jpeg) {
+        return;
+    }
+    const SkImageInfo dstInfo = SkImageInfo::MakeN32Premul(64, 64, SkColorSpace::MakeSRGB());
+
+    // PNGs have no native scaling, so a box filter must average each 4x4 block of a full decode.
+    SkBitmap full, box;
+    std::unique_ptr<SkCodec> codec = SkCodec::MakeFromData(png);
+    full.allocPixels(codec->getInfo().makeColorType(kN32_SkColorType)
+                                     .makeColorSpace(SkColorSpace::MakeSRGB()));
+    REPORTER_ASSERT(r, codec->getPixels(full.pixmap()) == SkCodec::kSuccess);
+    box.allocPixels(dstInfo);
+    codec = SkCodec::MakeFromData(png);
+    REPORTER_ASSERT(r, SkCodecs::DecodeAndDownscale(codec.get(), box.pixmap()) ==
+                       SkCodec::kSuccess);
+    for (int y = 0; y < 64; y++) {
+        for (int x = 0; x < 64; x++) {
+            int sum[4] = {0, 0, 0, 0};
+            for (int dy = 0; dy < 4; dy++) {
+                for (int dx = 0; dx < 4; dx++) {
+                    const uint32_t px = *full.getAddr32(4 * x + dx, 4 * y + dy);
+                    for (int c = 0; c < 4; c++) {
+                        sum[c] += (px >> (8 * c)) & 0xFF;
+                    }
+                }
+            }
+            const uint32_t actual = *box.getAddr32(x, y);
+            for (int c = 0; c < 4; c++) {
+                const int expected = (sum[c] + 8) / 16;
+                REPORTER_ASSERT(r, std::abs((int)((actual >> (8 * c)) & 0xFF) - expected) <= 1,
+                                "(%d, %d)", x, y);
+            }
+        }
+    }
+
+    // 1/8 is a native JPEG scale, so there is nothing left to filter.
+    SkBitmap scaled, downscaled;
+    codec = SkCodec::MakeFromData(jpeg);
+    REPORTER_ASSERT(r, codec->getScaledDimensions(0.125f) == dstInfo.dimensions());
+    scaled.allocPixels(dstInfo);
+    REPORTER_ASSERT(r, codec->getPixels(scaled.pixmap()) == SkCodec::kSuccess);
+    downscaled.allocPixels(dstInfo);
+    codec = SkCodec::MakeFromData(jpeg);
+    REPORTER_ASSERT(r, SkCodecs::DecodeAndDownscale(codec.get(), downscaled.pixmap()) ==
+                       SkCodec::kSuccess);
+    REPORTER_ASSERT(r, ToolUtils::equal_pixels(scaled, downscaled));
+
+    SkBitmap tooLarge;
+    tooLarge.allocPixels(dstInfo.makeWH(257, 64));
+    codec = SkCodec::MakeFromData(png);
+    REPORTER_ASSERT(r, SkCodecs::DecodeAndDownscale(codec.get(), tooLarge.pixmap()) ==
+                       SkCodec::kInvalidScale);
+
+    // A batch produces the same pixels whether or not it runs on an executor.
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkBitmap serial[3], parallel[3];
+    SkCodecs::DownscaleTask serialTasks[3], parallelTasks[3];
+    const sk_sp<SkData> inputs[3] = {png, jpeg, SkData::MakeWithCString("not an image")};
+    for (int i = 0; i < 3; i++) {
+        serial[i].allocPixels(dstInfo.makeWH(48, 40));
+        parallel[i].allocPixels(dstInfo.makeWH(48, 40));
+        serialTasks[i] = {inputs[i], serial[i].pixmap()};
+        parallelTasks[i] = {inputs[i], parallel[i].pixmap()};
+    }
+    SkCodecs::DecodeAndDownscale(serialTasks, SkCodecs::DownscaleFilter::kMitchell, nullptr);
+    SkCodecs::DecodeAndDownscale(parallelTasks, SkCodecs::DownscaleFilter::kMitchell,
+                                 executor.get());
+    for (int i = 0; i < 3; i++) {
+        const SkCodec::Result expected = i < 2 ? SkCodec::kSuccess : SkCodec::kInvalidInput;
+        REPORTER_ASSERT(r, serialTasks[i].fResult == expected);
+        REPORTER_ASSERT(r, parallelTasks[i].fResult == expected);
+        if (i < 2) {
+            REPORTER_ASSERT(r, ToolUtils::equal_pixels(serial[i], parallel[i]));
+        }
+    }
+}
@@ -12,10 +12,15 @@
 #include "include/core/SkPaint.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkSurface.h"
+#include "src/core/SkBlitRow.h"
 #include "src/core/SkBlitter.h"
+#include "src/core/SkColorPriv.h"
 #include "src/core/SkCoreBlitters.h"
+#include "src/core/SkCpu.h"
 #include "src/core/SkMask.h"
 
+#include <cstdint>
+#include <cstring>
 #include <memory>
 
 static bool all_pixels_same_color(uint32_t* buffer, size_t len) {
@@ -197,3 +202,54 @@ DEF_TEST(SkARGB32Blitter_MaskAndAntiHDrawTheSame, r) {
         }
     }
 }
+
+DEF_TEST(BlitRow_ML4, r) {
+#if defined(SK_CPU_X86) && !defined(SK_ENABLE_OPTIMIZE_SIZE)
+    // Only CPUs with AVX-512 use the 16 pixel blit loops.
+    if (!SkCpu::Supports(SkX64::ML4)) {
+        return;
+    }
+    // Several 16 pixel iterations, and every tail the 8 and 4 pixel loops leave behind.
+    constexpr int kMaxCount = 3 * 16 + 15;
+    SkPMColor src[kMaxCount + 1], dst[kMaxCount + 1];
+    for (int i = 0; i <= kMaxCount; i++) {
+        src[i] = SkPremultiplyARGBInline((i * 37) & 0xFF, (i * 11) & 0xFF, (i * 53) & 0xFF,
+                                         (i * 97) & 0xFF);
+        dst[i] = SkPremultiplyARGBInline((i * 71) & 0xFF, (i * 13) & 0xFF, (i * 29) & 0xFF,
+                                         (i * 5) & 0xFF);
+    }
+
+    for (int count = 0; count <= kMaxCount; count++) {
+        SkPMColor expected[kMaxCount + 1], actual[kMaxCount + 1];
+        memcpy(expected, dst, sizeof(dst));
+        memcpy(actual, dst, sizeof(dst));
+        for (int i = 1; i <= count; i++) {
+            expected[i] = SkPMSrcOver(src[i], expected[i]);
+        }
+        SkOpts::blit_row_s32a_opaque(actual + 1, src + 1, count, 0xFF);
+        REPORTER_ASSERT(r, 0 == memcmp(expected, actual, sizeof(actual)), "count %d", count);
+    }
+
+    // blit_row_color32 is only used for colors that are neither transparent nor opaque.
+    for (SkPMColor color : {SkPremultiplyARGBInline(1, 255, 128, 0),
+                            SkPremultiplyARGBInline(128, 10, 200, 90),
+                            SkPremultiplyARGBInline(254, 255, 255, 255)}) {
+        const unsigned invA = SkAlpha255To256(255 - SkGetPackedA32(color));
+        for (int count = 0; count <= kMaxCount; count++) {
+            SkPMColor expected[kMaxCount + 1], actual[kMaxCount + 1];
+            memcpy(expected, dst, sizeof(dst));
+            memcpy(actual, dst, sizeof(dst));
+            for (int i = 1; i <= count; i++) {
+                uint8_t* px = reinterpret_cast<uint8_t*>(expected + i);
+                const uint8_t* c = reinterpret_cast<const uint8_t*>(&color);
+                for (int k = 0; k < 4; k++) {
+                    px[k] = (uint8_t)(((px[k] * invA) >> 8) + c[k]);
+                }
+            }
+            SkOpts::blit_row_color32(actual + 1, count, color);
+            REPORTER_ASSERT(r, 0 == memcmp(expected, actual, sizeof(actual)),
+                            "color %08x count %d", color, count);
+        }
+    }
+#endif
+}
@@ -15,6 +15,7 @@
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkDataTable.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkPixmap.h"
@@ -505,6 +506,106 @@ DEF_TEST(Encode_PngOptions, r) {
     REPORTER_ASSERT(r, almost_equals(bm0, bm2, 0));
 }
 
+DEF_TEST(Encode_PngParallel, r) {
+    SkBitmap bitmap;
+    bool success = ToolUtils::GetResourceAsBitmap("images/mandrill_512.png", &bitmap);
+    if (!success) {
+        return;
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    // Cover both the 8 and 16 bit paths, with and without the filler channel stripped.
+    const SkColorType colorTypes[] = {kN32_SkColorType, kRGBA_F16_SkColorType};
+    const SkAlphaType alphaTypes[] = {kOpaque_SkAlphaType, kPremul_SkAlphaType};
+    const SkPngEncoder::FilterFlag filters[] = {SkPngEncoder::FilterFlag::kAll,
+                                                SkPngEncoder::FilterFlag::kPaeth,
+                                                SkPngEncoder::FilterFlag::kZero};
+    for (SkColorType ct : colorTypes) {
+        for (SkAlphaType at : alphaTypes) {
+            SkBitmap src;
+            src.allocPixels(bitmap.info().makeColorType(ct).makeAlphaType(at));
+            REPORTER_ASSERT(r, bitmap.readPixels(src.pixmap()));
+
+            for (SkPngEncoder::FilterFlag filter : filters) {
+                SkPngEncoder::Options options;
+                options.fFilterFlags = filter;
+                sk_sp<SkData> serial = SkPngEncoder::Encode(src.pixmap(), options);
+                options.fExecutor = executor.get();
+                sk_sp<SkData> parallel = SkPngEncoder::Encode(src.pixmap(), options);
+                REPORTER_ASSERT(r, serial && parallel);
+                if (!serial || !parallel) {
+                    return;
+                }
+
+                SkBitmap bm0, bm1;
+                REPORTER_ASSERT(r, SkImages::DeferredFromEncodedData(serial)->asLegacyBitmap(&bm0));
+                REPORTER_ASSERT(r,
+                                SkImages::DeferredFromEncodedData(parallel)->asLegacyBitmap(&bm1));
+                REPORTER_ASSERT(r, almost_equals(bm0, bm1, 0), "ct=%d at=%d filter=%d",
+                                static_cast<int>(ct), static_cast<int>(at),
+                                static_cast<int>(filter));
+            }
+        }
+    }
+}
+
+DEF_TEST(Encode_JpegParallel, r) {
+    SkBitmap mandrill;
+    bool success = ToolUtils::GetResourceAsBitmap("images/mandrill_512.png", &mandrill);
+    if (!success) {
+        return;
+    }
+
+    // Tall enough to be split into bands, with a width that is not a whole number of MCUs.
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(301, 1500, /*isOpaque=*/true);
+    for (int y = 0; y < bitmap.height(); ++y) {
+        for (int x = 0; x < bitmap.width(); ++x) {
+            *bitmap.getAddr32(x, y) = *mandrill.getAddr32(x % mandrill.width(),
+                                                          y % mandrill.height());
+        }
+    }
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    const SkColorType colorTypes[] = {kN32_SkColorType, kGray_8_SkColorType};
+    const SkJpegEncoder::Downsample downsamples[] = {SkJpegEncoder::Downsample::k420,
+                                                     SkJpegEncoder::Downsample::k422,
+                                                     SkJpegEncoder::Downsample::k444};
+    for (SkColorType ct : colorTypes) {
+        SkBitmap src;
+        src.allocPixels(bitmap.info().makeColorType(ct));
+        REPORTER_ASSERT(r, bitmap.readPixels(src.pixmap()));
+
+        for (SkJpegEncoder::Downsample downsample : downsamples) {
+            SkJpegEncoder::Options options;
+            options.fQuality = 80;
+            options.fDownsample = downsample;
+            options.fOrigin = kRightTop_SkEncodedOrigin;
+            sk_sp<SkData> serial = SkJpegEncoder::Encode(src.pixmap(), options);
+            options.fExecutor = executor.get();
+            sk_sp<SkData> parallel = SkJpegEncoder::Encode(src.pixmap(), options);
+            REPORTER_ASSERT(r, serial && parallel);
+            if (!serial || !parallel) {
+                return;
+            }
+
+            // Only the entropy coding differs, so the pixels and metadata must match.
+            std::unique_ptr<SkCodec> codec = SkJpegDecoder::Decode(parallel, nullptr);
+            REPORTER_ASSERT(r, codec && codec->dimensions() == src.dimensions());
+            REPORTER_ASSERT(r, codec && codec->getOrigin() == kRightTop_SkEncodedOrigin);
+
+            SkBitmap bm0, bm1;
+            REPORTER_ASSERT(r, SkImages::DeferredFromEncodedData(serial)->asLegacyBitmap(&bm0));
+            REPORTER_ASSERT(r,
+                            SkImages::DeferredFromEncodedData(parallel)->asLegacyBitmap(&bm1));
+            REPORTER_ASSERT(r, almost_equals(bm0, bm1, 0), "colorType %d downsample %d",
+                            static_cast<int>(ct), static_cast<int>(downsample));
+        }
+    }
+}
+
 DEF_TEST(Encode_WebpQuality, r) {
     SkBitmap bm;
     bm.allocN32Pixels(100, 100);
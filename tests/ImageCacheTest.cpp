@@ -5,10 +5,13 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkTypes.h"
 #include "include/private/chromium/SkDiscardableMemory.h"
 #include "src/core/SkResourceCache.h"
+#include "src/core/SkSynchronizedResourceCache.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/lazy/SkDiscardableMemoryPool.h"
 #include "tests/Test.h"
 
@@ -138,6 +141,53 @@ DEF_TEST(ImageCache, reporter) {
         SkResourceCache cache(defLimit);
         test_cache_purge_shared_id(reporter, cache);
     }
+    {
+        SkSynchronizedResourceCache cache(defLimit);
+        test_cache(reporter, cache, true);
+    }
+    {
+        SkSynchronizedResourceCache cache(SkDiscardableMemory::Create);
+        test_cache(reporter, cache, false);
+    }
+    {
+        SkSynchronizedResourceCache cache(defLimit);
+        test_cache_purge_shared_id(reporter, cache);
+    }
+}
+
+DEF_TEST(ImageCache_synchronizedBudget, reporter) {
+    constexpr int kThreads = 8;
+    constexpr int kRecsPerThread = 500;
+    const size_t recBytes = TestingRec(TestingKey(0), 0).bytesUsed();
+    const size_t limit = recBytes * kRecsPerThread;
+    SkSynchronizedResourceCache cache(limit);
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(kThreads);
+    SkTaskGroup tg(*executor);
+    tg.batch(kThreads, [&](int thread) {
+        for (int i = 0; i < kRecsPerThread; ++i) {
+            TestingKey key(thread * kRecsPerThread + i, thread + 1);
+            cache.add(new TestingRec(key, i));
+            intptr_t value = -1;
+            if (cache.find(key, TestingRec::Visitor, &value)) {
+                REPORTER_ASSERT(reporter, value == i);
+            }
+        }
+    });
+    tg.wait();
+
+    // Purges run after every add, so once the adds are done the cache is back within budget.
+    REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() <= limit);
+    REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() > 0);
+
+    cache.purgeSharedID(1);
+    for (int i = 0; i < kRecsPerThread; ++i) {
+        intptr_t value = -1;
+        REPORTER_ASSERT(reporter, !cache.find(TestingKey(i, 1), TestingRec::Visitor, &value));
+    }
+
+    cache.purgeAll();
+    REPORTER_ASSERT(reporter, cache.getTotalBytesUsed() == 0);
 }
 
 DEF_TEST(ImageCache_doubleAdd, r) {
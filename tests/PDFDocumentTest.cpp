@@ -22,10 +22,12 @@
 #include "include/core/SkString.h"
 #include "include/docs/SkPDFDocument.h"
 #include "include/docs/SkPDFJpegHelpers.h"
+#include "src/core/SkColorPriv.h"
 #include "src/utils/SkOSPath.h"
 #include "tests/Test.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
@@ -277,4 +279,79 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+static bool stream_contains(const SkDynamicMemoryWStream& stream, const char* needle) {
+    sk_sp<SkData> data = SkData::MakeUninitialized(stream.bytesWritten());
+    stream.copyTo(data->writable_data());
+    return contains(data->bytes(), data->size(), needle);
+}
+
+DEF_TEST(SkPDF_stream_pages, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_stream_pages, r);
+    SkPDF::Metadata metadata = SkPDF::JPEG::MetadataWithCallbacks();
+    metadata.fStreamPages = true;
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    constexpr int kPageCount = 12;
+    for (int i = 0; i < kPageCount; ++i) {
+        doc->beginPage(612, 792)->drawColor(SkColorSetARGB(0xFF, 0x00, i * 20, 0x00));
+        doc->endPage();
+        // The page object is written when the page ends, not when the document closes.
+        REPORTER_ASSERT(r, stream_contains(stream, "/Parent"));
+        REPORTER_ASSERT(r, !stream_contains(stream, "/Type /Catalog"));
+    }
+    doc->close();
+    REPORTER_ASSERT(r, stream_contains(stream, "/Type /Catalog"));
+    REPORTER_ASSERT(r, stream_contains(stream, "/Count 12"));
+}
+
+static sk_sp<SkData> make_threaded_test_pdf(SkExecutor* executor) {
+    SkBitmap bitmap;
+    bitmap.allocN32Pixels(256, 256);
+    for (int y = 0; y < bitmap.height(); ++y) {
+        for (int x = 0; x < bitmap.width(); ++x) {
+            *bitmap.getAddr32(x, y) = SkPackARGB32(0xFF, x, y, (x * y) & 0xFF);
+        }
+    }
+    sk_sp<SkImage> image = bitmap.asImage();
+
+    SkPDF::Metadata metadata = SkPDF::JPEG::MetadataWithCallbacks();
+    metadata.fExecutor = executor;
+    SkDynamicMemoryWStream stream;
+    auto doc = SkPDF::MakeDocument(&stream, metadata);
+    SkFont font(ToolUtils::DefaultTypeface(), 24);
+    for (int page = 0; page < 8; ++page) {
+        SkCanvas* canvas = doc->beginPage(612, 792);
+        canvas->drawImage(image, 20, 20);
+        SkString text = SkStringPrintf("Page %d: the quick brown fox", page);
+        canvas->drawString(text, 20, 400, font, SkPaint());
+        doc->endPage();
+    }
+    doc->close();
+    return stream.detachAsData();
+}
+
+// The trailer holds a time-based document ID, everything before it should not depend on
+// whether (or how) the work was spread across threads.
+static size_t bytes_before_trailer(const SkData& pdf) {
+    static constexpr char kTrailer[] = "trailer";
+    const char* begin = static_cast<const char*>(pdf.data());
+    const char* end = begin + pdf.size();
+    return std::search(begin, end, kTrailer, kTrailer + strlen(kTrailer)) - begin;
+}
+
+DEF_TEST(SkPDF_executor_deterministic, r) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_executor_deterministic, r);
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    sk_sp<SkData> serial = make_threaded_test_pdf(nullptr);
+    size_t serialSize = bytes_before_trailer(*serial);
+    REPORTER_ASSERT(r, serialSize > 0 && serialSize < serial->size());
+    for (int i = 0; i < 3; ++i) {
+        sk_sp<SkData> threaded = make_threaded_test_pdf(executor.get());
+        size_t threadedSize = bytes_before_trailer(*threaded);
+        REPORTER_ASSERT(r, threadedSize == serialSize);
+        REPORTER_ASSERT(r, 0 == memcmp(serial->data(), threaded->data(),
+                                       std::min(serialSize, threadedSize)));
+    }
+}
+
 #endif // SK_SUPPORT_PDF
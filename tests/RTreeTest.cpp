@@ -8,12 +8,14 @@
 #include "include/core/SkRect.h"
 #include "include/core/SkTypes.h"
 #include "include/private/SkTemplates.h"
+#include "src/core/SkPackedRTree.h"
 #include "src/core/SkRTree.h"
 #include "src/core/SkRandom.h"
 #include "tests/Test.h"
 
 #include <cmath>
 #include <cstddef>
+#include <iterator>
 #include <vector>
 
 using namespace skia_private;
@@ -53,7 +55,7 @@ static bool verify_query(SkRect query, SkRect rects[], const std::vector<int>& f
 }
 
 static void run_queries(skiatest::Reporter* reporter, SkRandom& rand, SkRect rects[],
-                        const SkRTree& tree) {
+                        const SkBBoxHierarchy& tree) {
     for (size_t i = 0; i < NUM_QUERIES; ++i) {
         std::vector<int> hits;
         SkRect query = random_rect(rand);
@@ -97,3 +99,54 @@ DEF_TEST(RTree, reporter) {
                                   expectedDepthMax >= rtree.getDepth());
     }
 }
+
+DEF_TEST(PackedRTree, reporter) {
+    SkRandom rand;
+    AutoTArray<SkRect> rects(NUM_RECTS);
+    for (size_t i = 0; i < NUM_ITERATIONS; ++i) {
+        SkPackedRTree tree;
+        REPORTER_ASSERT(reporter, 0 == tree.getCount());
+
+        for (int j = 0; j < NUM_RECTS; j++) {
+            rects[j] = random_rect(rand);
+        }
+        // Empty rects are never found.
+        rects[i % NUM_RECTS] = SkRect::MakeEmpty();
+
+        tree.insert(rects.data(), NUM_RECTS);
+
+        run_queries(reporter, rand, rects.data(), tree);
+        REPORTER_ASSERT(reporter, NUM_RECTS - 1 == tree.getCount());
+        // Every node but the last on each level is full.
+        int expectedDepth = 1;
+        for (int n = NUM_RECTS - 1; n > SkPackedRTree::kFanout;
+             n = (n + SkPackedRTree::kFanout - 1) / SkPackedRTree::kFanout) {
+            expectedDepth++;
+        }
+        REPORTER_ASSERT(reporter, expectedDepth == tree.getDepth());
+
+        // More queries than fit in one pass of a batch.
+        std::vector<SkRect> queries(100);
+        for (SkRect& query : queries) {
+            query = random_rect(rand);
+        }
+        // Empty and unsorted queries find nothing, even where they lie on rects.
+        const SkRect& center = rects[(i + 1) % NUM_RECTS];
+        const SkRect degenerate[] = {
+            SkRect::MakeXYWH(center.centerX(), center.centerY(), 0, 0),
+            SkRect::MakeLTRB(center.fLeft, center.centerY(), center.fRight, center.centerY()),
+            SkRect::MakeLTRB(center.fRight, center.fTop, center.fLeft, center.fBottom),
+        };
+        for (size_t d = 0; d < std::size(degenerate); ++d) {
+            std::vector<int> found;
+            tree.search(degenerate[d], &found);
+            REPORTER_ASSERT(reporter, found.empty());
+            queries[d * 37] = degenerate[d];
+        }
+        std::vector<std::vector<int>> hits(queries.size());
+        tree.searchBatch(queries, hits.data());
+        for (size_t q = 0; q < queries.size(); ++q) {
+            REPORTER_ASSERT(reporter, verify_query(queries[q], rects.data(), hits[q]));
+        }
+    }
+}
@@ -5,26 +5,32 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkImageFilter.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkSurface.h"
 #include "include/effects/SkImageFilters.h"
+#include "src/core/SkCanvasPriv.h"
+#include "src/core/SkRandom.h"
 #include "src/core/SkRecord.h"
 #include "src/core/SkRecordCanvas.h"
 #include "src/core/SkRecordOpts.h"
 #include "src/core/SkRecords.h"
 #include "tests/RecordTestUtils.h"
 #include "tests/Test.h"
+#include "tools/ToolUtils.h"
 
 #include <array>
 #include <cstddef>
@@ -197,7 +203,7 @@ DEF_TEST(RecordOpts_NoopSaveLayerDrawRestore, r) {
 
     const SkRecords::DrawRect* drawRect = assert_type<SkRecords::DrawRect>(r, record, 16);
     REPORTER_ASSERT(r, drawRect != nullptr);
-    REPORTER_ASSERT(r, drawRect->paint.getColor() == 0x03020202);
+    REPORTER_ASSERT(r, drawRect->paint->getColor() == 0x03020202);
 
     // saveLayer w/ backdrop should NOT go away
     sk_sp<SkImageFilter> filter(SkImageFilters::Blur(3, 3, nullptr));
@@ -426,3 +432,176 @@ DEF_TEST(savelayer_srcmode_alpha, r) {
     do_savelayer_srcmode(r, 0x80FF0000);
 }
 
+
+DEF_TEST(RecordOpts_NoopOccludedDraws, r) {
+    SkRecord record;
+    SkRecordCanvas recorder(&record, W, H);
+
+    SkPaint opaque, translucent;
+    translucent.setAlphaf(0.5f);
+
+    // 0 is only covered by 3, which is in a layer, so it must be kept. 8 does not cover it.
+    recorder.drawRect(SkRect::MakeLTRB(10, 10, 20, 20), translucent);   // 0
+    recorder.saveLayer(nullptr, nullptr);                               // 1
+        recorder.drawRect(SkRect::MakeLTRB(10, 10, 20, 20), opaque);    // 2: covered by 3
+        recorder.drawRect(SkRect::MakeLTRB(0, 0, 100, 100), opaque);    // 3
+    recorder.restore();                                                 // 4
+    recorder.drawOval(SkRect::MakeLTRB(30, 30, 60, 60), opaque);        // 5: covered by 8
+    recorder.drawRect(SkRect::MakeLTRB(90, 90, 120, 120), opaque);      // 6: sticks out of 8
+    recorder.drawRect(SkRect::MakeLTRB(25.5f, 25.5f, 99.5f, 99.5f), translucent);  // 7
+    recorder.drawRect(SkRect::MakeLTRB(25, 25, 100, 100), opaque);      // 8
+
+    SkRecordNoopOccludedDraws(&record, SkRect::MakeWH(W, H));
+
+    assert_type<SkRecords::DrawRect>(r, record, 0);
+    assert_type<SkRecords::SaveLayer>(r, record, 1);
+    assert_type<SkRecords::NoOp>(r, record, 2);
+    assert_type<SkRecords::DrawRect>(r, record, 3);
+    assert_type<SkRecords::NoOp>(r, record, 5);
+    assert_type<SkRecords::DrawRect>(r, record, 6);
+    assert_type<SkRecords::NoOp>(r, record, 7);
+    assert_type<SkRecords::DrawRect>(r, record, 8);
+}
+
+DEF_TEST(RecordOpts_NoopOccludedDraws_Barriers, r) {
+    SkRecord record;
+    SkRecordCanvas recorder(&record, W, H);
+
+    SkPaint opaque, translucent;
+    translucent.setAlphaf(0.5f);
+
+    recorder.drawRect(SkRect::MakeLTRB(10, 10, 20, 20), opaque);         // 0: read by 1
+    recorder.saveLayer({nullptr, nullptr, nullptr, SkCanvas::kInitWithPrevious_SaveLayerFlag});
+    recorder.restore();
+    recorder.save();                                                     // 3
+        recorder.clipRect(SkRect::MakeLTRB(0, 0, 50, 50), true);
+        recorder.drawRect(SkRect::MakeLTRB(20, 20, 30, 30), opaque);     // 5: covered by 6
+        recorder.drawPaint(opaque);                                      // 6
+    recorder.restore();
+    recorder.save();                                                     // 8
+        recorder.rotate(30);
+        recorder.drawRect(SkRect::MakeLTRB(0, 0, 500, 500), opaque);     // 10: not a rect
+    recorder.restore();
+    recorder.drawRect(SkRect::MakeLTRB(0, 0, 100, 100), translucent);   // 12: not opaque
+
+    SkRecordNoopOccludedDraws(&record, SkRect::MakeWH(W, H));
+
+    assert_type<SkRecords::DrawRect>(r, record, 0);
+    assert_type<SkRecords::NoOp>(r, record, 5);
+    assert_type<SkRecords::DrawPaint>(r, record, 6);
+    assert_type<SkRecords::DrawRect>(r, record, 10);
+    assert_type<SkRecords::DrawRect>(r, record, 12);
+}
+
+DEF_TEST(RecordOpts_NoopRedundantClipRects, r) {
+    SkRecord record;
+    SkRecordCanvas recorder(&record, W, H);
+
+    recorder.clipRect(SkRect::MakeLTRB(10, 10, 100, 100));              // 0: nothing to contain
+    recorder.clipRect(SkRect::MakeLTRB(0, 0, 200, 200));                // 1: redundant
+    recorder.save();                                                    // 2
+        recorder.translate(5, 5);
+        recorder.clipRect(SkRect::MakeLTRB(5, 5, 95, 95));              // 4: redundant
+        recorder.clipRect(SkRect::MakeLTRB(10, 10, 50, 50));            // 5
+        recorder.clipRect(SkRect::MakeLTRB(0, 0, 60, 60), true);        // 6: antialiased
+    recorder.restore();
+    recorder.save();                                                    // 8
+        recorder.clipRect(SkRect::MakeLTRB(20, 20, 80, 80), true);      // 9
+        recorder.clipRect(SkRect::MakeLTRB(0, 0, 100, 100));            // 10: after an AA clip
+        recorder.clipRect(SkRect::MakeLTRB(0, 0, 100, 100), SkClipOp::kDifference);
+    recorder.restore();
+    SkCanvasPriv::ResetClip(&recorder);                                 // 13
+    recorder.clipRect(SkRect::MakeLTRB(0, 0, 100, 100));                // 14: after a reset
+
+    SkRecordNoopRedundantClipRects(&record);
+
+    assert_type<SkRecords::ClipRect>(r, record, 0);
+    assert_type<SkRecords::NoOp>(r, record, 1);
+    assert_type<SkRecords::NoOp>(r, record, 4);
+    assert_type<SkRecords::ClipRect>(r, record, 5);
+    assert_type<SkRecords::ClipRect>(r, record, 6);
+    assert_type<SkRecords::ClipRect>(r, record, 9);
+    assert_type<SkRecords::ClipRect>(r, record, 10);
+    assert_type<SkRecords::ClipRect>(r, record, 11);
+    assert_type<SkRecords::ClipRect>(r, record, 14);
+}
+
+DEF_TEST(RecordOpts_MergeDrawRects, r) {
+    SkRecord record;
+    SkRecordCanvas recorder(&record, W, H);
+
+    SkPaint red, blue, aa;
+    red.setColor(SK_ColorRED);
+    blue.setColor(SK_ColorBLUE);
+    aa.setAntiAlias(true);
+
+    recorder.drawRect(SkRect::MakeLTRB(0, 0, 10, 10), red);             // 0: merged with 1, 2
+    recorder.drawRect(SkRect::MakeLTRB(10, 0, 20, 10), red);            // 1
+    recorder.drawRect(SkRect::MakeLTRB(30, 30, 40, 40), red);           // 2
+    recorder.drawRect(SkRect::MakeLTRB(35, 35, 45, 45), red);           // 3: overlaps 2
+    recorder.drawRect(SkRect::MakeLTRB(50, 50, 60, 60), blue);          // 4: another paint
+    recorder.drawRect(SkRect::MakeLTRB(0.5f, 0, 10, 10), blue);         // 5: not pixel aligned
+    recorder.drawRect(SkRect::MakeLTRB(70, 70, 80, 80), aa);            // 6: antialiased
+    recorder.drawRect(SkRect::MakeLTRB(90, 90, 95, 95), aa);            // 7
+
+    SkRecordMergeDrawRects(&record);
+
+    const SkRecords::DrawRegion* merged = assert_type<SkRecords::DrawRegion>(r, record, 0);
+    if (merged) {
+        SkRegion expected;
+        expected.op(SkIRect::MakeLTRB(0, 0, 20, 10), SkRegion::kUnion_Op);
+        expected.op(SkIRect::MakeLTRB(30, 30, 40, 40), SkRegion::kUnion_Op);
+        REPORTER_ASSERT(r, merged->region == expected);
+        REPORTER_ASSERT(r, *merged->paint.get() == red);
+    }
+    assert_type<SkRecords::NoOp>(r, record, 1);
+    assert_type<SkRecords::NoOp>(r, record, 2);
+    for (int i = 3; i < 8; i++) {
+        assert_type<SkRecords::DrawRect>(r, record, i);
+    }
+}
+
+// Pictures recorded with setOptimizeForPlayback() should have fewer ops and draw the same.
+DEF_TEST(RecordOpts_OptimizeForPlayback, r) {
+    auto draw = [](SkCanvas* canvas) {
+        SkRandom rand;
+        SkPaint paint;
+        for (int i = 0; i < 500; i++) {
+            paint.setColor(rand.nextU() | 0xFF000000);
+            paint.setAntiAlias(rand.nextBool());
+            const float x = (float)rand.nextULessThan(200),
+                        y = (float)rand.nextULessThan(200);
+            canvas->save();
+            canvas->clipRect(SkRect::MakeWH(256, 256));
+            if (i == 250) {
+                canvas->drawRect(SkRect::MakeXYWH(0.5f, 0.5f, 240, 240), paint);
+            } else if (rand.nextBool()) {
+                canvas->drawRect(SkRect::MakeXYWH(x, y, rand.nextRangeF(1, 40), 20), paint);
+            } else {
+                canvas->drawOval(SkRect::MakeXYWH(x, y, 30, 30), paint);
+            }
+            canvas->restore();
+        }
+    };
+
+    SkPictureRecorder recorder;
+    draw(recorder.beginRecording(256, 256));
+    sk_sp<SkPicture> plain = recorder.finishRecordingAsPicture();
+    recorder.setOptimizeForPlayback(true);
+    draw(recorder.beginRecording(256, 256));
+    sk_sp<SkPicture> optimized = recorder.finishRecordingAsPicture();
+
+    REPORTER_ASSERT(r, optimized->approximateOpCount() < plain->approximateOpCount());
+
+    SkBitmap expected, actual;
+    expected.allocN32Pixels(256, 256);
+    actual.allocN32Pixels(256, 256);
+    for (SkIPoint offset : {SkIPoint{0, 0}, SkIPoint{-17, 33}}) {
+        SkCanvas(expected).clear(SK_ColorWHITE);
+        SkCanvas(actual).clear(SK_ColorWHITE);
+        const SkMatrix matrix = SkMatrix::Translate(offset.x(), offset.y());
+        SkCanvas(expected).drawPicture(plain, &matrix, nullptr);
+        SkCanvas(actual).drawPicture(optimized, &matrix, nullptr);
+        REPORTER_ASSERT(r, ToolUtils::equal_pixels(expected, actual));
+    }
+}
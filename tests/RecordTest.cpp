@@ -5,9 +5,13 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkColor.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkPoint.h"
 #include "include/core/SkRect.h"
 #include "src/core/SkRecord.h"
+#include "src/core/SkRecordCanvas.h"
 #include "src/core/SkRecords.h"
 #include "tests/RecordTestUtils.h"
 #include "tests/Test.h"
@@ -62,7 +66,7 @@ DEF_TEST(Record, r) {
     // Add a simple DrawRect command.
     SkRect rect = SkRect::MakeWH(10, 10);
     SkPaint paint;
-    APPEND(record, SkRecords::DrawRect, paint, rect);
+    APPEND(record, SkRecords::DrawRect, record.intern(paint), rect);
 
     // Its area should be 100.
     AreaSummer summer;
@@ -117,3 +121,61 @@ DEF_TEST(Record_Alignment, r) {
         REPORTER_ASSERT(r, is_aligned(record.alloc<uint64_t>()));
     }
 }
+
+DEF_TEST(Record_Intern, r) {
+    SkRecord record;
+
+    SkPaint red, blue;
+    red.setColor(SK_ColorRED);
+    blue.setColor(SK_ColorBLUE);
+    const SkPaint* interned = record.intern(red);
+    REPORTER_ASSERT(r, interned != &red && *interned == red);
+    REPORTER_ASSERT(r, record.intern(SkPaint(red)) == interned);
+    REPORTER_ASSERT(r, record.intern(blue) != interned);
+
+    // Paths with the same contents share, even if they were built separately.
+    const SkPath* circle = record.intern(SkPath::Circle(10, 10, 5));
+    REPORTER_ASSERT(r, record.intern(SkPath::Circle(10, 10, 5)) == circle);
+    REPORTER_ASSERT(r, record.intern(SkPath::Circle(10, 10, 6)) != circle);
+    SkPath inverse = SkPath::Circle(10, 10, 5);
+    inverse.toggleInverseFillType();
+    REPORTER_ASSERT(r, record.intern(inverse) != circle);
+
+    // Interning again doesn't use any more memory.
+    const size_t bytes = record.bytesUsed();
+    for (int i = 0; i < 100; i++) {
+        record.intern(red);
+        record.intern(SkPath::Circle(10, 10, 5));
+    }
+    REPORTER_ASSERT(r, record.bytesUsed() == bytes);
+}
+
+DEF_TEST(Record_RecordingInternsPaintsAndPaths, r) {
+    SkRecord record;
+    SkRecordCanvas recorder(&record, 100, 100);
+
+    auto triangle = [](float x) {
+        const SkPoint pts[] = {{x, 0}, {x + 10, 0}, {x, 10}};
+        return SkPath::Polygon(pts, /*isClosed=*/true);
+    };
+
+    SkPaint paint;
+    for (int i = 0; i < 10; i++) {
+        recorder.drawRect(SkRect::MakeXYWH(i, i, 10, 10), paint);
+        recorder.drawPath(triangle(i), paint);
+        recorder.clipPath(triangle(50));
+    }
+
+    const auto* firstRect = assert_type<SkRecords::DrawRect>(r, record, 0);
+    const auto* firstPath = assert_type<SkRecords::DrawPath>(r, record, 1);
+    const auto* firstClip = assert_type<SkRecords::ClipPath>(r, record, 2);
+    for (int i = 3; i < record.count(); i += 3) {
+        const auto* rect = assert_type<SkRecords::DrawRect>(r, record, i);
+        const auto* path = assert_type<SkRecords::DrawPath>(r, record, i + 1);
+        const auto* clip = assert_type<SkRecords::ClipPath>(r, record, i + 2);
+        REPORTER_ASSERT(r, rect->paint.get() == firstRect->paint.get());
+        REPORTER_ASSERT(r, path->paint.get() == firstRect->paint.get());
+        REPORTER_ASSERT(r, path->path.get() != firstPath->path.get());
+        REPORTER_ASSERT(r, clip->path.get() == firstClip->path.get());
+    }
+}
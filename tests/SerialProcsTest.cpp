@@ -125,6 +125,60 @@ DEF_TEST(serial_procs_image, reporter) {
     }
 }
 
+// Encoded images in a picture loaded from an SkData should reference that data, not a copy of it.
+DEF_TEST(serial_procs_image_shares_data, reporter) {
+    auto src_img = ToolUtils::GetResourceAsImage("images/mandrill_128.png");
+    const char magic_str[] = "magic signature";
+
+    sk_sp<SkPicture> pic;
+    {
+        SkPictureRecorder rec;
+        SkCanvas* canvas = rec.beginRecording(128, 128);
+        canvas->drawImage(src_img, 0, 0);
+        canvas->drawCircle(64, 64, 32, SkPaint());
+        pic = rec.finishRecordingAsPicture();
+    }
+
+    struct Shared {
+        State          fState;
+        const uint8_t* fEncoded = nullptr;
+    } shared = {{magic_str, src_img.get()}};
+
+    SkSerialProcs sproc;
+    sproc.fImageProc = [](SkImage*, void* ctx) -> sk_sp<const SkData> {
+        return SkData::MakeWithCString(((Shared*)ctx)->fState.fStr);
+    };
+    sproc.fImageCtx = &shared;
+    sk_sp<SkData> data = pic->serialize(&sproc);
+    REPORTER_ASSERT(reporter, data);
+
+    SkDeserialProcs dproc;
+    dproc.fImageDataProc = [](sk_sp<SkData> data, std::optional<SkAlphaType>,
+                              void* ctx) -> sk_sp<SkImage> {
+        Shared* shared = (Shared*)ctx;
+        shared->fEncoded = data->bytes();
+        return sk_ref_sp(shared->fState.fImg);
+    };
+    dproc.fImageCtx = &shared;
+
+    auto within = [&](const uint8_t* p) {
+        return data->bytes() <= p && p < data->bytes() + data->size();
+    };
+
+    sk_sp<SkPicture> fromData = SkPicture::MakeFromData(data.get(), &dproc);
+    REPORTER_ASSERT(reporter, fromData);
+    REPORTER_ASSERT(reporter, within(shared.fEncoded));
+    REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(picture_to_image(pic).get(),
+                                                      picture_to_image(fromData).get()));
+
+    // Raw memory is only borrowed for the call, so it must be copied.
+    sk_sp<SkPicture> fromMemory = SkPicture::MakeFromData(data->data(), data->size(), &dproc);
+    REPORTER_ASSERT(reporter, fromMemory);
+    REPORTER_ASSERT(reporter, !within(shared.fEncoded));
+    REPORTER_ASSERT(reporter, ToolUtils::equal_pixels(picture_to_image(pic).get(),
+                                                      picture_to_image(fromMemory).get()));
+}
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////
 
 static sk_sp<SkPicture> make_pic(const std::function<void(SkCanvas*)>& drawer) {
@@ -5,6 +5,7 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontStyle.h"
 #include "include/core/SkMatrix.h"
@@ -16,10 +17,13 @@
 #include "src/core/SkStrike.h"  // IWYU pragma: keep
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
+#include "src/core/SkTaskGroup.h"
 #include "tests/Test.h"
 #include "tools/ToolUtils.h"
 #include "tools/fonts/FontToolUtils.h"
 
+#include <memory>
+
 DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
     SkStrikeCache cache;
 
@@ -61,3 +65,55 @@ DEF_TEST(SkStrikeCache_CachePurge, Reporter) {
 
 
 }
+
+DEF_TEST(SkStrikeCache_ConcurrentFindOrCreate, Reporter) {
+    SkStrikeCache cache;
+
+    SkFont font;
+    font.setEdging(SkFont::Edging::kAntiAlias);
+    font.setTypeface(ToolUtils::CreatePortableTypeface("serif", SkFontStyle()));
+
+    constexpr int kSizeCount = 24;
+    constexpr int kThreadCount = 8;
+    SkPaint defaultPaint;
+    std::unique_ptr<SkStrikeSpec> specs[kSizeCount];
+    for (int i = 0; i < kSizeCount; ++i) {
+        font.setSize(8 + i);
+        specs[i] = std::make_unique<SkStrikeSpec>(SkStrikeSpec::MakeMask(
+                font, defaultPaint, SkSurfaceProps(0, kUnknown_SkPixelGeometry),
+                SkScalerContextFlags::kNone, SkMatrix::I()));
+    }
+
+    // Every thread asks for every strike; each descriptor must end up with a single strike.
+    sk_sp<SkStrike> found[kThreadCount][kSizeCount];
+    auto executor = SkExecutor::MakeFIFOThreadPool(kThreadCount);
+    SkTaskGroup tg(*executor);
+    tg.batch(kThreadCount, [&](int thread) {
+        for (int i = 0; i < kSizeCount; ++i) {
+            int index = (i + thread * 5) % kSizeCount;
+            found[thread][index] = specs[index]->findOrCreateStrike(&cache);
+        }
+    });
+    tg.wait();
+
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == kSizeCount);
+    for (int i = 0; i < kSizeCount; ++i) {
+        for (int thread = 1; thread < kThreadCount; ++thread) {
+            REPORTER_ASSERT(Reporter, found[thread][i] == found[0][i]);
+        }
+        REPORTER_ASSERT(Reporter, cache.findStrike(specs[i]->descriptor()) == found[0][i]);
+    }
+
+    // Shrinking the count budget purges strikes, and the ones left can still be found.
+    cache.setCacheCountLimit(kSizeCount / 2);
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() <= kSizeCount / 2);
+    int stillCached = 0;
+    for (int i = 0; i < kSizeCount; ++i) {
+        stillCached += cache.findStrike(specs[i]->descriptor()) != nullptr ? 1 : 0;
+    }
+    REPORTER_ASSERT(Reporter, stillCached == cache.getCacheCountUsed());
+
+    cache.purgeAll();
+    REPORTER_ASSERT(Reporter, cache.getCacheCountUsed() == 0);
+    REPORTER_ASSERT(Reporter, cache.getTotalMemoryUsed() == 0);
+}
@@ -29,6 +29,7 @@
 #include "src/core/SkMask.h"
 #include "src/core/SkReadBuffer.h"
 #include "src/core/SkScalerContext.h"
+#include "src/core/SkSharedMutex.h"
 #include "src/core/SkStrike.h"
 #include "src/core/SkStrikeCache.h"
 #include "src/core/SkStrikeSpec.h"
@@ -190,7 +191,7 @@ public:
 class SkStrikeTestingPeer {
 public:
     static SkGlyph* GetGlyph(SkStrike* strike, SkPackedGlyphID packedID) {
-        SkAutoMutexExclusive m{strike->fStrikeLock};
+        SkAutoSharedMutexExclusive m{strike->fStrikeLock};
         return strike->glyph(packedID);
     }
 };
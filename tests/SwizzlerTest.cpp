@@ -11,6 +11,7 @@
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkSwizzle.h"
 #include "src/codec/SkSampler.h"
+#include "src/core/SkCpu.h"
 #include "src/core/SkSwizzlePriv.h"
 #include "tests/Test.h"
 
@@ -246,4 +247,77 @@ DEF_TEST(UnpremulSimulatingRP, reporter) {
     }
 }
 
+DEF_TEST(Swizzle16Opts, r) {
+    using Strip16 = void (*)(uint32_t[], const uint8_t*, int);
+    struct {
+        Strip16 fn, portable;
+        int     srcBPP;
+    } procs[] = {
+        {SkOpts::RGB16_to_RGB1,  SK_OPTS_NS::RGB16_to_RGB1_portable,  6},
+        {SkOpts::RGB16_to_BGR1,  SK_OPTS_NS::RGB16_to_BGR1_portable,  6},
+        {SkOpts::RGBA16_to_RGBA, SK_OPTS_NS::RGBA16_to_RGBA_portable, 8},
+        {SkOpts::RGBA16_to_BGRA, SK_OPTS_NS::RGBA16_to_BGRA_portable, 8},
+    };
+
+    // Odd counts and an unaligned source exercise the SIMD tails.
+    constexpr int kMaxCount = 37;
+    uint8_t src[kMaxCount * 8 + 1];
+    for (size_t i = 0; i < sizeof(src); i++) {
+        src[i] = (uint8_t)(i * 29 + 7);
+    }
+
+    for (const auto& p : procs) {
+        for (int count = 0; count <= kMaxCount; count++) {
+            uint32_t expected[kMaxCount], actual[kMaxCount];
+            p.portable(expected, src + 1, count);
+            p.fn(actual, src + 1, count);
+            REPORTER_ASSERT(r, 0 == memcmp(expected, actual, count * sizeof(uint32_t)));
+        }
+    }
+
+    // The high byte of each big-endian component is kept.
+    const uint8_t rgba16[] = {0xFA, 0x01, 0xCE, 0x02, 0xB0, 0x03, 0x04, 0x05};
+    uint32_t dst;
+    SkOpts::RGBA16_to_RGBA(&dst, rgba16, 1);
+    REPORTER_ASSERT(r, dst == 0x04B0CEFA);
+    SkOpts::RGBA16_to_BGRA(&dst, rgba16, 1);
+    REPORTER_ASSERT(r, dst == 0x04FACEB0);
+    SkOpts::RGB16_to_RGB1(&dst, rgba16, 1);
+    REPORTER_ASSERT(r, dst == 0xFFB0CEFA);
+}
+
+DEF_TEST(SwizzleOpts_ML4, r) {
+#if defined(SK_CPU_X86) && !defined(SK_ENABLE_OPTIMIZE_SIZE)
+    // Only CPUs with AVX-512 use the 512-bit swizzles.
+    if (!SkCpu::Supports(SkX64::ML4)) {
+        return;
+    }
+    struct {
+        SkOpts::Swizzle_8888_u32 fn, portable;
+    } procs[] = {
+        {SkOpts::RGBA_to_BGRA, SK_OPTS_NS::RGBA_to_BGRA_portable},
+        {SkOpts::RGBA_to_rgbA, SK_OPTS_NS::RGBA_to_rgbA_portable},
+        {SkOpts::RGBA_to_bgrA, SK_OPTS_NS::RGBA_to_bgrA_portable},
+    };
+
+    // Enough for several 32 pixel iterations, with every tail length the 16, 8 and 4 pixel
+    // loops leave behind. Starting a pixel into each array keeps the loads off vector alignment.
+    constexpr int kMaxCount = 3 * 32 + 31;
+    uint32_t src[kMaxCount + 1];
+    for (int i = 0; i <= kMaxCount; i++) {
+        src[i] = (uint32_t)i * 0x9E3779B9u;
+    }
+
+    for (const auto& p : procs) {
+        for (int count = 0; count <= kMaxCount; count++) {
+            uint32_t expected[kMaxCount + 1], actual[kMaxCount + 1];
+            p.portable(expected + 1, src + 1, count);
+            p.fn(actual + 1, src + 1, count);
+            REPORTER_ASSERT(r, 0 == memcmp(expected + 1, actual + 1, count * sizeof(uint32_t)),
+                            "count %d", count);
+        }
+    }
+#endif
+}
+
 #include "src/opts/SkOpts_RestoreTarget.h"
@@ -0,0 +1,202 @@
+/*
+ * Copyright 2026 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBBHFactory.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageFilter.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkPathBuilder.h"
+#include "include/core/SkPicture.h"
+#include "include/core/SkPictureRecorder.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkTiledRaster.h"
+#include "include/effects/SkImageFilters.h"
+#include "tests/Test.h"
+#include "tools/ToolUtils.h"
+
+#include <memory>
+#include <vector>
+
+static sk_sp<SkPicture> make_picture(int w, int h, SkBBHFactory* bbhFactory = nullptr) {
+    SkPictureRecorder recorder;
+    SkCanvas* canvas = recorder.beginRecording(SkRect::MakeIWH(w, h), bbhFactory);
+
+    canvas->drawColor(SK_ColorWHITE);
+
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    for (int i = 0; i < 40; i++) {
+        paint.setColor(SkColorSetARGB(0x80 + 3 * i, 6 * i, 255 - 5 * i, 255 - 6 * i));
+        canvas->save();
+        canvas->translate(w * 0.5f, h * 0.5f);
+        canvas->rotate(9.0f * i);
+        canvas->drawRect(SkRect::MakeXYWH(-3.0f * i, -2.5f, 6.0f * i, 5.0f), paint);
+        canvas->restore();
+    }
+
+    // Most of these fit inside one tile and are drawn tile by tile; the rest cross tile edges.
+    paint.setColor(SkColorSetARGB(0xC0, 0x20, 0x90, 0x40));
+    for (int y = 6; y < h; y += 13) {
+        for (int x = 5; x < w; x += 17) {
+            canvas->drawCircle(x + 0.3f, y + 0.6f, 3.5f, paint);
+        }
+    }
+
+    paint.setStyle(SkPaint::kStroke_Style);
+    paint.setStrokeWidth(3.5f);
+    paint.setColor(SK_ColorBLUE);
+    SkPathBuilder builder;
+    builder.moveTo(3, 5);
+    for (int i = 1; i < 20; i++) {
+        builder.quadTo(w * (i - 0.5f) / 20, (i & 1) ? h : 0, w * i / 20.0f, h * 0.5f);
+    }
+    canvas->drawPath(builder.detach(), paint);
+
+    canvas->save();
+    canvas->clipRect(SkRect::MakeLTRB(w * 0.25f, h * 0.25f, w * 0.75f, h * 0.75f), true);
+    SkPaint layerPaint;
+    layerPaint.setImageFilter(SkImageFilters::Blur(4, 4, nullptr));
+    canvas->saveLayer(nullptr, &layerPaint);
+    paint.setStyle(SkPaint::kFill_Style);
+    paint.setColor(SK_ColorRED);
+    canvas->drawOval(SkRect::MakeLTRB(w * 0.3f, h * 0.3f, w * 0.7f, h * 0.6f), paint);
+    canvas->restore();
+    canvas->restore();
+
+    // Layers that read the pixels below them and filtered draws can't be split into tiles, but
+    // must still see the matrix and clip set before them, and the draws after them are tiled.
+    canvas->translate(3, 2);
+    canvas->clipRect(SkRect::MakeLTRB(5, 5, w - 5.0f, h - 5.0f), true);
+    canvas->saveLayer(SkCanvas::SaveLayerRec(nullptr, nullptr,
+                                             SkCanvas::kInitWithPrevious_SaveLayerFlag));
+    paint.setColor(SkColorSetARGB(0x80, 0, 0xFF, 0));
+    canvas->drawRect(SkRect::MakeLTRB(w * 0.1f, h * 0.6f, w * 0.9f, h * 0.8f), paint);
+    canvas->restore();
+
+    const SkRect backdropBounds = SkRect::MakeLTRB(w * 0.2f, h * 0.1f, w * 0.6f, h * 0.9f);
+    sk_sp<SkImageFilter> backdrop = SkImageFilters::Blur(3, 3, nullptr);
+    canvas->saveLayer(SkCanvas::SaveLayerRec(&backdropBounds, nullptr, backdrop.get(), 0));
+    canvas->restore();
+
+    SkPaint shadowPaint;
+    shadowPaint.setImageFilter(SkImageFilters::DropShadow(6, 6, 3, 3, SK_ColorBLACK, nullptr));
+    canvas->drawCircle(w * 0.75f, h * 0.25f, 25, shadowPaint);
+
+    paint.setColor(SK_ColorMAGENTA);
+    canvas->drawRect(SkRect::MakeLTRB(w * 0.05f, h * 0.85f, w * 0.95f, h * 0.9f), paint);
+
+    return recorder.finishRecordingAsPicture();
+}
+
+DEF_TEST(TiledRaster_MatchesSerialDraw, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(301, 257);
+    sk_sp<SkPicture> picture = make_picture(info.width(), info.height());
+
+    sk_sp<SkSurface> expected = SkSurfaces::Raster(info);
+    expected->getCanvas()->drawPicture(picture);
+    SkPixmap expectedPixels;
+    REPORTER_ASSERT(r, expected->peekPixels(&expectedPixels));
+
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+    for (SkExecutor* exec : {static_cast<SkExecutor*>(nullptr), executor.get()}) {
+        for (SkISize tileSize : {SkISize{37, 53}, SkISize{64, 64}, SkISize{1000, 1000}}) {
+            sk_sp<SkSurface> actual = SkSurfaces::Raster(info);
+            SkTiledRaster::Options options;
+            options.fTileSize = tileSize;
+            options.fExecutor = exec;
+            REPORTER_ASSERT(r, SkTiledRaster::DrawPicture(actual.get(), picture.get(), options));
+
+            SkPixmap actualPixels;
+            REPORTER_ASSERT(r, actual->peekPixels(&actualPixels));
+            REPORTER_ASSERT(r, ToolUtils::equal_pixels(expectedPixels, actualPixels),
+                            "tile %dx%d, %s", tileSize.width(), tileSize.height(),
+                            exec ? "threaded" : "serial");
+        }
+    }
+}
+
+DEF_TEST(TiledRaster_TilesMatchSerialDraw, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(301, 257);
+    SkRTreeFactory rtreeFactory;
+    SkPackedRTreeFactory packedRTreeFactory;
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(4);
+
+    for (SkBBHFactory* factory : {static_cast<SkBBHFactory*>(nullptr),
+                                  static_cast<SkBBHFactory*>(&rtreeFactory),
+                                  static_cast<SkBBHFactory*>(&packedRTreeFactory)}) {
+        sk_sp<SkPicture> picture = make_picture(info.width(), info.height(), factory);
+
+        sk_sp<SkSurface> expected = SkSurfaces::Raster(info);
+        expected->getCanvas()->drawPicture(picture);
+        SkPixmap expectedPixels;
+        REPORTER_ASSERT(r, expected->peekPixels(&expectedPixels));
+
+        for (SkExecutor* exec : {static_cast<SkExecutor*>(nullptr), executor.get()}) {
+            for (SkISize tileSize : {SkISize{37, 53}, SkISize{64, 64}, SkISize{1000, 1000}}) {
+                SkTiledRaster::Options options;
+                options.fTileSize = tileSize;
+                options.fExecutor = exec;
+                std::vector<sk_sp<SkImage>> tiles =
+                        SkTiledRaster::DrawPictureTiles(picture.get(), info, options);
+
+                const int tilesX = (info.width()  + tileSize.width()  - 1) / tileSize.width(),
+                          tilesY = (info.height() + tileSize.height() - 1) / tileSize.height();
+                REPORTER_ASSERT(r, tiles.size() == (size_t)(tilesX * tilesY));
+                for (size_t i = 0; i < tiles.size(); i++) {
+                    SkIRect tile = SkIRect::MakeXYWH((i % tilesX) * tileSize.width(),
+                                                     (i / tilesX) * tileSize.height(),
+                                                     tileSize.width(),
+                                                     tileSize.height());
+                    SkAssertResult(tile.intersect(info.bounds()));
+                    SkPixmap expectedTile, actualTile;
+                    REPORTER_ASSERT(r, expectedPixels.extractSubset(&expectedTile, tile));
+                    REPORTER_ASSERT(r, tiles[i]->peekPixels(&actualTile));
+                    REPORTER_ASSERT(r, ToolUtils::equal_pixels(expectedTile, actualTile),
+                                    "tile %zu of %dx%d, %s, %s", i,
+                                    tileSize.width(), tileSize.height(),
+                                    factory ? "bbh" : "no bbh",
+                                    exec ? "threaded" : "serial");
+                }
+            }
+        }
+    }
+}
+
+DEF_TEST(TiledRaster_CopyOnWrite, r) {
+    const SkImageInfo info = SkImageInfo::MakeN32Premul(64, 64);
+    sk_sp<SkSurface> surface = SkSurfaces::Raster(info);
+    surface->getCanvas()->clear(SK_ColorGREEN);
+    sk_sp<SkImage> snapshot = surface->makeImageSnapshot();
+
+    SkPictureRecorder recorder;
+    recorder.beginRecording(SkRect::MakeIWH(64, 64))->clear(SK_ColorRED);
+    REPORTER_ASSERT(r, SkTiledRaster::DrawPicture(surface.get(),
+                                                  recorder.finishRecordingAsPicture().get(),
+                                                  {{16, 16}, nullptr}));
+
+    // The snapshot taken before the tiled draw must not observe it.
+    SkPixmap pm;
+    REPORTER_ASSERT(r, snapshot->peekPixels(&pm));
+    REPORTER_ASSERT(r, pm.getColor(10, 10) == SK_ColorGREEN);
+    REPORTER_ASSERT(r, surface->makeImageSnapshot()->peekPixels(&pm));
+    REPORTER_ASSERT(r, pm.getColor(10, 10) == SK_ColorRED);
+}
+
+DEF_TEST(TiledRaster_RejectsNonRasterSurface, r) {
+    sk_sp<SkSurface> surface = SkSurfaces::Null(16, 16);
+    SkPictureRecorder recorder;
+    recorder.beginRecording(SkRect::MakeWH(16, 16));
+    REPORTER_ASSERT(r, !SkTiledRaster::DrawPicture(surface.get(),
+                                                   recorder.finishRecordingAsPicture().get()));
+}
@@ -6,6 +6,7 @@
  */
 
 #include "include/core/SkData.h"
+#include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkFontArguments.h"
 #include "include/core/SkFontMetrics.h"
@@ -25,6 +26,7 @@
 #include "src/core/SkEndian.h"
 #include "src/core/SkFontDescriptor.h"
 #include "src/core/SkFontPriv.h"
+#include "src/core/SkTaskGroup.h"
 #include "src/core/SkTypefaceCache.h"
 #include "src/core/SkUTF.h"
 #include "src/sfnt/SkOTTable_OS_2.h"
@@ -43,7 +45,9 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
 namespace {
 [[maybe_unused]] static inline const constexpr bool kVerboseTypefaceTest = false;
@@ -796,3 +800,64 @@ DEF_TEST(CustomTypeface_invalid_glyphid, reporter) {
     REPORTER_ASSERT(reporter, bounds[0] == SkRect::MakeLTRB(10, 20, 30, 40));
     REPORTER_ASSERT(reporter, bounds[1] == SkRect::MakeLTRB(0, 0, 0, 0));
 }
+
+// Scalers for different sizes and different typefaces may run on several threads at once.
+// Their glyphs must match the ones generated on a single thread.
+DEF_TEST(Typeface_concurrent_glyphs, reporter) {
+    const char* kFonts[] = {"fonts/Em.ttf", "fonts/Roboto-Regular.ttf", "fonts/Distortable.ttf"};
+    constexpr int kSizeCount = 6;
+    constexpr SkGlyphID kGlyphCount = 16;
+
+    auto makeTypefaces = [&](std::vector<sk_sp<SkTypeface>>* typefaces) {
+        for (const char* name : kFonts) {
+            sk_sp<SkTypeface> typeface =
+                    ToolUtils::TestFontMgr()->makeFromStream(GetResourceAsStream(name));
+            if (typeface) {
+                typefaces->push_back(std::move(typeface));
+            }
+        }
+    };
+    // Separate typefaces, so the threaded run can not find the serial run's glyphs in the cache.
+    std::vector<sk_sp<SkTypeface>> serialTypefaces, threadedTypefaces;
+    makeTypefaces(&serialTypefaces);
+    makeTypefaces(&threadedTypefaces);
+    if (serialTypefaces.empty() || serialTypefaces.size() != threadedTypefaces.size()) {
+        return;
+    }
+
+    const int jobCount = SkToInt(serialTypefaces.size()) * kSizeCount;
+    auto generate = [&](const std::vector<sk_sp<SkTypeface>>& typefaces, int job,
+                        std::optional<SkPath>* paths, SkScalar* widths) {
+        SkFont font(typefaces[job / kSizeCount], 9 + 7 * (job % kSizeCount));
+        for (SkGlyphID glyph = 0; glyph < kGlyphCount; ++glyph) {
+            paths[glyph] = font.getPath(glyph);
+        }
+        SkGlyphID glyphs[kGlyphCount];
+        for (SkGlyphID glyph = 0; glyph < kGlyphCount; ++glyph) {
+            glyphs[glyph] = glyph;
+        }
+        font.getWidths(glyphs, {widths, kGlyphCount});
+    };
+
+    std::vector<std::optional<SkPath>> serialPaths(jobCount * kGlyphCount),
+                                       threadedPaths(jobCount * kGlyphCount);
+    std::vector<SkScalar> serialWidths(jobCount * kGlyphCount),
+                          threadedWidths(jobCount * kGlyphCount);
+    for (int job = 0; job < jobCount; ++job) {
+        generate(serialTypefaces, job,
+                 &serialPaths[job * kGlyphCount], &serialWidths[job * kGlyphCount]);
+    }
+
+    auto executor = SkExecutor::MakeFIFOThreadPool(4);
+    SkTaskGroup tg(*executor);
+    tg.batch(jobCount, [&](int job) {
+        generate(threadedTypefaces, job,
+                 &threadedPaths[job * kGlyphCount], &threadedWidths[job * kGlyphCount]);
+    });
+    tg.wait();
+
+    for (int i = 0; i < jobCount * kGlyphCount; ++i) {
+        REPORTER_ASSERT(reporter, serialPaths[i] == threadedPaths[i], "glyph %d", i);
+        REPORTER_ASSERT(reporter, serialWidths[i] == threadedWidths[i], "glyph %d", i);
+    }
+}
@@ -141,6 +141,68 @@ DEF_TEST(Jpeg_YUV_Codec, r) {
     codec_yuv(r, "images/arrow.png", nullptr);
 }
 
+#if defined(SK_CODEC_DECODES_WEBP)
+DEF_TEST(Webp_YUV_Codec, r) {
+    auto setExpectations = [](SkISize dims, SkYUVAInfo::PlaneConfig planeConfig) {
+        return SkYUVAInfo(dims,
+                          planeConfig,
+                          SkYUVAInfo::Subsampling::k420,
+                          kRec601_Limited_SkYUVColorSpace,
+                          kTopLeft_SkEncodedOrigin,
+                          SkYUVAInfo::Siting::kCentered,
+                          SkYUVAInfo::Siting::kCentered);
+    };
+
+    // Lossy
+    SkYUVAInfo expectations = setExpectations({800, 800}, SkYUVAInfo::PlaneConfig::kY_U_V);
+    codec_yuv(r, "images/webp-color-profile-lossy.webp", &expectations);
+
+    // Lossy with alpha, including odd dimensions
+    expectations = setExpectations({386, 395}, SkYUVAInfo::PlaneConfig::kY_U_V_A);
+    codec_yuv(r, "images/baby_tux.webp", &expectations);
+    expectations = setExpectations({400, 301}, SkYUVAInfo::PlaneConfig::kY_U_V_A);
+    codec_yuv(r, "images/yellow_rose.webp", &expectations);
+
+    // Lossless images are stored as RGB and should fail.
+    codec_yuv(r, "images/color_wheel.webp", nullptr);
+    // Animated images should fail.
+    codec_yuv(r, "images/blendBG.webp", nullptr);
+}
+#endif
+
+#if defined(SK_CODEC_DECODES_AVIF)
+DEF_TEST(Avif_YUV_Codec, r) {
+    auto setExpectations = [](SkISize dims,
+                              SkYUVAInfo::PlaneConfig planeConfig,
+                              SkYUVAInfo::Subsampling subsampling) {
+        return SkYUVAInfo(dims,
+                          planeConfig,
+                          subsampling,
+                          kJPEG_Full_SkYUVColorSpace,
+                          kTopLeft_SkEncodedOrigin,
+                          SkYUVAInfo::Siting::kCentered,
+                          SkYUVAInfo::Siting::kCentered);
+    };
+
+    SkYUVAInfo expectations = setExpectations(
+            {489, 537}, SkYUVAInfo::PlaneConfig::kY_U_V, SkYUVAInfo::Subsampling::k420);
+    codec_yuv(r, "images/ducky.avif", &expectations);
+
+    expectations = setExpectations(
+            {180, 180}, SkYUVAInfo::PlaneConfig::kY_U_V, SkYUVAInfo::Subsampling::k444);
+    codec_yuv(r, "images/dog.avif", &expectations);
+
+    expectations = setExpectations(
+            {240, 246}, SkYUVAInfo::PlaneConfig::kY_U_V_A, SkYUVAInfo::Subsampling::k444);
+    codec_yuv(r, "images/baby_tux.avif", &expectations);
+
+    // High bit depth, monochrome and animated images should fail.
+    codec_yuv(r, "images/example_3_10bit.avif", nullptr);
+    codec_yuv(r, "images/monochrome.avif", nullptr);
+    codec_yuv(r, "images/alphabetAnim.avif", nullptr);
+}
+#endif
+
 SkYUVAPixmaps decode_yuva(skiatest::Reporter* r, std::unique_ptr<SkStream> stream) {
     static constexpr auto kAllTypes = SkYUVAPixmapInfo::SupportedDataTypes::All();
     SkYUVAPixmaps result;